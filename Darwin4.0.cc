@@ -1,20 +1,23 @@
 #include <string>
 #include <sstream>
 #include <unistd.h>
+#include <getopt.h>
+#include <sys/resource.h>
 
 #include <G4RunManager.hh>
+#include <G4Run.hh>
 #include <G4UImanager.hh>
 #include <G4UIterminal.hh>
 #include <G4UItcsh.hh>
 #include <G4VisExecutive.hh>
+#include <G4Timer.hh>
 
 #include "DARWINDetectorConstruction.hh"
-//#include "DARWINPhysicsList.hh"
-#include "QGSP_BERT_HP.hh"
+#include "DARWINPhysicsList.hh"
 #include "DARWINPrimaryGeneratorAction.hh"
 #include "DARWINAnalysisManager.hh"
 #include "DARWINStackingAction.hh"
-//#include "DARWINSteppingAction.hh"
+#include "DARWINSteppingAction.hh"
 #include "DARWINRunAction.hh"
 #include "DARWINEventAction.hh"
 
@@ -36,11 +39,22 @@ main(int argc, char **argv)
 	bool bOpenGlVisualize = false;
 
 	bool bMacroFile = false;
-	std::string hMacroFilename, hDataFilename;
+	bool bPreInitMacroFile = false;
+	std::string hMacroFilename, hPreInitMacroFilename, hDataFilename;
+	std::string hPhysicsList;
 	int iNbEventsToSimulate = 0;
+	bool bFixedSeed = false;
+	long lSeed = 0;
+	std::string hCheckpointFilename;
+
+	static struct option pLongOptions[] =
+	{
+		{"resume", required_argument, 0, 'r'},
+		{0, 0, 0, 0}
+	};
 
 	// parse switches
-	while((c = getopt(argc,argv,"v:f:o:n:i")) != -1)
+	while((c = getopt_long(argc,argv,"v:f:c:o:n:p:s:i",pLongOptions,0)) != -1)
 	{
 		switch(c)
 		{
@@ -59,6 +73,11 @@ main(int argc, char **argv)
 				hMacroFilename = optarg;
 				break;
 
+			case 'c':
+				bPreInitMacroFile = true;
+				hPreInitMacroFilename = optarg;
+				break;
+
 			case 'o':
 				hDataFilename = optarg;
 				break;
@@ -69,10 +88,25 @@ main(int argc, char **argv)
 				hStream >> iNbEventsToSimulate;
 				break;
 
+			case 'p':
+				hPhysicsList = optarg;
+				break;
+
+			case 's':
+				bFixedSeed = true;
+				hStream.str(optarg);
+				hStream.clear();
+				hStream >> lSeed;
+				break;
+
 			case 'i':
 				bInteractive = true;
 				break;
 
+			case 'r':
+				hCheckpointFilename = optarg;
+				break;
+
 			default:
 				usage();
 		}
@@ -84,9 +118,21 @@ main(int argc, char **argv)
 	// set user-defined initialization classes
 	pRunManager->SetUserInitialization(new DARWINDetectorConstruction);
 
-	// Physics List File
-	pRunManager->SetUserInitialization(new QGSP_BERT_HP );
-	//pRunManager->SetUserInitialization(new DARWINPhysicsList);
+	G4Timer hInitTimer;
+	hInitTimer.Start();
+
+	// physics list, the constructors are only created when the list is handed
+	// to the run manager so the preinit macro can still configure it
+	DARWINPhysicsList *pPhysicsList = new DARWINPhysicsList;
+	if(!hPhysicsList.empty() && !pPhysicsList->SetList(hPhysicsList))
+		usage();
+
+	G4UImanager* pUImanager = G4UImanager::GetUIpointer();
+
+	if(bPreInitMacroFile)
+		pUImanager->ApplyCommand("/control/execute " + hPreInitMacroFilename);
+
+	pRunManager->SetUserInitialization(pPhysicsList);
 	
 	G4VisManager* pVisManager = new G4VisExecutive;
 	pVisManager->Initialize();
@@ -102,16 +148,35 @@ main(int argc, char **argv)
 	if(iNbEventsToSimulate)
 		pAnalysisManager->SetNbEventsToSimulate(iNbEventsToSimulate);
 
+	// a resumed run simulates the events left after its checkpoint into a new chunk
+	if(!hCheckpointFilename.empty())
+	{
+		if(!pAnalysisManager->Resume(hCheckpointFilename))
+			return 1;
+		iNbEventsToSimulate = pAnalysisManager->GetNbEventsToSimulate();
+	}
+
 	// set user-defined action classes
 	pRunManager->SetUserAction(pPrimaryGeneratorAction);
-	pRunManager->SetUserAction(new DARWINStackingAction(pAnalysisManager));
-	//pRunManager->SetUserAction(new DARWINSteppingAction(pAnalysisManager));
-	pRunManager->SetUserAction(new DARWINRunAction(pAnalysisManager));
-	pRunManager->SetUserAction(new DARWINEventAction(pAnalysisManager));
+	DARWINStackingAction *pStackingAction = new DARWINStackingAction(pAnalysisManager);
+	pPrimaryGeneratorAction->SetStackingAction(pStackingAction);
+	pRunManager->SetUserAction(pStackingAction);
+	pRunManager->SetUserAction(new DARWINSteppingAction(pAnalysisManager));
+	DARWINRunAction *pRunAction = new DARWINRunAction(pAnalysisManager);
+	if(bFixedSeed)
+		pRunAction->SetRandomSeed(lSeed);
+	pRunManager->SetUserAction(pRunAction);
+	pRunManager->SetUserAction(new DARWINEventAction(pAnalysisManager, pRunAction->GetProgressReporter()));
 
 	pRunManager->Initialize();
 
-	G4UImanager* pUImanager = G4UImanager::GetUIpointer();
+	hInitTimer.Stop();
+
+	struct rusage hUsage;
+	getrusage(RUSAGE_SELF, &hUsage);
+
+	G4cout << "----> Initialization (" << pPhysicsList->GetList() << "): "
+		<< hInitTimer.GetRealElapsed() << " s, max RSS " << hUsage.ru_maxrss/1024. << " MB" << G4endl;
 
 	G4UIsession * pUIsession = 0;
 	if(bInteractive)
@@ -147,15 +212,33 @@ main(int argc, char **argv)
 		hStream.str("");
 		hStream.clear();
 		hStream << "/run/beamOn " << iNbEventsToSimulate;
+
+		G4Timer hRunTimer;
+		hRunTimer.Start();
+
 		pUImanager->ApplyCommand(hStream.str());
+
+		hRunTimer.Stop();
+		getrusage(RUSAGE_SELF, &hUsage);
+
+		// fewer events than requested if a signal aborted the run
+		const G4Run *pRun = pRunManager->GetCurrentRun();
+		G4int iNbEventsSimulated = (pRun)?(pRun->GetNumberOfEvent()):(0);
+
+		G4cout << "----> Run: " << iNbEventsSimulated << " events in " << hRunTimer.GetRealElapsed() << " s ("
+			<< iNbEventsSimulated/hRunTimer.GetRealElapsed() << " events/s), max RSS " << hUsage.ru_maxrss/1024. << " MB" << G4endl;
 	}
 
+	// a job stopped by a signal ends once its run is written
+	int iSignal = DARWINRunAction::GetPendingSignal();
+	if(iSignal)
+		bInteractive = false;
+
 	if(bInteractive)
-	{
 		pUIsession->SessionStart();
 
-		delete pUIsession;
-	}
+	// also the session of an interactive job stopped by a signal
+	delete pUIsession;
 
 
 	delete pAnalysisManager;
@@ -163,12 +246,14 @@ main(int argc, char **argv)
 	if(bVisualize)
 		delete pVisManager;
 	delete pRunManager;
-	return 0;
+	return (iSignal)?(128+iSignal):(0);
 }
 
 void
 usage()
 {
+	std::cout << "usage: Darwin4.0 [-f macro] [-c preinit_macro] [-p physics_list] [-o output] [-n events] [-s seed] [-v vrml|opengl] [-i] [--resume checkpoint]" << std::endl;
+	std::cout << "  physics lists: " << DARWINPhysicsList::GetAvailableLists() << std::endl;
 	exit(0);
 }
 
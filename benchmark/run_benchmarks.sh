@@ -0,0 +1,134 @@
+#!/bin/bash
+#
+# Runs the reference workloads of workloads.txt with fixed seeds, writes the
+# throughput numbers to a results file and compares them with baseline.txt.
+#
+# usage: benchmark/run_benchmarks.sh [-x executable] [-r results] [-w workload] [-u]
+#   -x  simulation executable (default: Darwin4.0 in $G4WORKDIR/bin/$G4SYSTEM or PATH)
+#   -r  results file (default: benchmark/results.txt)
+#   -w  only run the named workload (can be repeated)
+#   -u  record the results as the baseline of their workloads instead of comparing
+#
+# exit status is 1 when a workload fails, has no baseline (record it with -u) or
+# regresses beyond tolerances.txt
+
+BENCHDIR=$(cd $(dirname $0) && pwd)
+TOPDIR=$(dirname $BENCHDIR)
+
+EXECUTABLE=""
+RESULTS=$BENCHDIR/results.txt
+BASELINE=$BENCHDIR/baseline.txt
+TOLERANCES=$BENCHDIR/tolerances.txt
+UPDATE=0
+SELECTED=""
+
+while getopts "x:r:w:u" OPT; do
+	case $OPT in
+		x) EXECUTABLE=$OPTARG ;;
+		r) RESULTS=$OPTARG ;;
+		w) SELECTED="$SELECTED $OPTARG" ;;
+		u) UPDATE=1 ;;
+		*) sed -n '2,14p' $0; exit 1 ;;
+	esac
+done
+
+if [ -z "$EXECUTABLE" ]; then
+	if [ -n "$G4WORKDIR" ] && [ -x "$G4WORKDIR/bin/$G4SYSTEM/Darwin4.0" ]; then
+		EXECUTABLE=$G4WORKDIR/bin/$G4SYSTEM/Darwin4.0
+	else
+		EXECUTABLE=$(which Darwin4.0 2>/dev/null)
+	fi
+fi
+
+if [ ! -x "$EXECUTABLE" ]; then
+	echo "Error: Darwin4.0 executable not found, use -x"
+	exit 1
+fi
+
+WORKDIR=$(mktemp -d ${TMPDIR:-/tmp}/darwin_benchmark.XXXXXX)
+STATUS=0
+
+# the macros refer to files relative to the top directory
+cd $TOPDIR
+
+echo "# name events init_s events_per_s max_rss_mb bytes_per_event" > $RESULTS
+echo "# $(date -u '+%Y-%m-%dT%H:%M:%SZ') $(hostname) $(git -C $TOPDIR describe --always --dirty 2>/dev/null)" >> $RESULTS
+
+grep -v '^#' $BENCHDIR/workloads.txt | while read NAME MACRO EVENTS SEED PHYSICS PREINIT; do
+	[ -z "$NAME" ] && continue
+
+	if [ -n "$SELECTED" ] && ! echo " $SELECTED " | grep -q " $NAME "; then
+		continue
+	fi
+
+	OUTPUT=$WORKDIR/$NAME.root
+	LOG=$WORKDIR/$NAME.log
+
+	ARGS="-f $BENCHDIR/$MACRO -n $EVENTS -s $SEED -p $PHYSICS -o $OUTPUT"
+	[ "$PREINIT" != "-" ] && ARGS="$ARGS -c $BENCHDIR/$PREINIT"
+
+	echo "----> $NAME: $EXECUTABLE $ARGS"
+
+	if ! $EXECUTABLE $ARGS > $LOG 2>&1; then
+		echo "Error: $NAME failed, see $LOG"
+		echo "$NAME $EVENTS nan nan nan nan" >> $RESULTS
+		continue
+	fi
+
+	# ----> Initialization (EM): 12.3 s, max RSS 512.1 MB
+	# ----> Run: 2000 events in 81.2 s (24.6 events/s), max RSS 530.7 MB
+	INIT=$(awk '/^----> Initialization/ { for(i=1; i<=NF; i++) if($i == "s,") print $(i-1) }' $LOG)
+	RATE=$(awk '/^----> Run:/ { sub(/\(/, "", $8); print $8 }' $LOG)
+	RSS=$(awk '/^----> Run:/ { print $(NF-1) }' $LOG)
+	BYTES=$(stat -c %s $OUTPUT 2>/dev/null || echo 0)
+
+	echo "$NAME $EVENTS $INIT $RATE $RSS $BYTES" | awk '{ printf "%s %d %.3f %.4g %.1f %.1f\n", $1, $2, $3, $4, $5, $6/$2 }' >> $RESULTS
+	tail -n 1 $RESULTS
+done
+
+if [ $UPDATE -eq 1 ]; then
+	if grep -q " nan " $RESULTS; then
+		echo "Error: not recording a baseline with failed workloads"
+		rm -rf $WORKDIR
+		exit 1
+	fi
+
+	# the workloads not run keep their baseline
+	awk '
+		FILENAME == ARGV[1] && !/^#/ && NF == 6 { recorded[$1] = 1; next }
+		FILENAME == ARGV[1] { next }
+		FILENAME == ARGV[2] && !/^#/ && NF == 6 && !recorded[$1] { print }
+	' $RESULTS $BASELINE > $WORKDIR/baseline.txt
+	cat $RESULTS $WORKDIR/baseline.txt > $BASELINE
+	echo "----> baseline updated: $BASELINE"
+	rm -rf $WORKDIR
+	exit 0
+fi
+
+# compare with the baseline
+awk -v RESULTS=$RESULTS -v BASELINE=$BASELINE '
+	FILENAME == ARGV[1] && !/^#/ && NF >= 3 { tolerance[$1] = $2; direction[$1] = $3; next }
+	FILENAME == ARGV[2] && !/^#/ && NF == 6 { for(i=3; i<=6; i++) base[$1, i] = $i; known[$1] = 1; next }
+	FILENAME == ARGV[3] && !/^#/ && NF == 6 {
+		split("init_s events_per_s max_rss_mb bytes_per_event", column)
+		if(!known[$1]) { printf "%-24s NO BASELINE, record it with -u\n", $1; bad = 1; next }
+		if($3 == "nan") { printf "%-24s FAILED\n", $1; bad = 1; next }
+		line = sprintf("%-24s", $1); flag = ""
+		for(i=3; i<=6; i++)
+		{
+			q = column[i-2]; b = base[$1, i]
+			change = (b > 0)?(($i - b)/b):(0)
+			line = line sprintf(" %s %+.1f%%", q, 100*change)
+			if((direction[q] == "up" && change > tolerance[q]) || (direction[q] == "down" && -change > tolerance[q]))
+				flag = flag " " q
+		}
+		if(flag != "") { bad = 1; line = line "  REGRESSION:" flag }
+		print line
+	}
+	END { exit bad }
+' $TOLERANCES $BASELINE $RESULTS || STATUS=1
+
+grep -q " nan " $RESULTS && STATUS=1
+
+rm -rf $WORKDIR
+exit $STATUS
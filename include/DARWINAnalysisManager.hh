@@ -3,17 +3,43 @@
 
 #include <globals.hh>
 
+#include <map>
+#include <vector>
+#include <fstream>
+#include <utility>
+
 #include <TParameter.h>
 
+using std::map;
+using std::vector;
+using std::pair;
+
 class G4Run;
 class G4Event;
 class G4Step;
+class G4Region;
+class G4Track;
+class G4ParticleDefinition;
 
 class TFile;
-class TTree;
 
 class DARWINEventData;
 class DARWINPrimaryGeneratorAction;
+class DARWINAnalysisMessenger;
+class DARWINStepProfiler;
+class DARWINPmtHit;
+class DARWINPmtSensitiveDetector;
+class DARWINLXeHit;
+class DARWINLXeSensitiveDetector;
+class DARWINClusterer;
+class DARWINQuenchingModel;
+class DARWINFastS2;
+class DARWINCheckpoint;
+class DARWINSummaryHistograms;
+class DARWINOutputSettings;
+class DARWINOutputBackend;
+class G4Navigator;
+template <class T> class G4THitsCollection;
 
 class DARWINAnalysisManager
 {
@@ -28,26 +54,144 @@ public:
 	virtual void EndOfEvent(const G4Event *pEvent); 
 	virtual void Step(const G4Step *pStep);	
 
+	void TrackKilled(const G4Track *pTrack);
+
+	// continues the run of a checkpoint record into a new chunk, before the first run
+	G4bool Resume(const G4String &hCheckpointFilename);
+	void RestoreEngineStatus();
+
 	void SetDataFilename(const G4String &hFilename) { m_hDataFilename = hFilename; }
 	void SetNbEventsToSimulate(G4int iNbEventsToSimulate) { m_iNbEventsToSimulate = iNbEventsToSimulate; }
+	void SetRegionStepReport(G4bool bRegionStepReport) { m_bRegionStepReport = bRegionStepReport; }
+	void SetStepProfiling(G4bool bStepProfiling);
+	void SetSparsePmtHits(G4bool bSparsePmtHits) { m_bSparsePmtHits = bSparsePmtHits; }
+	void SetPmtHitTimes(G4bool bPmtHitTimes) { m_bPmtHitTimes = bPmtHitTimes; }
+	void SetPmtTiming(const G4String &hPmtTiming) { m_hPmtTiming = hPmtTiming; }
+	void SetPmtFirstTimes(G4int iNbFirstTimes, G4double dResolution) { m_iNbPmtFirstTimes = iNbFirstTimes; m_dPmtTimeResolution = dResolution; }
+	void SetPmtTimeHistogram(G4double dBinWidth, G4double dWindow) { m_dPmtTimeBinWidth = dBinWidth; m_dPmtTimeWindow = dWindow; }
+	void SetOutputMode(const G4String &hOutputMode) { m_hOutputMode = hOutputMode; }
+	void SetOutputFormat(const G4String &hOutputFormat) { m_hOutputFormat = hOutputFormat; }
+	void SetOutputLayout(const G4String &hOutputLayout) { m_hOutputLayout = hOutputLayout; }
+	void SetRecoilClusters(G4bool bRecoilClusters) { m_bRecoilClusters = bRecoilClusters; }
+	void SetMaxEventsPerFile(G4int iMaxEventsPerFile) { m_iMaxEventsPerFile = iMaxEventsPerFile; }
+	void SetMaxFileSize(G4long lMaxFileSize) { m_lMaxFileSize = lMaxFileSize; }
+
+	DARWINClusterer *GetClusterer() const { return m_pClusterer; }
+	DARWINSummaryHistograms *GetSummaryHistograms() const { return m_pSummaryHistograms; }
+	DARWINOutputSettings *GetOutputSettings() const { return m_pOutputSettings; }
+	DARWINQuenchingModel *GetQuenchingModel() const { return m_pQuenchingModel; }
+	DARWINFastS2 *GetFastS2() const { return m_pFastS2; }
+	DARWINCheckpoint *GetCheckpoint() const { return m_pCheckpoint; }
+
+	G4int GetNbEventsToSimulate() const { return m_iNbEventsToSimulate; }
+	G4int GetNbEventsWritten() const { return m_iNbEventsWritten; }
 
 private:
 	G4bool FilterEvent(DARWINEventData *pEventData);
+	void PrintRegionStepReport(const G4Run *pRun);
+	void WriteKilledTracksSummary(const G4Run *pRun);
+	void WriteSurfaceFluxSummary();
+	G4bool IsRotating() const { return m_iMaxEventsPerFile > 0 || m_lMaxFileSize > 0; }
+	G4String GetFilenameStem() const;
+	void OpenDataFile();
+	void CloseDataFile();
+	void RotateDataFile();
+	void BookSummaryHistograms();
+	void ClusterDeposits(G4THitsCollection<DARWINLXeHit> *pLXeHitsCollection, G4int iNbLXeHits);
+	void FillSummaryHistograms();
+	void FillRecoilClusters();
+	G4bool SetupPmtTiming();
+	void FillSparsePmtHits(G4THitsCollection<DARWINPmtHit> *pPmtHitsCollection, G4int iNbPmtHits);
+	void FillTrackTable();
+	void WriteCheckpoint(G4int iLastEventId);
 
 private:
 	G4int m_iLXeHitsCollectionID;
 	G4int m_iPmtHitsCollectionID;
 
 	G4String m_hDataFilename;
+	G4String m_hOutputMode;
 	G4int m_iNbEventsToSimulate;
+	G4int m_iNbEventsWritten;
 
 	TFile *m_pTreeFile;
-	TTree *m_pTree;
 	TParameter<int> *m_pNbEventsToSimulateParameter;
 
+	// file rotation: chunks <stem>_NNNN.root listed in <stem>_index.txt
+	G4int m_iMaxEventsPerFile;
+	G4long m_lMaxFileSize;
+	G4int m_iFileNumber;
+	G4int m_iNbEventsInFile;
+	G4int m_iNbEventsWrittenInFile;
+	G4int m_iFirstEventIdInFile;
+	G4int m_iLastEventIdInFile;
+	std::ofstream m_hIndexFile;
+
+	// checkpoints: <stem>.checkpoint and the engine status, a resumed run
+	// continues the event IDs of the run and restores its state once
+	DARWINCheckpoint *m_pCheckpoint;
+	G4String m_hCheckpointFilename;
+	G4int m_iEventIdOffset;
+	G4bool m_bResumePending;
+
+	DARWINOutputSettings *m_pOutputSettings;
+
+	// root: t1 tree, columnar: .dcol file, both, the backends of the current chunk
+	G4String m_hOutputFormat;
+	vector<DARWINOutputBackend *> m_hOutputBackends;
+
+	// Steps: track data repeated on every step, Tracks: a track table per event
+	G4String m_hOutputLayout;
+	DARWINLXeSensitiveDetector *m_pLXeSensitiveDetector;
+	vector<G4int> m_hTrackTableIndices;
+
 	DARWINPrimaryGeneratorAction *m_pPrimaryGeneratorAction;
 
 	DARWINEventData *m_pEventData;
+
+	// summary mode: histograms of the clustered deposits instead of (or with) the tree
+	DARWINClusterer *m_pClusterer;
+	DARWINSummaryHistograms *m_pSummaryHistograms;
+	G4Navigator *m_pSummaryNavigator;
+
+	// nuclear/electronic recoil flag per step, recoil energies and quenched energy per cluster
+	G4bool m_bRecoilClusters;
+	DARWINQuenchingModel *m_pQuenchingModel;
+
+	// fast S2 of the clusters, active for the run if enabled and its map matches the top array
+	DARWINFastS2 *m_pFastS2;
+	G4bool m_bFastS2;
+
+	// sparse pmt hits: only the pmts with hits are written, the array sizes once per file
+	G4bool m_bSparsePmtHits;
+	G4bool m_bPmtHitTimes;
+	G4int m_iNbTopPmts;
+	G4int m_iNbBottomPmts;
+	G4int m_iNbLSPmts;
+	G4int m_iNbWaterPmts;
+	vector<G4int> m_hPmtHitCounts;
+	vector<G4double> m_hPmtHitTimes;
+
+	// photon timing per pmt, accumulated by the pmt sensitive detector
+	G4String m_hPmtTiming;
+	G4int m_iNbPmtFirstTimes;
+	G4double m_dPmtTimeResolution;
+	G4double m_dPmtTimeBinWidth;
+	G4double m_dPmtTimeWindow;
+	DARWINPmtSensitiveDetector *m_pPmtSensitiveDetector;
+
+	// number of steps per region
+	G4bool m_bRegionStepReport;
+	map<const G4Region *, G4long> m_hRegionSteps;
+	const G4Region *m_pLastRegion;
+	G4long *m_pLastRegionSteps;
+
+	DARWINStepProfiler *m_pStepProfiler;
+
+	// tracks killed by the stacking action: number and summed kinetic energy per particle
+	map<const G4ParticleDefinition *, pair<G4long, G4double> > m_hKilledTracks;
+
+	DARWINAnalysisMessenger *m_pAnalysisMessenger;
 };
 
 #endif // __DARWINPANALYSISMANAGER_H__
@@ -0,0 +1,59 @@
+#ifndef __DARWINANALYSISMESSENGER_H__
+#define __DARWINANALYSISMESSENGER_H__
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class DARWINAnalysisManager;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+
+class DARWINAnalysisMessenger: public G4UImessenger
+{
+public:
+	DARWINAnalysisMessenger(DARWINAnalysisManager *pAnalysisManager);
+	~DARWINAnalysisMessenger();
+
+	void SetNewValue(G4UIcommand *pUIcommand, G4String hString);
+
+private:
+	DARWINAnalysisManager *m_pAnalysisManager;
+
+	G4UIdirectory *m_pAnalysisDir;
+
+	G4UIcmdWithABool *m_pRegionStepReportCmd;
+	G4UIcmdWithABool *m_pStepProfilingCmd;
+	G4UIcmdWithABool *m_pSparsePmtHitsCmd;
+	G4UIcmdWithABool *m_pPmtHitTimesCmd;
+	G4UIcmdWithAString *m_pPmtTimingCmd;
+	G4UIcommand *m_pPmtFirstTimesCmd;
+	G4UIcommand *m_pPmtTimeHistogramCmd;
+	G4UIcmdWithAString *m_pOutputModeCmd;
+	G4UIcommand *m_pFiducialVolumeCmd;
+	G4UIcommand *m_pSummaryEnergyBinsCmd;
+	G4UIcmdWithADoubleAndUnit *m_pSummaryThresholdCmd;
+	G4UIcommand *m_pClusterResolutionCmd;
+	G4UIcmdWithABool *m_pRecoilClustersCmd;
+	G4UIcmdWithAString *m_pQuenchingModelCmd;
+	G4UIcmdWithADouble *m_pLindhardKCmd;
+
+	G4UIdirectory *m_pOutputDir;
+
+	G4UIcmdWithAnInteger *m_pMaxEventsPerFileCmd;
+	G4UIcommand *m_pMaxFileSizeCmd;
+	G4UIcmdWithAString *m_pPresetCmd;
+	G4UIcommand *m_pCompressionCmd;
+	G4UIcommand *m_pBasketSizeCmd;
+	G4UIcommand *m_pAutoFlushCmd;
+	G4UIcmdWithAString *m_pFormatCmd;
+	G4UIcmdWithAString *m_pLayoutCmd;
+};
+
+#endif // __DARWINANALYSISMESSENGER_H__
+
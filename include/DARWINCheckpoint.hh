@@ -0,0 +1,66 @@
+#ifndef __DARWINCHECKPOINT_H__
+#define __DARWINCHECKPOINT_H__
+
+#include <globals.hh>
+
+class DARWINCheckpointMessenger;
+
+// when to checkpoint a run and the checkpoint record, a key value text file
+// <stem>.checkpoint next to the data file with the state a run is resumed from
+// (see readme/checkpoint.txt)
+class DARWINCheckpoint
+{
+public:
+	DARWINCheckpoint();
+	~DARWINCheckpoint();
+
+public:
+	void SetEventInterval(G4int iEventInterval) { m_iEventInterval = iEventInterval; }
+	void SetTimeInterval(G4double dTimeInterval) { m_dTimeInterval = dTimeInterval; }
+
+	G4bool IsEnabled() const { return m_iEventInterval > 0 || m_dTimeInterval > 0.; }
+
+	void BeginOfRun();
+	// checked once per event, the wall time only every few events
+	G4bool IsDue(G4int iNbEventsDone);
+	// a checkpoint that cannot be written yet is due again after the next event
+	void Defer() { m_bDeferred = true; }
+
+	// the record is replaced atomically, a run killed while writing keeps the previous one
+	G4bool Write(const G4String &hFilename) const;
+	G4bool Read(const G4String &hFilename);
+
+public:
+	// data file of the original run, the resumed chunks are <stem>_resumeN.root
+	G4String m_hDataFilename;
+	G4int m_iNbResumes;
+	G4String m_hChunkFilename;
+	// last event done and events requested for the whole run, events
+	// simulated and written in the chunk so far
+	G4int m_iLastEventId;
+	G4int m_iNbEventsToSimulate;
+	G4int m_iNbEventsInChunk;
+	G4long m_lNbEntriesInChunk;
+	G4String m_hEngineStatusFilename;
+	G4long m_lEventFilePosition;
+	G4long m_lNbEventFileRecords;
+	// last decay chain started and the primaries left in the batch (empty without)
+	G4int m_iChainId;
+	G4String m_hBatchFilename;
+
+private:
+	static G4double GetWallTime();
+
+private:
+	G4int m_iEventInterval;
+	G4double m_dTimeInterval;
+
+	G4int m_iNextEvents;
+	G4double m_dNextTime;
+	G4bool m_bDeferred;
+
+	DARWINCheckpointMessenger *m_pMessenger;
+};
+
+#endif // __DARWINCHECKPOINT_H__
+
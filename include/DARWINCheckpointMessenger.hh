@@ -0,0 +1,32 @@
+#ifndef __DARWINCHECKPOINTMESSENGER_H__
+#define __DARWINCHECKPOINTMESSENGER_H__
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class DARWINCheckpoint;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+class DARWINCheckpointMessenger: public G4UImessenger
+{
+public:
+	DARWINCheckpointMessenger(DARWINCheckpoint *pCheckpoint);
+	~DARWINCheckpointMessenger();
+
+	void SetNewValue(G4UIcommand *pUIcommand, G4String hString);
+
+private:
+	DARWINCheckpoint *m_pCheckpoint;
+
+	G4UIdirectory *m_pCheckpointDir;
+
+	G4UIcmdWithAnInteger *m_pEventIntervalCmd;
+	G4UIcmdWithADoubleAndUnit *m_pTimeIntervalCmd;
+};
+
+#endif // __DARWINCHECKPOINTMESSENGER_H__
+
@@ -0,0 +1,69 @@
+#ifndef __DARWINCLUSTERER_H__
+#define __DARWINCLUSTERER_H__
+
+#include <globals.hh>
+#include <G4ThreeVector.hh>
+
+#include <vector>
+
+using std::vector;
+
+// groups the energy deposits of an event into interaction sites: deposits
+// closer than the z resolution (and the xy resolution, if set) to an open
+// cluster are merged, positions are energy weighted
+class DARWINClusterer
+{
+public:
+	DARWINClusterer();
+	~DARWINClusterer();
+
+public:
+	struct Cluster
+	{
+		G4ThreeVector hPosition;
+		G4double dEnergy;
+		G4double dNrEnergy;
+		G4double dTime;
+		G4int iNbDeposits;
+	};
+
+public:
+	void SetResolution(G4double dResolutionZ, G4double dResolutionXY) { m_dResolutionZ = dResolutionZ; m_dResolutionXY = dResolutionXY; }
+
+	G4double GetResolutionZ() const { return m_dResolutionZ; }
+	G4double GetResolutionXY() const { return m_dResolutionXY; }
+
+	void Clear();
+	// deposits without energy are ignored, the energy of nuclear recoils is also summed separately
+	void AddDeposit(const G4ThreeVector &hPosition, G4double dEnergy, G4double dTime, G4bool bNuclearRecoil = false);
+
+	// clusters sorted by z, the deposits are kept until the next Clear()
+	const vector<Cluster> &MakeClusters();
+	const vector<Cluster> &GetClusters() const { return m_hClusters; }
+
+	// index of the cluster each deposit was assigned to, in the order they were added
+	const vector<G4int> &GetDepositClusters() const { return m_hDepositClusters; }
+
+private:
+	struct Deposit
+	{
+		G4ThreeVector hPosition;
+		G4double dEnergy;
+		G4double dTime;
+		G4bool bNuclearRecoil;
+		G4int iIndex;
+
+		bool operator<(const Deposit &hOther) const { return hPosition.z() < hOther.hPosition.z(); }
+	};
+
+private:
+	G4double m_dResolutionZ;
+	G4double m_dResolutionXY;
+
+	vector<Deposit> m_hDeposits;
+	vector<Cluster> m_hClusters;
+	vector<G4int> m_hDepositClusters;
+};
+
+#endif // __DARWINCLUSTERER_H__
+
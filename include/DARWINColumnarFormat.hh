@@ -0,0 +1,171 @@
+#ifndef __DARWINCOLUMNARFORMAT_H__
+#define __DARWINCOLUMNARFORMAT_H__
+
+// self-describing columnar event files (.dcol), written by the columnar
+// output backend and read without ROOT or Geant4 (see readme/columnar_format.txt),
+// only the standard library and POSIX are used so tools/ can link it alone
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstddef>
+#include <stdint.h>
+
+// column types: 32 bit integers, floats, doubles and strings stored as
+// 32 bit codes into a per column dictionary
+enum DARWINColumnType
+{
+	kColumnInt = 'i',
+	kColumnFloat = 'f',
+	kColumnDouble = 'd',
+	kColumnString = 's'
+};
+
+class DARWINColumnarWriter
+{
+public:
+	DARWINColumnarWriter();
+	~DARWINColumnarWriter();
+
+public:
+	bool Open(const std::string &hFilename, uint32_t iChunkSize = 4096);
+	bool Close();
+
+	bool IsOpen() const { return m_pFile != 0; }
+	uint64_t GetBytesWritten() const { return m_lPosition; }
+
+	// columns are defined before the first event, vectors have a variable
+	// number of elements per event
+	int AddColumn(const std::string &hName, DARWINColumnType iType, bool bVector);
+
+	void SetInt(int iColumn, int32_t iValue);
+	void SetFloat(int iColumn, float fValue);
+	void SetDouble(int iColumn, double dValue);
+	void SetString(int iColumn, const std::string &hValue);
+
+	void AppendInts(int iColumn, const std::vector<int> &hValues);
+	void AppendFloats(int iColumn, const std::vector<float> &hValues);
+	void AppendStrings(int iColumn, const std::vector<std::string> &hValues);
+
+	// scalars not set in the event are 0, vectors not appended are empty
+	void EndEvent();
+
+private:
+	struct Column
+	{
+		std::string hName;
+		DARWINColumnType iType;
+		bool bVector;
+		bool bFilled;
+
+		std::vector<char> hData;
+		std::vector<uint32_t> hOffsets;
+		uint32_t iNbElements;
+
+		std::map<std::string, int32_t> hCodes;
+		std::vector<std::string> hStrings;
+	};
+
+	struct ChunkColumn
+	{
+		uint64_t lDataOffset;
+		uint64_t lNbElements;
+		uint64_t lOffsetsOffset;
+	};
+
+	struct Chunk
+	{
+		uint64_t lNbEvents;
+		std::vector<ChunkColumn> hColumns;
+	};
+
+	void Append(Column &hColumn, const void *pValues, size_t lSize, uint32_t iNbValues);
+	int32_t GetCode(Column &hColumn, const std::string &hValue);
+
+	void FlushChunk();
+	uint64_t WriteBlock(const void *pData, size_t lSize);
+	void WriteRaw(const void *pData, size_t lSize);
+	void WriteFooter();
+
+private:
+	FILE *m_pFile;
+	uint64_t m_lPosition;
+	uint32_t m_iChunkSize;
+	uint32_t m_iNbChunkEvents;
+
+	std::vector<Column> m_hColumns;
+	std::vector<Chunk> m_hChunks;
+};
+
+// maps the whole file, data and offsets point into the mapping and stay
+// valid until Close()
+class DARWINColumnarReader
+{
+public:
+	DARWINColumnarReader();
+	~DARWINColumnarReader();
+
+public:
+	bool Open(const std::string &hFilename);
+	void Close();
+
+	bool IsOpen() const { return m_pData != 0; }
+
+	int GetNbColumns() const { return m_hColumns.size(); }
+	int GetNbChunks() const { return m_hChunks.size(); }
+	uint64_t GetNbEvents() const { return m_lNbEvents; }
+	uint64_t GetNbChunkEvents(int iChunk) const { return m_hChunks[iChunk].lNbEvents; }
+
+	int FindColumn(const std::string &hName) const;
+	const std::string &GetColumnName(int iColumn) const { return m_hColumns[iColumn].hName; }
+	DARWINColumnType GetColumnType(int iColumn) const { return m_hColumns[iColumn].iType; }
+	bool IsVector(int iColumn) const { return m_hColumns[iColumn].bVector; }
+	const std::vector<std::string> &GetDictionary(int iColumn) const { return m_hColumns[iColumn].hStrings; }
+
+	// all values of a column in a chunk
+	const void *GetData(int iColumn, int iChunk, uint64_t &lNbElements) const;
+	// vectors: nbevents+1 offsets into the data of the chunk
+	const uint32_t *GetOffsets(int iColumn, int iChunk) const;
+
+	template <class T> const T *Get(int iColumn, int iChunk, uint64_t &lNbElements) const
+	{ return static_cast<const T *>(GetData(iColumn, iChunk, lNbElements)); }
+
+private:
+	struct Column
+	{
+		std::string hName;
+		DARWINColumnType iType;
+		bool bVector;
+		std::vector<std::string> hStrings;
+	};
+
+	struct ChunkColumn
+	{
+		uint64_t lDataOffset;
+		uint64_t lNbElements;
+		uint64_t lOffsetsOffset;
+	};
+
+	struct Chunk
+	{
+		uint64_t lNbEvents;
+		std::vector<ChunkColumn> hColumns;
+	};
+
+	bool ReadFooter();
+	bool Read(const char *&pCursor, void *pValue, size_t lSize) const;
+	bool ReadString(const char *&pCursor, std::string &hString) const;
+
+private:
+	int m_iFileDescriptor;
+	const char *m_pData;
+	size_t m_lSize;
+
+	uint64_t m_lNbEvents;
+	std::vector<Column> m_hColumns;
+	std::vector<Chunk> m_hChunks;
+};
+
+#endif // __DARWINCOLUMNARFORMAT_H__
+
@@ -0,0 +1,53 @@
+#ifndef __DARWINCOLUMNAROUTPUT_H__
+#define __DARWINCOLUMNAROUTPUT_H__
+
+#include <vector>
+
+#include "DARWINOutputBackend.hh"
+#include "DARWINColumnarFormat.hh"
+
+// writes the t1 columns to a columnar file (.dcol) readable without ROOT
+class DARWINColumnarOutput: public DARWINOutputBackend
+{
+public:
+	DARWINColumnarOutput(const DARWINOutputColumns &hColumns);
+	~DARWINColumnarOutput();
+
+public:
+	G4bool Open(const G4String &hFilename);
+	void WriteEvent(const DARWINEventData *pEventData);
+	void Close();
+
+	G4String GetExtension() const { return ".dcol"; }
+	G4long GetBytesWritten() const { return m_hWriter.GetBytesWritten(); }
+
+private:
+	enum Columns
+	{
+		kEventId, kChainId, kChainTime, kWeight, kNbTopPmtHits, kNbBottomPmtHits,
+		kPmtHits, kPmtHitId, kPmtHitCount, kPmtHitTime, kPmtTimeId, kPmtTimeN, kPmtTimes, kPmtTime0,
+		kTotalEnergyDeposited, kNbSteps,
+		kTrackId, kParticleType, kParentId, kParentType, kCreatorProcess,
+		kDepositingProcess, kX, kY, kZ, kEnergyDeposited, kTime,
+		kPrimaryParticleType, kPrimaryX, kPrimaryY, kPrimaryZ, kPrimaryE,
+		kStepTrackIndex, kTrackTableId, kTrackTableParentId, kTrackTablePdg, kTrackTableCreatorProcess,
+		kTrackTableX, kTrackTableY, kTrackTableZ, kTrackTableEnergy,
+		kNuclearRecoil, kClusterX, kClusterY, kClusterZ, kClusterNrEnergy, kClusterErEnergy, kClusterEeEnergy,
+		kS2PmtHits, kS2Electrons, kS2Time, kS2Width,
+		kNbColumns
+	};
+
+	void DefineColumns();
+
+private:
+	DARWINOutputColumns m_hColumns;
+
+	DARWINColumnarWriter m_hWriter;
+	int m_pColumns[kNbColumns];
+
+	// unsigned short columns are stored as int
+	std::vector<int> m_hConverted;
+};
+
+#endif // __DARWINCOLUMNAROUTPUT_H__
+
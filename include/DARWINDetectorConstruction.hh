@@ -31,6 +31,9 @@ public:
 	void SetLXeAbsorbtionLength(G4double dAbsorbtionLength);
 	void SetLXeRayScatterLength(G4double dRayScatterLength);
 
+	void SetRegionCut(const G4String &hRegionName, G4double dCut);
+	void SetRegionMaxStep(const G4String &hRegionName, G4double dMaxStep);
+
 	static G4double GetGeometryParameter(const char *szParameter);
 
 
@@ -48,6 +51,10 @@ private:
 	void ConstructQUPIDArrays();
 	void ConstructVetoPMTArrays();
 	void ConstructSensitiveLXe();
+	void ConstructRegions();
+
+	void ApplyRegionCut(const G4String &hRegionName);
+	void ApplyRegionMaxStep(const G4String &hRegionName);
 
 	void CheckOverlapping();
 	void PrintGeometryInformation();
@@ -186,6 +193,10 @@ private:
 	G4VPhysicalVolume *m_pSensitiveLXePhysicalVolume;
 
 	static map<G4String, G4double> m_hGeometryParameters;
+
+	// production cuts and step limits per region, set from the messenger
+	map<G4String, G4double> m_hRegionCuts;
+	map<G4String, G4double> m_hRegionMaxSteps;
 	
 	DARWINDetectorMessenger *m_pDetectorMessenger;
 
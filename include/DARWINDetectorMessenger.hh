@@ -36,6 +36,14 @@ private:
 	G4UIcmdWithADoubleAndUnit *m_pLXeAbsorbtionLengthCmd;
 	G4UIcmdWithADoubleAndUnit *m_pLXeRayScatterLengthCmd;
 
+	G4UIdirectory *m_pCutsDir;
+
+	G4UIcmdWithADoubleAndUnit *m_pWaterCutCmd;
+	G4UIcmdWithADoubleAndUnit *m_pCryostatCutCmd;
+	G4UIcmdWithADoubleAndUnit *m_pTPCCutCmd;
+	G4UIcmdWithADoubleAndUnit *m_pLXeCutCmd;
+	G4UIcommand *m_pMaxStepCmd;
+
 };
 
 #endif
@@ -0,0 +1,59 @@
+#ifndef __DARWINDISTANCEMAP_H__
+#define __DARWINDISTANCEMAP_H__
+
+#include <globals.hh>
+#include <G4ThreeVector.hh>
+#include <G4AffineTransform.hh>
+
+#include <vector>
+#include <cmath>
+#include <cfloat>
+
+using std::vector;
+
+class G4VPhysicalVolume;
+
+// coarse 3D map of the distance to a target volume, computed once from the
+// geometry, the stored distance is a lower bound for any point of a voxel
+class DARWINDistanceMap
+{
+public:
+	DARWINDistanceMap();
+	~DARWINDistanceMap();
+
+public:
+	G4bool Build(G4VPhysicalVolume *pWorld, const G4String &hTargetName, G4double dVoxelSize,
+		const G4ThreeVector &hMin, const G4ThreeVector &hMax);
+
+	G4bool IsBuilt() const { return !m_hDistances.empty(); }
+
+	// returns DBL_MAX outside of the mapped region
+	inline G4double GetDistance(const G4ThreeVector &hPosition) const;
+
+private:
+	static G4bool FindVolume(G4VPhysicalVolume *pVolume, const G4String &hName,
+		const G4AffineTransform &hTransform, G4VPhysicalVolume *&pFound, G4AffineTransform &hFoundTransform);
+
+private:
+	G4ThreeVector m_hMin;
+	G4double m_dVoxelSize;
+	G4int m_iNbX, m_iNbY, m_iNbZ;
+
+	vector<float> m_hDistances;
+};
+
+inline G4double
+DARWINDistanceMap::GetDistance(const G4ThreeVector &hPosition) const
+{
+	G4int iX = (G4int) std::floor((hPosition.x()-m_hMin.x())/m_dVoxelSize);
+	G4int iY = (G4int) std::floor((hPosition.y()-m_hMin.y())/m_dVoxelSize);
+	G4int iZ = (G4int) std::floor((hPosition.z()-m_hMin.z())/m_dVoxelSize);
+
+	if(iX < 0 || iX >= m_iNbX || iY < 0 || iY >= m_iNbY || iZ < 0 || iZ >= m_iNbZ)
+		return DBL_MAX;
+
+	return m_hDistances[(iZ*m_iNbY + iY)*m_iNbX + iX];
+}
+
+#endif // __DARWINDISTANCEMAP_H__
+
@@ -7,10 +7,12 @@
 
 class G4Event;
 
+class DARWINProgressReporter;
+
 class DARWINEventAction : public G4UserEventAction
 {
 public:
-	DARWINEventAction(DARWINAnalysisManager *pAnalysisManager = 0);
+	DARWINEventAction(DARWINAnalysisManager *pAnalysisManager = 0, DARWINProgressReporter *pProgressReporter = 0);
 	~DARWINEventAction();
 
 public:
@@ -19,6 +21,8 @@ public:
 
 private:
 	DARWINAnalysisManager *m_pAnalysisManager;
+
+	DARWINProgressReporter *m_pProgressReporter;
 };
 
 #endif // __XENON10PEVENTACTION_H__
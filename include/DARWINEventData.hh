@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
 
 using std::string;
 using std::vector;
@@ -14,21 +15,42 @@ public:
 	~DARWINEventData();
 
 public:
+	// column groups written to the output, only these are reserved and cleared
+	enum { kStepTrackColumns = 1, kTrackTableColumns = 2, kRecoilColumns = 4 };
+
+	void SetColumns(int iColumns);
+	int GetColumns() const { return m_iColumns; }
+
+	// capacity of the step and track columns from the largest event so far, with
+	// headroom, so that the columns are not regrown once the largest event passed
+	// (the elements of the string columns are still allocated per step)
+	void ReserveSteps(size_t lNbSteps);
+	void ReserveTracks(size_t lNbTracks);
+
 	void Clear();
 
 public:
 	int m_iEventId;								// the event ID
+	int m_iChainId;								// decay chain the event belongs to
+	double m_dChainTime;						// time of the event since the first decay of the chain
+	float m_fWeight;							// weight of the event from the event file
 	int m_iNbTopPmtHits;						// number of top pmt hits
 	int m_iNbBottomPmtHits;						// number of bottom pmt hits
 	int m_iNbLSPmtHits;						// number of LS pmt hits
 	int m_iNbWaterPmtHits;						// number of water pmt hits
 	vector<int> *m_pPmtHits;					// number of photon hits per pmt
+	vector<int> *m_pPmtHitId;					// sparse mode: pmts with at least one hit
+	vector<int> *m_pPmtHitCount;				// sparse mode: number of photon hits of these pmts
+	vector<float> *m_pPmtHitTime;				// sparse mode: time of the first photon hit
+	vector<int> *m_pPmtTimeId;					// timing mode: pmts with photon times
+	vector<unsigned short> *m_pPmtTimeN;		// timing mode: number of packed values per pmt
+	vector<unsigned short> *m_pPmtTimes;		// timing mode: first photon times or time histogram
+	double m_dPmtTime0;							// timing mode: global time of the first photon, pmttimes count from it
 	float m_fTotalEnergyDeposited;				// total energy deposited in the ScintSD
 	int m_iNbSteps;								// number of energy depositing steps
 	vector<int> *m_pTrackId;					// id of the particle
 	vector<int> *m_pParentId;					// id of the parent particle
 	vector<string> *m_pParticleType;			// type of particle
-	vector<int> *m_pParticlePdg;			// PDG code of particle
 	vector<string> *m_pParentType;				// type of particle
 	vector<string> *m_pCreatorProcess;			// interaction
 	vector<string> *m_pDepositingProcess;		// energy depositing process
@@ -36,35 +58,37 @@ public:
 	vector<float> *m_pY;
 	vector<float> *m_pZ;
 	vector<float> *m_pEnergyDeposited; 			// energy deposited in the step
-	vector<float> *m_pKineticEnergy;			// particle kinetic energy after the step			
 	vector<float> *m_pTime;						// time of the step
 	vector<int> *m_pNr;						// NuclearRecoil (1) or EMrecoil (0)
+	vector<float> *m_pClusterX;					// recoil clusters: position of the cluster
+	vector<float> *m_pClusterY;
+	vector<float> *m_pClusterZ;
+	vector<float> *m_pClusterNrEnergy;			// recoil clusters: nuclear recoil energy
+	vector<float> *m_pClusterErEnergy;			// recoil clusters: electronic recoil energy
+	vector<float> *m_pClusterEeEnergy;			// recoil clusters: quenched electron equivalent energy
+	vector<int> *m_pS2PmtHits;					// fast S2: photon hits per top pmt
+	vector<int> *m_pS2Electrons;				// fast S2: extracted electrons per cluster
+	vector<float> *m_pS2Time;					// fast S2: arrival time of the electrons at the surface
+	vector<float> *m_pS2Width;					// fast S2: spread of the arrival time from longitudinal diffusion
+	vector<int> *m_pStepTrackIndex;				// tracks layout: index of the track of the step in the track table
+	vector<int> *m_pTrackTableId;				// tracks layout: id of the track
+	vector<int> *m_pTrackTableParentId;			// tracks layout: id of the parent track
+	vector<int> *m_pTrackTablePdg;				// tracks layout: PDG code of the particle
+	vector<string> *m_pTrackTableCreatorProcess;	// tracks layout: creator process
+	vector<float> *m_pTrackTableX;				// tracks layout: start position of the track
+	vector<float> *m_pTrackTableY;
+	vector<float> *m_pTrackTableZ;
+	vector<float> *m_pTrackTableEnergy;			// tracks layout: start kinetic energy of the track
 	vector<string> *m_pPrimaryParticleType;		// type of particle
 	float m_fPrimaryX;							// position of the primary particle
 	float m_fPrimaryY;
 	float m_fPrimaryZ;	
-	float m_fPrimaryCx;							// direction of the primary particle
-	float m_fPrimaryCy;
-	float m_fPrimaryCz;	
         float m_fPrimaryE;							// Initial energy of the primary particle
 
-  //MS In the following bank we save particle information in various positions, for ex. 
-  //- entering the OuterCryostat from outside ... i.e. those crossing the whole shield
-  //- optical photons when touching the tank surfaces
-  //- active LXe volume (between anode and cathode)
-  int	m_iNSave;              //
-  vector<int> *m_pSave_flag;
-  vector<int> *m_pSave_type;
-  vector<float> *m_pSave_x;
-  vector<float> *m_pSave_y;
-  vector<float> *m_pSave_z;
-  vector<float> *m_pSave_cx;
-  vector<float> *m_pSave_cy;
-  vector<float> *m_pSave_cz;
-  vector<float> *m_pSave_e;
-
-  int m_iTotOptPhot;
-  float m_fTotPathWater;
+private:
+	int m_iColumns;
+	size_t m_lStepCapacity;
+	size_t m_lTrackCapacity;
 };
 
 #endif // __XENON10PEVENTDATA_H__
@@ -0,0 +1,73 @@
+#ifndef __DARWINEVENTFILEREADER_H__
+#define __DARWINEVENTFILEREADER_H__
+
+#include <globals.hh>
+#include <G4ThreeVector.hh>
+
+#include <cstddef>
+
+class G4Event;
+class G4ParticleDefinition;
+
+// streams multi-particle vertices from an externally generated event file,
+// the file is memory-mapped and only the records of the selected partition
+// are read (see readme/eventfile_format.txt)
+class DARWINEventFileReader
+{
+public:
+	DARWINEventFileReader();
+	~DARWINEventFileReader();
+
+public:
+	G4bool Open(const G4String &hFileName, const G4String &hFormat = "auto");
+	void Close();
+
+	G4bool IsOpen() const { return m_pData != 0; }
+
+	// records whose header starts in the iIndex-th of iNbPartitions equal byte ranges
+	void SetPartition(G4int iIndex, G4int iNbPartitions);
+	void SetOffset(const G4ThreeVector &hOffset) { m_hOffset = hOffset; }
+
+	// adds the vertex of the next record, false at the end of the partition
+	G4bool GeneratePrimaryVertex(G4Event *pEvent, G4double &dWeight);
+
+	G4long GetNbRecordsRead() const { return m_lNbRecordsRead; }
+
+	// byte offset of the next record, a resumed run continues where its checkpoint was
+	G4long GetPosition() const { return (IsOpen())?(m_pCursor-m_pData):(-1); }
+	void SetPosition(G4long lPosition, G4long lNbRecordsRead);
+
+private:
+	void Rewind();
+
+	const char *FindTextRecord(const char *pPosition) const;
+	const char *FindBinaryRecord(const char *pPosition) const;
+	G4bool IsBinaryRecord(const char *pPosition) const;
+
+	G4bool ReadTextRecord(G4Event *pEvent, G4double &dWeight);
+	G4bool ReadBinaryRecord(G4Event *pEvent, G4double &dWeight);
+
+	const char *GetLine(const char *pPosition, G4String &hLine) const;
+	static G4int GetFields(const G4String &hLine, G4double *pFields, G4int iMaxFields);
+
+	static G4ParticleDefinition *FindParticle(G4int iPdgCode);
+
+private:
+	G4String m_hFileName;
+	G4bool m_bBinary;
+
+	int m_iFileDescriptor;
+	const char *m_pData;
+	size_t m_lSize;
+
+	G4int m_iPartition;
+	G4int m_iNbPartitions;
+	const char *m_pCursor;
+	const char *m_pPartitionEnd;
+
+	G4ThreeVector m_hOffset;
+	G4long m_lNbRecordsRead;
+};
+
+#endif // __DARWINEVENTFILEREADER_H__
+
@@ -0,0 +1,102 @@
+#ifndef __DARWINFASTS2_H__
+#define __DARWINFASTS2_H__
+
+#include <globals.hh>
+
+#include <vector>
+#include <cmath>
+
+#include "DARWINClusterer.hh"
+
+using std::vector;
+
+class DARWINQuenchingModel;
+class DARWINFastS2Messenger;
+
+// S2 of the clustered LXe deposits without tracking electroluminescence: the
+// electrons of each cluster are drifted to the liquid surface with the
+// electron lifetime and diffusion, extracted, and their light is spread over
+// the top array with a per pmt light collection map in (x, y)
+class DARWINFastS2
+{
+public:
+	DARWINFastS2();
+	~DARWINFastS2();
+
+public:
+	void SetEnabled(G4bool bEnabled) { m_bEnabled = bEnabled; }
+	G4bool IsEnabled() const { return m_bEnabled; }
+
+	// maps and parameter files are kept in memory, a map is only read again if
+	// its file changed, the parsed map is cached next to it in <file>.bin
+	G4bool LoadMap(const G4String &hFilename);
+	G4bool LoadParameters(const G4String &hFilename);
+
+	void SetElectronLifetime(G4double dElectronLifetime) { m_dElectronLifetime = dElectronLifetime; }
+	void SetDriftVelocity(G4double dDriftVelocity) { m_dDriftVelocity = dDriftVelocity; }
+	void SetDiffusion(G4double dLongitudinal, G4double dTransverse) { m_dLongitudinalDiffusion = dLongitudinal; m_dTransverseDiffusion = dTransverse; }
+	void SetChargeYield(G4double dChargeYield) { m_dChargeYield = dChargeYield; }
+	void SetExtractionEfficiency(G4double dExtractionEfficiency) { m_dExtractionEfficiency = dExtractionEfficiency; }
+	void SetElectroluminescenceYield(G4double dElectroluminescenceYield) { m_dElectroluminescenceYield = dElectroluminescenceYield; }
+	void SetLiquidSurface(G4double dLiquidSurfaceZ) { m_dLiquidSurfaceZ = dLiquidSurfaceZ; m_bLiquidSurfaceSet = true; }
+	void SetNbElectronGroups(G4int iNbElectronGroups) { m_iNbElectronGroups = iNbElectronGroups; }
+
+	// drift length and liquid surface from the geometry unless set, false if
+	// the map does not match the top array
+	G4bool Initialize(G4int iNbTopPmts);
+
+	// top pmt hits of the event and per cluster the extracted electrons, the
+	// arrival time at the surface and its spread from longitudinal diffusion
+	void Simulate(const vector<DARWINClusterer::Cluster> &hClusters, const DARWINQuenchingModel *pQuenchingModel,
+		vector<int> *pPmtHits, vector<int> *pElectrons, vector<float> *pTimes, vector<float> *pWidths);
+
+	void PrintParameters() const;
+
+private:
+	G4bool ReadMapCache(const G4String &hFilename);
+	void WriteMapCache(const G4String &hFilename) const;
+	G4bool ReadMapText(const G4String &hFilename);
+
+	inline const float *GetLightCollection(G4double dX, G4double dY) const;
+
+private:
+	G4bool m_bEnabled;
+
+	G4double m_dElectronLifetime;
+	G4double m_dDriftVelocity;
+	G4double m_dLongitudinalDiffusion;
+	G4double m_dTransverseDiffusion;
+	G4double m_dChargeYield;
+	G4double m_dExtractionEfficiency;
+	G4double m_dElectroluminescenceYield;
+	G4double m_dLiquidSurfaceZ;
+	G4bool m_bLiquidSurfaceSet;
+	G4double m_dDriftLength;
+	G4int m_iNbElectronGroups;
+
+	// light collection per pmt for each (x, y) bin, x runs fastest
+	G4String m_hMapFilename;
+	long m_lMapModificationTime;
+	G4int m_iNbMapPmts;
+	G4int m_iNbX, m_iNbY;
+	G4double m_dXMin, m_dXMax, m_dYMin, m_dYMax;
+	vector<float> m_hMap;
+
+	vector<G4double> m_hMeanHits;
+
+	DARWINFastS2Messenger *m_pMessenger;
+};
+
+inline const float *
+DARWINFastS2::GetLightCollection(G4double dX, G4double dY) const
+{
+	G4int iX = (G4int) std::floor((dX-m_dXMin)/(m_dXMax-m_dXMin)*m_iNbX);
+	G4int iY = (G4int) std::floor((dY-m_dYMin)/(m_dYMax-m_dYMin)*m_iNbY);
+
+	if(iX < 0 || iX >= m_iNbX || iY < 0 || iY >= m_iNbY)
+		return 0;
+
+	return &m_hMap[((size_t) iY*m_iNbX + iX)*m_iNbMapPmts];
+}
+
+#endif // __DARWINFASTS2_H__
@@ -0,0 +1,36 @@
+#ifndef __DARWINFASTS2MESSENGER_H__
+#define __DARWINFASTS2MESSENGER_H__
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class DARWINFastS2;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+
+class DARWINFastS2Messenger: public G4UImessenger
+{
+public:
+	DARWINFastS2Messenger(DARWINFastS2 *pFastS2);
+	~DARWINFastS2Messenger();
+
+	void SetNewValue(G4UIcommand *pUIcommand, G4String hString);
+
+private:
+	DARWINFastS2 *m_pFastS2;
+
+	G4UIdirectory *m_pFastS2Dir;
+
+	G4UIcmdWithABool *m_pEnabledCmd;
+	G4UIcmdWithAString *m_pMapFileCmd;
+	G4UIcmdWithAString *m_pParameterFileCmd;
+	G4UIcmdWithADoubleAndUnit *m_pElectronLifetimeCmd;
+	G4UIcmdWithADoubleAndUnit *m_pLiquidSurfaceCmd;
+	G4UIcommand *m_pDiffusionCmd;
+};
+
+#endif // __DARWINFASTS2MESSENGER_H__
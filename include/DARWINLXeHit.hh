@@ -23,6 +23,7 @@ public:
 
 public:
 	void SetTrackId(G4int iTrackId) { m_iTrackId = iTrackId; };
+	void SetTrackIndex(G4int iTrackIndex) { m_iTrackIndex = iTrackIndex; };
 	void SetParentId(G4int iParentId) { m_iParentId = iParentId; };
 	void SetParticleType(const G4String &hParticleType) { m_pParticleType = new G4String(hParticleType); }
 	void SetParticlePdg(G4int iParticlePdg) { m_pParticlePdg = iParticlePdg; };
@@ -33,8 +34,10 @@ public:
 	void SetEnergyDeposited(G4double dEnergyDeposited) { m_dEnergyDeposited = dEnergyDeposited; };
 	void SetKineticEnergy(G4double dKineticEnergy) { m_dKineticEnergy = dKineticEnergy; };
 	void SetTime(G4double dTime) { m_dTime = dTime; };
+	void SetNuclearRecoil(G4bool bNuclearRecoil) { m_bNuclearRecoil = bNuclearRecoil; };
 
 	G4int GetTrackId() { return m_iTrackId; };
+	G4int GetTrackIndex() { return m_iTrackIndex; };
 	G4int GetParentId() { return m_iParentId; };
 	const G4String &GetParticleType() { return *m_pParticleType; }
 	G4int GetParticlePdg() { return m_pParticlePdg; }
@@ -45,9 +48,11 @@ public:
 	G4double GetEnergyDeposited() { return m_dEnergyDeposited; };      
 	G4double GetKineticEnergy() { return m_dKineticEnergy; };      
 	G4double GetTime() { return m_dTime; };      
+	G4bool IsNuclearRecoil() { return m_bNuclearRecoil; };
 
 private:
 	G4int m_iTrackId;
+	G4int m_iTrackIndex;
 	G4int m_iParentId;
 	G4String *m_pParticleType;
 	G4int m_pParticlePdg;
@@ -58,6 +63,7 @@ private:
 	G4double m_dEnergyDeposited;
 	G4double m_dKineticEnergy;
 	G4double m_dTime;
+	G4bool m_bNuclearRecoil;
 };
 
 typedef G4THitsCollection<DARWINLXeHit> DARWINLXeHitsCollection;
@@ -2,11 +2,14 @@
 #define __XENON10PLXESENSITIVEDETECTOR_H__
 
 #include <map>
+#include <vector>
 #include <G4VSensitiveDetector.hh>
+#include <G4ThreeVector.hh>
 
 #include "DARWINLXeHit.hh"
 
 using std::map;
+using std::vector;
 
 class G4Step;
 class G4HCofThisEvent;
@@ -21,10 +24,31 @@ public:
 	G4bool ProcessHits(G4Step *pStep, G4TouchableHistory *pHistory);
 	void EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent);
 
+public:
+	// tracks with energy deposits in the event, in the order of their first
+	// deposit, the hits point into it with their track index
+	struct Track
+	{
+		G4int iTrackId;
+		G4int iParentId;
+		G4int iPdg;
+		G4bool bNucleus;
+		G4String hParticleType;
+		G4String hCreatorProcess;
+		G4ThreeVector hStartPosition;
+		G4double dStartEnergy;
+	};
+
+	const vector<Track> &GetTracks() const { return m_hTracks; }
+
+private:
+	G4int AddTrack(const G4Track *pTrack);
+
 private:
 	DARWINLXeHitsCollection* m_pLXeHitsCollection;
 
-	map<int,G4String> m_hParticleTypes;
+	map<int,int> m_hTrackIndices;
+	vector<Track> m_hTracks;
 };
 
 #endif // __XENON10PLXESENSITIVEDETECTOR_H__
@@ -0,0 +1,39 @@
+#ifndef __DARWINOUTPUTBACKEND_H__
+#define __DARWINOUTPUTBACKEND_H__
+
+#include <globals.hh>
+
+class DARWINEventData;
+
+// optional column groups of the t1 layout, the same for every backend
+struct DARWINOutputColumns
+{
+	G4bool bSparsePmtHits;
+	G4bool bPmtHitTimes;
+	G4bool bPmtTiming;
+	G4bool bTrackTable;
+	G4bool bRecoilClusters;
+	G4bool bFastS2;
+};
+
+// event stream written by the analysis manager, the t1 tree and/or the
+// columnar file, one file per output chunk
+class DARWINOutputBackend
+{
+public:
+	virtual ~DARWINOutputBackend() {}
+
+public:
+	virtual G4bool Open(const G4String &hFilename) = 0;
+	virtual void WriteEvent(const DARWINEventData *pEventData) = 0;
+	// makes the events written so far readable from the file, for checkpoints
+	virtual void Flush() {}
+	virtual void Close() = 0;
+
+	// file name extension, with the dot
+	virtual G4String GetExtension() const = 0;
+	virtual G4long GetBytesWritten() const = 0;
+};
+
+#endif // __DARWINOUTPUTBACKEND_H__
+
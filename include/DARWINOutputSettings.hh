@@ -0,0 +1,59 @@
+#ifndef __DARWINOUTPUTSETTINGS_H__
+#define __DARWINOUTPUTSETTINGS_H__
+
+#include <globals.hh>
+
+#include <map>
+#include <set>
+
+using std::map;
+using std::set;
+
+class TFile;
+class TTree;
+
+// compression, basket size and auto-flush of the output tree, for the whole
+// file and per branch, unset values keep the ROOT defaults
+class DARWINOutputSettings
+{
+public:
+	DARWINOutputSettings();
+	~DARWINOutputSettings();
+
+public:
+	// fast (LZ4), balanced (ZSTD, LZ4 for the strings) or archive (LZMA)
+	G4bool SetPreset(const G4String &hPreset);
+
+	// algorithm: default, zlib, lzma, lz4 or zstd, an empty branch name or * sets the file default
+	G4bool SetCompression(const G4String &hAlgorithm, G4int iLevel, const G4String &hBranch = "");
+	void SetBasketSize(G4int iBasketSize, const G4String &hBranch = "");
+	// entries if positive, bytes if negative, 0 disables it
+	void SetAutoFlush(G4long lAutoFlush) { m_lAutoFlush = lAutoFlush; m_bAutoFlush = true; }
+
+	void Reset();
+
+	void Apply(TFile *pFile) const;
+	void Apply(TTree *pTree) const;
+
+	// one line per setting, stored in the output file
+	G4String GetDescription() const;
+
+private:
+	static G4int GetCompressionSettings(const G4String &hAlgorithm, G4int iLevel);
+
+private:
+	G4String m_hPreset;
+
+	G4int m_iCompressionSettings;
+	G4int m_iBasketSize;
+	G4bool m_bAutoFlush;
+	G4long m_lAutoFlush;
+
+	map<G4String, G4int> m_hBranchCompressionSettings;
+	map<G4String, G4int> m_hBranchBasketSizes;
+	// per branch settings of the preset, not an error if the tree lacks the branch
+	set<G4String> m_hPresetBranches;
+};
+
+#endif // __DARWINOUTPUTSETTINGS_H__
+
@@ -9,10 +9,16 @@
 #include "TH1.h"
 
 #include <set>
+#include <vector>
 
 using std::set;
+using std::vector;
 
 #include "DARWINParticleSourceMessenger.hh"
+#include "DARWINVolumeSet.hh"
+
+class DARWINSurfaceSampler;
+class DARWINEventFileReader;
 
 class DARWINParticleSource: public G4VPrimaryGenerator
 {
@@ -23,12 +29,26 @@ public:
 public:
 	void GeneratePrimaryVertex(G4Event *pEvent);
 	void GeneratePrimaryVertexFromTrack(G4Track *pTrack, G4Event *pEvent);
+	void GeneratePrimaryVertexFromDecay(G4ParticleDefinition *pDefinition, const G4ThreeVector &hPosition,
+		const G4ThreeVector &hMomentum, G4double dTime, G4Event *pEvent);
 
 	void SetPosDisType(G4String hSourcePosType) { m_hSourcePosType = hSourcePosType; }
 	void SetPosDisShape(G4String hShape) { m_hShape = hShape; }
 	void SetCenterCoords(G4ThreeVector hCenterCoords) { m_hCenterCoords = hCenterCoords; }
 	void SetHalfZ(G4double dHalfz) { m_dHalfz = dHalfz; }
 	void SetRadius(G4double dRadius) { m_dRadius = dRadius; }
+	void SetFluxTarget(G4double dRadius, G4double dHalfz) { m_dFluxTargetRadius = dRadius; m_dFluxTargetHalfz = dHalfz; }
+	void SetSurfaceDepth(G4String hSurfaceDepthType, G4double dSurfaceDepth) { m_hSurfaceDepthType = hSurfaceDepthType; m_dSurfaceDepth = dSurfaceDepth; }
+	void SetSurfaceDirection(G4String hSurfaceDirection) { m_hSurfaceDirection = hSurfaceDirection; }
+	void SetEventFile(G4String hEventFile, G4String hFormat);
+	void SetEventFilePartition(G4int iIndex, G4int iNbPartitions);
+	void SetEventFileOffset(G4ThreeVector hOffset);
+	void SetBatchSize(G4int iBatchSize) { m_iBatchSize = iBatchSize; ClearBatch(); }
+	void ClearBatch();
+	// primaries of the batch not generated yet, kept by a checkpoint for the resumed run
+	G4bool HasBatchLeft() const { return m_iBatchIndex < (G4int) m_hBatchX.size(); }
+	G4bool WriteBatch(const G4String &hFilename) const;
+	G4bool ReadBatch(const G4String &hFilename);
 
 	void SetAngDistType(G4String hAngDistType) { m_hAngDistType = hAngDistType; }
 	void SetParticleMomentumDirection(G4ParticleMomentum hMomentum) { m_hParticleMomentumDirection = hMomentum.unit(); }
@@ -45,11 +65,25 @@ public:
 	const G4String &GetParticleType() { return m_pParticleDefinition->GetParticleName(); }
 	const G4double GetParticleEnergy() { return m_dParticleEnergy; }
 	const G4ThreeVector &GetParticlePosition() { return m_hParticlePosition; }
+	const G4String &GetPosDisType() { return m_hSourcePosType; }
+	G4double GetEventWeight() { return m_dEventWeight; }
+	DARWINEventFileReader *GetEventFileReader() { return m_pEventFileReader; }
+
+	G4double GetSurfaceFluxArea();
+	G4long GetNbSurfaceFluxTried() { return m_lFluxTried; }
+	G4long GetNbSurfaceFluxAccepted() { return m_lFluxAccepted; }
+	void ResetSurfaceFluxCounters() { m_lFluxTried = 0; m_lFluxAccepted = 0; }
 
 	G4bool ReadEnergySpectrum();
 	void GeneratePointSource();
 	void GeneratePointsInVolume();
 	G4bool IsSourceConfined();
+	G4int GeneratePosition();
+	void TimeSampling(G4int iNbPositions);
+
+	G4bool IsBatchable();
+	void FillBatch();
+	void GenerateFromBatch();
 	void ConfineSourceToVolume(G4String);
 
 	void GenerateIsotropicFlux();
@@ -58,6 +92,10 @@ public:
 	void GenerateEnergyFromSpectrum();
 
 	void SetRandomSpherePos();
+	void GenerateSurfaceFlux();
+	void GeneratePointsOnSurface();
+	void GeneratePrimaryVertexFromFile(G4Event *pEvent);
+	G4bool IsAimedAtFluxTarget(const G4ThreeVector &hPosition, const G4ThreeVector &hDirection);
 
 private:
 	G4String m_hSourcePosType;
@@ -65,8 +103,28 @@ private:
 	G4ThreeVector m_hCenterCoords;
 	G4double m_dHalfz;
 	G4double m_dRadius;
+	G4double m_dFluxTargetRadius;
+	G4double m_dFluxTargetHalfz;
+	G4long m_lFluxTried;
+	G4long m_lFluxAccepted;
+	G4String m_hSurfaceDepthType;
+	G4double m_dSurfaceDepth;
+	G4String m_hSurfaceDirection;
+	DARWINSurfaceSampler *m_pSurfaceSampler;
+	DARWINEventFileReader *m_pEventFileReader;
+
+	// batch mode, blocks of positions, directions and energies generated at once
+	G4int m_iBatchSize;
+	G4int m_iBatchIndex;
+	vector<G4double> m_hBatchX, m_hBatchY, m_hBatchZ;
+	vector<G4double> m_hBatchDx, m_hBatchDy, m_hBatchDz;
+	vector<G4double> m_hBatchEnergies;
+	vector<G4double> m_hRandoms;
+	vector<G4double> m_hEnergyCdf;
+	G4double m_dEventWeight;
 	G4bool m_bConfine;
 	set<G4String> m_hVolumeNames;
+	DARWINVolumeSet m_hConfineVolumes;
 	G4String m_hAngDistType;
 	G4double m_dMinTheta, m_dMaxTheta, m_dMinPhi, m_dMaxPhi;
 	G4double m_dTheta, m_dPhi;
@@ -88,6 +146,7 @@ private:
 
 	DARWINParticleSourceMessenger *m_pMessenger;
 	G4Navigator *m_pNavigator;
+	G4Navigator *m_pConfineNavigator;
 };
 
 #endif // __XENON10PPARTICLESOURCE_H__
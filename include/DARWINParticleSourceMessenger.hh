@@ -38,11 +38,19 @@ private:
      G4UIcmdWith3VectorAndUnit  *m_pCenterCmd;
      G4UIcmdWithADoubleAndUnit  *m_pHalfzCmd;
      G4UIcmdWithADoubleAndUnit  *m_pRadiusCmd;
+     G4UIcommand                *m_pFluxTargetCmd;
+     G4UIcommand                *m_pSurfaceDepthCmd;
+     G4UIcmdWithAString         *m_pSurfaceDirectionCmd;
+     G4UIcommand                *m_pEventFileCmd;
+     G4UIcommand                *m_pEventFilePartitionCmd;
+     G4UIcmdWith3VectorAndUnit  *m_pEventFileOffsetCmd;
      G4UIcmdWithAString         *m_pConfineCmd;         
      G4UIcmdWithAString         *m_pAngTypeCmd;
      G4UIcmdWithAString         *m_pEnergyTypeCmd;
      G4UIcmdWithAString         *m_pEnergyFileCmd;
      G4UIcmdWithAnInteger       *m_pVerbosityCmd;
+     G4UIcmdWithAnInteger       *m_pTimeSamplingCmd;
+     G4UIcmdWithAnInteger       *m_pBatchSizeCmd;
      G4UIcommand                *m_pIonCmd;
      G4UIcmdWithAString         *m_pParticleCmd;
      G4UIcmdWith3VectorAndUnit  *m_pPositionCmd;
@@ -0,0 +1,42 @@
+#ifndef __DARWINPHYSICSLIST_H__
+#define __DARWINPHYSICSLIST_H__
+
+#include <G4VModularPhysicsList.hh>
+#include <globals.hh>
+
+class DARWINPhysicsListMessenger;
+
+class DARWINPhysicsList: public G4VModularPhysicsList
+{
+public:
+	DARWINPhysicsList(const G4String &hList = "QGSP_BERT_HP");
+	~DARWINPhysicsList();
+
+public:
+	void ConstructParticle();
+
+	G4bool SetList(const G4String &hList);
+	void SetOpticalPhysics(G4bool bOpticalPhysics) { m_bOpticalPhysics = bOpticalPhysics; }
+	void SetRadioactiveDecay(G4bool bRadioactiveDecay) { m_bRadioactiveDecay = bRadioactiveDecay; }
+
+	const G4String &GetList() const { return m_hList; }
+	G4bool GetOpticalPhysics() const { return m_bOpticalPhysics; }
+	G4bool GetRadioactiveDecay() const { return m_bRadioactiveDecay; }
+	G4bool IsBuilt() const { return m_bBuilt; }
+
+	static G4String GetAvailableLists() { return "EM QGSP_BERT_HP Shielding"; }
+
+private:
+	void RegisterConstructors();
+
+private:
+	G4String m_hList;
+	G4bool m_bOpticalPhysics;
+	G4bool m_bRadioactiveDecay;
+	G4bool m_bBuilt;
+
+	DARWINPhysicsListMessenger *m_pMessenger;
+};
+
+#endif // __DARWINPHYSICSLIST_H__
+
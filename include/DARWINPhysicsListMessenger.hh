@@ -0,0 +1,33 @@
+#ifndef __DARWINPHYSICSLISTMESSENGER_H__
+#define __DARWINPHYSICSLISTMESSENGER_H__
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class DARWINPhysicsList;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+
+class DARWINPhysicsListMessenger: public G4UImessenger
+{
+public:
+	DARWINPhysicsListMessenger(DARWINPhysicsList *pPhysicsList);
+	~DARWINPhysicsListMessenger();
+
+	void SetNewValue(G4UIcommand *pUIcommand, G4String hString);
+
+private:
+	DARWINPhysicsList *m_pPhysicsList;
+
+	G4UIdirectory *m_pPhysicsDir;
+
+	G4UIcmdWithAString *m_pListCmd;
+	G4UIcmdWithABool *m_pOpticalPhysicsCmd;
+	G4UIcmdWithABool *m_pRadioactiveDecayCmd;
+};
+
+#endif // __DARWINPHYSICSLISTMESSENGER_H__
+
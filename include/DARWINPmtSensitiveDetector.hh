@@ -3,8 +3,12 @@
 
 #include <G4VSensitiveDetector.hh>
 
+#include <vector>
+
 #include "DARWINPmtHit.hh"
 
+using std::vector;
+
 class G4Step;
 class G4HCofThisEvent;
 
@@ -18,8 +22,40 @@ public:
 	G4bool ProcessHits(G4Step *pStep, G4TouchableHistory *pHistory);
 	void EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent);
 
+public:
+	// photon timing per pmt: the iNbFirstTimes earliest photon times in units of
+	// dResolution, or a histogram of iNbBins bins of width dBinWidth, both counted
+	// from the first photon of the event (global times of decays reach years)
+	enum TimingMode { kNoTiming, kFirstTimes, kTimeHistogram };
+
+	void SetTiming(TimingMode iMode, G4int iNbPmts, G4int iNbFirstTimes, G4double dResolution, G4double dBinWidth, G4int iNbBins);
+
+	// pmts with photons (sorted), number of packed values and the values of each of them
+	void GetPackedTiming(vector<int> *pPmtIds, vector<unsigned short> *pNbValues, vector<unsigned short> *pValues);
+	// global time of the first timed photon of the event, 0 without photons
+	G4double GetFirstPhotonTime() const { return (m_hTimedPmts.empty())?(0.):(m_dFirstPhotonTime); }
+
+private:
+	void AddPhotonTime(G4int iPmtNb, G4double dTime);
+
 private:
 	DARWINPmtHitsCollection* m_pPmtHitsCollection;
+
+	TimingMode m_iTimingMode;
+	G4int m_iNbFirstTimes;
+	G4double m_dResolution;
+	G4double m_dBinWidth;
+	G4int m_iNbBins;
+
+	vector<G4int> m_hTimedPmts;
+	vector<G4int> m_hNbTimes;
+	vector<G4double> m_hFirstTimes;
+	vector<unsigned short> m_hTimeBins;
+
+	// histogram mode: the photons of the event, binned by GetPackedTiming
+	G4double m_dFirstPhotonTime;
+	vector<G4int> m_hPhotonPmts;
+	vector<G4double> m_hPhotonTimes;
 };
 
 #endif // __XENON10PPMTSENSITIVEDETECTOR_H__
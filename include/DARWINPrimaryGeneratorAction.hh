@@ -6,6 +6,7 @@
 #include <globals.hh>
 
 class DARWINParticleSource;
+class DARWINStackingAction;
 
 class G4Event;
 
@@ -20,6 +21,15 @@ public:
 	const G4String &GetParticleTypeOfPrimary() { return m_hParticleTypeOfPrimary; }
 	G4double GetEnergyOfPrimary() { return m_dEnergyOfPrimary; }
 	G4ThreeVector GetPositionOfPrimary() { return m_hPositionOfPrimary; }
+	G4double GetEventWeight() { return m_dEventWeight; }
+	G4int GetChainId() { return m_iChainId; }
+	G4double GetChainTime() { return m_dChainTime; }
+	void SetChainId(G4int iChainId) { m_iChainId = iChainId; }
+	// decay products still to be generated in later events
+	G4bool IsInChain();
+	DARWINParticleSource *GetParticleSource() { return m_pParticleSource; }
+
+	void SetStackingAction(DARWINStackingAction *pStackingAction) { m_pStackingAction = pStackingAction; }
 
 	void GeneratePrimaries(G4Event *pEvent);
 
@@ -28,8 +38,15 @@ public:
 	G4String m_hParticleTypeOfPrimary;
 	G4double m_dEnergyOfPrimary;
 	G4ThreeVector m_hPositionOfPrimary;
+	G4double m_dEventWeight;
+
+	// decay chain the event belongs to and time of the decay that started the event
+	// since the first decay of the chain
+	G4int m_iChainId;
+	G4double m_dChainTime;
 
 	DARWINParticleSource *m_pParticleSource;
+	DARWINStackingAction *m_pStackingAction;
 };
 
 #endif // __XENON10PPRIMARYGENERATORACTION_H__
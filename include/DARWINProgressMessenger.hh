@@ -0,0 +1,32 @@
+#ifndef __DARWINPROGRESSMESSENGER_H__
+#define __DARWINPROGRESSMESSENGER_H__
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class DARWINProgressReporter;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+
+class DARWINProgressMessenger: public G4UImessenger
+{
+public:
+	DARWINProgressMessenger(DARWINProgressReporter *pProgressReporter);
+	~DARWINProgressMessenger();
+
+	void SetNewValue(G4UIcommand *pUIcommand, G4String hString);
+
+private:
+	DARWINProgressReporter *m_pProgressReporter;
+
+	G4UIdirectory *m_pProgressDir;
+
+	G4UIcmdWithADoubleAndUnit *m_pIntervalCmd;
+	G4UIcmdWithAString *m_pStatusFileCmd;
+};
+
+#endif // __DARWINPROGRESSMESSENGER_H__
+
@@ -0,0 +1,53 @@
+#ifndef __DARWINPROGRESSREPORTER_H__
+#define __DARWINPROGRESSREPORTER_H__
+
+#include <globals.hh>
+
+class G4Event;
+
+class DARWINAnalysisManager;
+class DARWINProgressMessenger;
+
+// prints the number of events done, the event rate, the ETA and the memory
+// usage at a fixed wall time interval, optionally also to a status file
+class DARWINProgressReporter
+{
+public:
+	DARWINProgressReporter(DARWINAnalysisManager *pAnalysisManager = 0);
+	~DARWINProgressReporter();
+
+public:
+	void BeginOfRun(G4int iNbEventsToProcess);
+	void EndOfEvent(const G4Event *pEvent);
+	void EndOfRun();
+
+	void SetInterval(G4double dInterval) { m_dInterval = dInterval; }
+	void SetStatusFilename(const G4String &hFilename) { m_hStatusFilename = hFilename; }
+
+private:
+	void Report(G4double dTime, G4bool bFinal);
+	void WriteStatusFile(G4double dTime, G4double dInstantRate, G4double dAverageRate, G4double dEta, G4double dRss, G4bool bFinal);
+
+	static G4double GetWallTime();
+	static G4double GetResidentMemory();
+	static G4String FormatDuration(G4double dSeconds);
+
+private:
+	DARWINAnalysisManager *m_pAnalysisManager;
+
+	G4double m_dInterval;
+	G4String m_hStatusFilename;
+
+	G4int m_iNbEventsToProcess;
+	G4int m_iNbEventsDone;
+
+	G4double m_dStartTime;
+	G4double m_dNextReportTime;
+	G4double m_dLastReportTime;
+	G4int m_iLastReportEvents;
+
+	DARWINProgressMessenger *m_pMessenger;
+};
+
+#endif // __DARWINPROGRESSREPORTER_H__
+
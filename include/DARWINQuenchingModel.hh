@@ -0,0 +1,31 @@
+#ifndef __DARWINQUENCHINGMODEL_H__
+#define __DARWINQUENCHINGMODEL_H__
+
+#include <globals.hh>
+
+// electron equivalent energy of nuclear recoils in xenon, the Lindhard model
+// with a settable k (0.166 by default), electronic recoils are not quenched
+class DARWINQuenchingModel
+{
+public:
+	DARWINQuenchingModel();
+	~DARWINQuenchingModel();
+
+public:
+	// Lindhard or None
+	G4bool SetModel(const G4String &hModel);
+	void SetLindhardK(G4double dLindhardK) { m_dLindhardK = dLindhardK; }
+
+	const G4String &GetModel() const { return m_hModel; }
+	G4double GetLindhardK() const { return m_dLindhardK; }
+
+	G4double GetQuenchingFactor(G4double dRecoilEnergy) const;
+	G4double GetElectronEquivalentEnergy(G4double dNrEnergy, G4double dErEnergy) const
+	{ return dErEnergy+GetQuenchingFactor(dNrEnergy)*dNrEnergy; }
+
+private:
+	G4String m_hModel;
+	G4double m_dLindhardK;
+};
+
+#endif // __DARWINQUENCHINGMODEL_H__
@@ -0,0 +1,43 @@
+#ifndef __DARWINROOTOUTPUT_H__
+#define __DARWINROOTOUTPUT_H__
+
+#include "DARWINOutputBackend.hh"
+
+class TFile;
+class TTree;
+
+class DARWINOutputSettings;
+
+// writes the events to the t1 tree (see readme/t1_structure.txt), the branches
+// point to the event data given here
+class DARWINRootOutput: public DARWINOutputBackend
+{
+public:
+	DARWINRootOutput(TFile *pFile, DARWINEventData *pEventData, const DARWINOutputSettings *pOutputSettings, const DARWINOutputColumns &hColumns);
+	~DARWINRootOutput();
+
+public:
+	// the tree goes to the file of the chunk, already open with the run-level objects
+	G4bool Open(const G4String &hFilename);
+	void WriteEvent(const DARWINEventData *pEventData);
+	void Flush();
+	// the tree is written and deleted with its file, closed after this
+	void Close();
+
+	G4String GetExtension() const { return ".root"; }
+	G4long GetBytesWritten() const;
+
+private:
+	void BookTree();
+
+private:
+	TFile *m_pFile;
+	TTree *m_pTree;
+
+	DARWINEventData *m_pEventData;
+	const DARWINOutputSettings *m_pOutputSettings;
+	DARWINOutputColumns m_hColumns;
+};
+
+#endif // __DARWINROOTOUTPUT_H__
+
@@ -1,11 +1,15 @@
 #ifndef __XENON10PRUNACTION_H__
 #define __XENON10PRUNACTION_H__
 
+#include <globals.hh>
 #include <G4UserRunAction.hh>
 
+#include <csignal>
+
 class G4Run;
 
 class DARWINAnalysisManager;
+class DARWINProgressReporter;
 
 class DARWINRunAction: public G4UserRunAction
 {
@@ -17,8 +21,28 @@ public:
 	void BeginOfRunAction(const G4Run *pRun);
 	void EndOfRunAction(const G4Run *pRun);
 
+	void SetRandomSeed(long lSeed) { m_lSeed = lSeed; m_bFixedSeed = true; }
+
+	// started and ended with each run, the event action reports the events to it
+	DARWINProgressReporter *GetProgressReporter() const { return m_pProgressReporter; }
+
+	// SIGTERM or SIGINT received during the run, the event action aborts the run
+	// after the current event, a second signal terminates the job at once
+	static G4int GetPendingSignal() { return m_iPendingSignal; }
+
+private:
+	static void HandleSignal(G4int iSignal);
+
 private:
 	DARWINAnalysisManager *m_pAnalysisManager;
+	DARWINProgressReporter *m_pProgressReporter;
+
+	G4bool m_bFixedSeed;
+	long m_lSeed;
+
+	static volatile sig_atomic_t m_iPendingSignal;
+	struct sigaction m_hPreviousTermAction;
+	struct sigaction m_hPreviousIntAction;
 };
 
 #endif // __XENON10PRUNACTION_H__
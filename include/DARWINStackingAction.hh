@@ -3,11 +3,34 @@
 
 #include <globals.hh>
 #include <G4UserStackingAction.hh>
+#include <G4ThreeVector.hh>
+
+#include <map>
+#include <vector>
+#include <utility>
+
+using std::map;
+using std::vector;
+using std::pair;
+
+class G4ParticleDefinition;
 
 class DARWINAnalysisManager;
+class DARWINDistanceMap;
+class DARWINStackingActionMessenger;
 
 class DARWINStackingAction: public G4UserStackingAction
 {
+public:
+	// decay product kept for a later event (pileup mode)
+	struct PendingTrack
+	{
+		G4ParticleDefinition *pDefinition;
+		G4ThreeVector hPosition;
+		G4ThreeVector hMomentum;
+		G4double dTime;
+	};
+
 public:
 	DARWINStackingAction(DARWINAnalysisManager *pAnalysisManager=0);
 	~DARWINStackingAction();
@@ -16,8 +39,48 @@ public:
 	virtual void NewStage();
 	virtual void PrepareNewEvent();
 
+	void SetKillPolicy(G4bool bKillPolicy) { m_bKillPolicy = bKillPolicy; }
+	void AddKillThreshold(const G4String &hParticleName, G4double dDistance, G4double dEnergy);
+	void ClearKillThresholds() { m_hKillThresholds.clear(); }
+	void SetDistanceMapTarget(const G4String &hTargetName);
+	void SetDistanceMapVoxelSize(G4double dVoxelSize);
+	void ListKillThresholds();
+
+	void SetChainStop(G4int iZ, G4int iA) { m_iChainStopZ = iZ; m_iChainStopA = iA; }
+	void SetPileupWindow(G4double dPileupWindow) { m_dPileupWindow = dPileupWindow; }
+	G4double GetPileupWindow() const { return m_dPileupWindow; }
+
+	G4bool HasPendingTracks() const { return !m_hPendingTracks.empty(); }
+	G4double PopPendingTracks(vector<PendingTrack> &hTracks);
+
+private:
+	G4bool IsKilled(const G4Track *pTrack);
+	G4bool IsChainStop(const G4ParticleDefinition *pDefinition) const;
+	void BuildDistanceMap();
+
 private:
 	DARWINAnalysisManager *m_pAnalysisManager;
+
+	// kill policy: per particle, (distance to the target, energy) pairs sorted by
+	// distance, a new track is killed below the highest energy of the pairs
+	// whose distance is smaller than its own distance
+	G4bool m_bKillPolicy;
+	map<const G4ParticleDefinition *, vector<pair<G4double, G4double> > > m_hKillThresholds;
+
+	G4String m_hDistanceMapTarget;
+	G4double m_dDistanceMapVoxelSize;
+	DARWINDistanceMap *m_pDistanceMap;
+
+	// decay chains: nuclide (ground state) at which the chain is stopped and
+	// time window within which daughter decays are kept in the same event
+	G4int m_iChainStopZ;
+	G4int m_iChainStopA;
+	G4double m_dPileupWindow;
+	G4double m_dEventDecayTime;
+	G4double m_dNextEventDecayTime;
+	vector<PendingTrack> m_hPendingTracks;
+
+	DARWINStackingActionMessenger *m_pMessenger;
 };
 
 #endif // __XENON10PSTACKINGACTION_H__
@@ -0,0 +1,40 @@
+#ifndef __DARWINSTACKINGACTIONMESSENGER_H__
+#define __DARWINSTACKINGACTIONMESSENGER_H__
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class DARWINStackingAction;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+class DARWINStackingActionMessenger: public G4UImessenger
+{
+public:
+	DARWINStackingActionMessenger(DARWINStackingAction *pStackingAction);
+	~DARWINStackingActionMessenger();
+
+	void SetNewValue(G4UIcommand *pUIcommand, G4String hString);
+
+private:
+	DARWINStackingAction *m_pStackingAction;
+
+	G4UIdirectory *m_pStackDir;
+
+	G4UIcmdWithABool *m_pKillPolicyCmd;
+	G4UIcommand *m_pKillThresholdCmd;
+	G4UIcmdWithoutParameter *m_pClearKillThresholdsCmd;
+	G4UIcmdWithoutParameter *m_pListKillThresholdsCmd;
+	G4UIcmdWithAString *m_pDistanceMapTargetCmd;
+	G4UIcmdWithADoubleAndUnit *m_pDistanceMapVoxelSizeCmd;
+	G4UIcommand *m_pChainStopCmd;
+	G4UIcmdWithADoubleAndUnit *m_pPileupWindowCmd;
+};
+
+#endif // __DARWINSTACKINGACTIONMESSENGER_H__
+
@@ -0,0 +1,76 @@
+#ifndef __DARWINSTEPPROFILER_H__
+#define __DARWINSTEPPROFILER_H__
+
+#include <globals.hh>
+
+#include <map>
+
+using std::map;
+
+class G4Step;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+class TDirectory;
+
+// accumulates number of steps, track length and wall time spent per
+// (logical volume, particle, process) triplet, the time of a step is the
+// time elapsed since the previous step of the same event
+class DARWINStepProfiler
+{
+public:
+	DARWINStepProfiler();
+	~DARWINStepProfiler();
+
+public:
+	void Reset();
+	void BeginOfEvent();
+	void Step(const G4Step *pStep);
+
+	void PrintReport(G4int iNbEvents, G4int iNbEntries = 30) const;
+	void FillTree(TDirectory *pDirectory) const;
+
+private:
+	struct Key
+	{
+		const G4LogicalVolume *pVolume;
+		const G4ParticleDefinition *pParticle;
+		const G4VProcess *pProcess;
+
+		bool operator<(const Key &hOther) const
+		{
+			if(pVolume != hOther.pVolume) return pVolume < hOther.pVolume;
+			if(pParticle != hOther.pParticle) return pParticle < hOther.pParticle;
+			return pProcess < hOther.pProcess;
+		}
+	};
+
+	struct Counters
+	{
+		Counters(): lSteps(0), dLength(0.), dTime(0.) {}
+
+		G4long lSteps;
+		G4double dLength;
+		G4double dTime;
+	};
+
+	static G4double GetWallTime();
+	static G4String GetVolumeName(const Key &hKey);
+	static G4String GetParticleName(const Key &hKey);
+	static G4String GetProcessName(const Key &hKey);
+
+private:
+	map<Key, Counters> m_hCounters;
+
+	// last entry used, consecutive steps often share the key
+	Key m_hLastKey;
+	Counters *m_pLastCounters;
+
+	G4double m_dLastTime;
+	G4double m_dTotalTime;
+	G4long m_lTotalSteps;
+};
+
+#endif // __DARWINSTEPPROFILER_H__
+
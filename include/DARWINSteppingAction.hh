@@ -0,0 +1,22 @@
+#ifndef __DARWINSTEPPINGACTION_H__
+#define __DARWINSTEPPINGACTION_H__
+
+#include <globals.hh>
+#include <G4UserSteppingAction.hh>
+
+class DARWINAnalysisManager;
+
+class DARWINSteppingAction: public G4UserSteppingAction
+{
+public:
+	DARWINSteppingAction(DARWINAnalysisManager *pAnalysisManager=0);
+	~DARWINSteppingAction();
+  
+	void UserSteppingAction(const G4Step* pStep);
+
+private:
+	DARWINAnalysisManager *m_pAnalysisManager;
+};
+
+#endif // __DARWINSTEPPINGACTION_H__
+
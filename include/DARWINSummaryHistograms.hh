@@ -0,0 +1,67 @@
+#ifndef __DARWINSUMMARYHISTOGRAMS_H__
+#define __DARWINSUMMARYHISTOGRAMS_H__
+
+#include <globals.hh>
+
+#include <map>
+#include <vector>
+
+#include "DARWINClusterer.hh"
+
+using std::map;
+using std::vector;
+
+class TDirectory;
+class TH1D;
+class TH2D;
+
+// background budget histograms filled from the clusters of each event: energy
+// spectra in the fiducial volume by multiplicity, r^2-z maps and single
+// scatter spectra per volume of the primary vertex, all histograms are
+// additive so outputs of separate jobs merge with hadd
+class DARWINSummaryHistograms
+{
+public:
+	DARWINSummaryHistograms();
+	~DARWINSummaryHistograms();
+
+public:
+	// cylinder around the z axis
+	void SetFiducialVolume(G4double dRadius, G4double dZMin, G4double dZMax);
+	void SetEnergyBinning(G4int iNbBins, G4double dEnergyMin, G4double dEnergyMax);
+	// clusters below the threshold do not count for the multiplicity
+	void SetThreshold(G4double dThreshold) { m_dThreshold = dThreshold; }
+
+	G4bool HasFiducialVolume() const { return m_dFiducialRadius > 0.; }
+
+	void Book(G4double dMapRadius, G4double dMapZMin, G4double dMapZMax);
+	void Fill(const vector<DARWINClusterer::Cluster> &hClusters, const G4String &hSourceVolume, G4double dWeight);
+	void Write(TDirectory *pDirectory) const;
+	// empties the histograms for the next file, keeping the binning
+	void Reset();
+
+private:
+	void Delete();
+	G4bool IsInFiducialVolume(const G4ThreeVector &hPosition) const;
+
+private:
+	G4double m_dFiducialRadius;
+	G4double m_dFiducialZMin;
+	G4double m_dFiducialZMax;
+
+	G4int m_iNbEnergyBins;
+	G4double m_dEnergyMin;
+	G4double m_dEnergyMax;
+
+	G4double m_dThreshold;
+
+	TH1D *m_pEnergySS;
+	TH1D *m_pEnergyMS;
+	TH2D *m_pEnergyMultiplicity;
+	TH2D *m_pR2ZClusters;
+	TH2D *m_pR2ZSS;
+	map<G4String, TH1D *> m_hSourceVolumeSpectra;
+};
+
+#endif // __DARWINSUMMARYHISTOGRAMS_H__
+
@@ -0,0 +1,68 @@
+#ifndef __DARWINSURFACESAMPLER_H__
+#define __DARWINSURFACESAMPLER_H__
+
+#include <globals.hh>
+#include <G4ThreeVector.hh>
+#include <G4AffineTransform.hh>
+
+#include <vector>
+#include <set>
+
+using std::vector;
+using std::set;
+
+class G4VPhysicalVolume;
+class G4VSolid;
+class G4Tubs;
+class G4Sphere;
+class G4Ellipsoid;
+
+// uniform points on the surfaces of a set of physical volumes, each placement
+// is weighted by its surface area, the sampling is exact for G4Tubs, G4Sphere
+// and G4Ellipsoid, other solids rely on G4VSolid::GetPointOnSurface()
+class DARWINSurfaceSampler
+{
+public:
+	DARWINSurfaceSampler();
+	~DARWINSurfaceSampler();
+
+public:
+	G4bool Build(G4VPhysicalVolume *pWorld, const set<G4String> &hVolumeNames);
+
+	G4bool IsBuilt() const { return !m_hSurfaces.empty(); }
+	G4double GetTotalArea() const { return (m_hCumulativeAreas.empty())?(0.):(m_hCumulativeAreas.back()); }
+
+	// global position and outward normal
+	void GeneratePoint(G4ThreeVector &hPosition, G4ThreeVector &hNormal) const;
+
+private:
+	enum SolidType { kTubs, kSphere, kEllipsoid, kOther };
+
+	struct Surface
+	{
+		SolidType iType;
+		G4VSolid *pSolid;
+		G4AffineTransform hTransform;
+		vector<G4double> hPieceAreas;
+	};
+
+	void Collect(G4VPhysicalVolume *pVolume, const set<G4String> &hVolumeNames, const G4AffineTransform &hTransform);
+
+	static void GetTubsPieceAreas(const G4Tubs *pTubs, vector<G4double> &hAreas);
+	static void GetSpherePieceAreas(const G4Sphere *pSphere, vector<G4double> &hAreas);
+	static void GetEllipsoidPieceAreas(const G4Ellipsoid *pEllipsoid, vector<G4double> &hAreas);
+
+	static void GeneratePointOnTubs(const G4Tubs *pTubs, G4int iPiece, G4ThreeVector &hPosition, G4ThreeVector &hNormal);
+	static void GeneratePointOnSphere(const G4Sphere *pSphere, G4int iPiece, G4ThreeVector &hPosition, G4ThreeVector &hNormal);
+	static void GeneratePointOnEllipsoid(const G4Ellipsoid *pEllipsoid, G4int iPiece, G4ThreeVector &hPosition, G4ThreeVector &hNormal);
+
+	static G4int SelectPiece(const vector<G4double> &hAreas);
+	static G4double GenerateRadius(G4double dRMin, G4double dRMax);
+
+private:
+	vector<Surface> m_hSurfaces;
+	vector<G4double> m_hCumulativeAreas;
+};
+
+#endif // __DARWINSURFACESAMPLER_H__
+
@@ -0,0 +1,68 @@
+#ifndef __DARWINVOLUMESET_H__
+#define __DARWINVOLUMESET_H__
+
+#include <globals.hh>
+
+#include <vector>
+#include <stdint.h>
+
+using std::vector;
+
+class G4VPhysicalVolume;
+
+// set of physical volume pointers with open addressing (linear probing), the
+// lookup is a hash and a few pointer compares, no string is built
+class DARWINVolumeSet
+{
+public:
+	DARWINVolumeSet();
+	~DARWINVolumeSet();
+
+public:
+	void Clear();
+	void Insert(const G4VPhysicalVolume *pVolume);
+
+	G4int GetSize() const { return m_iSize; }
+	G4bool IsEmpty() const { return m_iSize == 0; }
+
+	inline G4bool Contains(const G4VPhysicalVolume *pVolume) const;
+
+private:
+	static inline size_t Hash(const G4VPhysicalVolume *pVolume);
+
+	void Resize(size_t lNbSlots);
+
+private:
+	vector<const G4VPhysicalVolume *> m_hSlots;
+	size_t m_lMask;
+	G4int m_iSize;
+};
+
+inline size_t
+DARWINVolumeSet::Hash(const G4VPhysicalVolume *pVolume)
+{
+	// pointers are aligned, mix the bits before masking
+	uint64_t lKey = (uint64_t) (uintptr_t) pVolume;
+
+	lKey ^= lKey >> 33;
+	lKey *= 0xff51afd7ed558ccdULL;
+	lKey ^= lKey >> 33;
+
+	return (size_t) lKey;
+}
+
+inline G4bool
+DARWINVolumeSet::Contains(const G4VPhysicalVolume *pVolume) const
+{
+	if(!m_iSize || !pVolume)
+		return false;
+
+	for(size_t lSlot = Hash(pVolume) & m_lMask; m_hSlots[lSlot]; lSlot = (lSlot+1) & m_lMask)
+		if(m_hSlots[lSlot] == pVolume)
+			return true;
+
+	return false;
+}
+
+#endif // __DARWINVOLUMESET_H__
+
@@ -2,19 +2,48 @@
 #include <G4Run.hh>
 #include <G4Event.hh>
 #include <G4HCofThisEvent.hh>
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4Region.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <Randomize.hh>
 
 #include <numeric>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
 
 #include <TROOT.h>
 #include <TFile.h>
-#include <TTree.h>
 #include <TParameter.h>
+#include <TNamed.h>
 
 #include "DARWINDetectorConstruction.hh"
 #include "DARWINLXeHit.hh"
+#include "DARWINLXeSensitiveDetector.hh"
 #include "DARWINPmtHit.hh"
+#include "DARWINPmtSensitiveDetector.hh"
 #include "DARWINPrimaryGeneratorAction.hh"
+#include "DARWINParticleSource.hh"
 #include "DARWINEventData.hh"
+#include "DARWINAnalysisMessenger.hh"
+#include "DARWINStepProfiler.hh"
+#include "DARWINClusterer.hh"
+#include "DARWINQuenchingModel.hh"
+#include "DARWINFastS2.hh"
+#include "DARWINCheckpoint.hh"
+#include "DARWINEventFileReader.hh"
+#include "DARWINSummaryHistograms.hh"
+#include "DARWINOutputSettings.hh"
+#include "DARWINRootOutput.hh"
+#include "DARWINColumnarOutput.hh"
 
 #include "DARWINAnalysisManager.hh"
 
@@ -25,61 +54,374 @@ DARWINAnalysisManager::DARWINAnalysisManager(DARWINPrimaryGeneratorAction *pPrim
 
 	m_hDataFilename = "events.root";
 
+	m_iNbEventsToSimulate = 0;
+	m_iNbEventsWritten = 0;
+
 	m_pPrimaryGeneratorAction = pPrimaryGeneratorAction;
 
 	m_pEventData = new DARWINEventData();
+
+	m_bSparsePmtHits = false;
+	m_bPmtHitTimes = false;
+	m_iNbTopPmts = 0;
+	m_iNbBottomPmts = 0;
+	m_iNbLSPmts = 0;
+	m_iNbWaterPmts = 0;
+
+	m_hPmtTiming = "None";
+	m_iNbPmtFirstTimes = 10;
+	m_dPmtTimeResolution = 1.*ns;
+	m_dPmtTimeBinWidth = 10.*ns;
+	m_dPmtTimeWindow = 1.*microsecond;
+	m_pPmtSensitiveDetector = 0;
+
+	m_hOutputMode = "Full";
+	m_pTreeFile = 0;
+
+	m_iMaxEventsPerFile = 0;
+	m_lMaxFileSize = 0;
+	m_iFileNumber = 0;
+	m_iNbEventsInFile = 0;
+	m_iNbEventsWrittenInFile = 0;
+	m_iFirstEventIdInFile = -1;
+	m_iLastEventIdInFile = -1;
+
+	m_pCheckpoint = new DARWINCheckpoint();
+	m_iEventIdOffset = 0;
+	m_bResumePending = false;
+
+	m_pClusterer = new DARWINClusterer();
+	m_pSummaryHistograms = new DARWINSummaryHistograms();
+	m_pSummaryNavigator = 0;
+
+	m_bRecoilClusters = false;
+	m_pQuenchingModel = new DARWINQuenchingModel();
+
+	m_pFastS2 = new DARWINFastS2();
+	m_bFastS2 = false;
+
+	m_pOutputSettings = new DARWINOutputSettings();
+
+	m_hOutputFormat = "root";
+
+	m_hOutputLayout = "Steps";
+	m_pLXeSensitiveDetector = 0;
+
+	m_bRegionStepReport = false;
+	m_pLastRegion = 0;
+	m_pLastRegionSteps = 0;
+
+	m_pStepProfiler = 0;
+
+	m_pAnalysisMessenger = new DARWINAnalysisMessenger(this);
 }
 
 DARWINAnalysisManager::~DARWINAnalysisManager()
 {
+	delete m_pStepProfiler;
+	delete m_pSummaryNavigator;
+	delete m_pSummaryHistograms;
+	delete m_pClusterer;
+	delete m_pQuenchingModel;
+	delete m_pFastS2;
+	delete m_pCheckpoint;
+	delete m_pOutputSettings;
+	delete m_pAnalysisMessenger;
 }
 
 void
-DARWINAnalysisManager::BeginOfRun(const G4Run *pRun)
+DARWINAnalysisManager::SetStepProfiling(G4bool bStepProfiling)
 {
-	m_pTreeFile = new TFile(m_hDataFilename.c_str(), "RECREATE", "File containing event data for DARWIN");
-	m_pTree = new TTree("t1", "Tree containing event data for DARWIN");
+	if(bStepProfiling && !m_pStepProfiler)
+		m_pStepProfiler = new DARWINStepProfiler();
+	else if(!bStepProfiling && m_pStepProfiler)
+	{
+		delete m_pStepProfiler;
+		m_pStepProfiler = 0;
+	}
+}
 
+void
+DARWINAnalysisManager::BeginOfRun(const G4Run *pRun)
+{
 	gROOT->ProcessLine("#include <vector>");
 
-	m_pTree->Branch("eventid", &m_pEventData->m_iEventId, "eventid/I");
-	m_pTree->Branch("ntpmthits", &m_pEventData->m_iNbTopPmtHits, "ntpmthits/I");
-	m_pTree->Branch("nbpmthits", &m_pEventData->m_iNbBottomPmtHits, "nbpmthits/I");
-	m_pTree->Branch("pmthits", "vector<int>", &m_pEventData->m_pPmtHits);
-	m_pTree->Branch("etot", &m_pEventData->m_fTotalEnergyDeposited, "etot/F");
-	m_pTree->Branch("nsteps", &m_pEventData->m_iNbSteps, "nsteps/I");
-	
-	m_pTree->Branch("trackid", "vector<int>", &m_pEventData->m_pTrackId);
-	m_pTree->Branch("type", "vector<string>", &m_pEventData->m_pParticleType);
-	m_pTree->Branch("parentid", "vector<int>", &m_pEventData->m_pParentId);
-	m_pTree->Branch("parenttype", "vector<string>", &m_pEventData->m_pParentType);
-	m_pTree->Branch("creaproc", "vector<string>", &m_pEventData->m_pCreatorProcess);
-	m_pTree->Branch("edproc", "vector<string>", &m_pEventData->m_pDepositingProcess);
-	m_pTree->Branch("xp", "vector<float>", &m_pEventData->m_pX);
-	m_pTree->Branch("yp", "vector<float>", &m_pEventData->m_pY);
-	m_pTree->Branch("zp", "vector<float>", &m_pEventData->m_pZ);
-	m_pTree->Branch("ed", "vector<float>", &m_pEventData->m_pEnergyDeposited);
-	m_pTree->Branch("time", "vector<float>", &m_pEventData->m_pTime);
+	// pmt array sizes, needed to rebuild pmthits from the sparse branches
+	m_iNbTopPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbTopPMTs");
+	m_iNbBottomPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbBottomPMTs");
+	m_iNbLSPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbLSPMTs");
+	m_iNbWaterPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbWaterPMTs");
+
+	m_hPmtHitCounts.assign(m_iNbTopPmts+m_iNbBottomPmts+m_iNbLSPmts+m_iNbWaterPmts, 0);
+	m_hPmtHitTimes.assign(m_iNbTopPmts+m_iNbBottomPmts+m_iNbLSPmts+m_iNbWaterPmts, DBL_MAX);
 
-	m_pTree->Branch("type_pri", "vector<string>", &m_pEventData->m_pPrimaryParticleType);
-	m_pTree->Branch("xp_pri", &m_pEventData->m_fPrimaryX, 	"xp_pri/F");
-	m_pTree->Branch("yp_pri", &m_pEventData->m_fPrimaryY, 	"yp_pri/F");
-	m_pTree->Branch("zp_pri", &m_pEventData->m_fPrimaryZ, 	"zp_pri/F");
-	m_pTree->Branch("e_pri",  &m_pEventData->m_fPrimaryE,	"e_pri/F");
+	m_bFastS2 = m_pFastS2->IsEnabled() && m_pFastS2->Initialize(m_iNbTopPmts);
 
-	// write everything to one file, do not switch
-	m_pTree->SetMaxTreeSize(10737418240LL); // 10G bytes, don't split file automatically
+	// the track table comes from the bookkeeping of the LXe sensitive detector
+	m_pLXeSensitiveDetector = 0;
+	if(m_hOutputLayout == "Tracks")
+	{
+		G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
+		m_pLXeSensitiveDetector = dynamic_cast<DARWINLXeSensitiveDetector *>(pSDManager->FindSensitiveDetector("DARWIN/LXeSD", false));
 
-	m_pNbEventsToSimulateParameter = new TParameter<int>("nbevents", m_iNbEventsToSimulate);
-	m_pNbEventsToSimulateParameter->Write();
+		if(!m_pLXeSensitiveDetector)
+		{
+			G4cout << "Error: no LXe sensitive detector, writing the Steps layout!" << G4endl;
+			m_hOutputLayout = "Steps";
+		}
+	}
 
+	// only the columns of the layout are reserved and cleared per event
+	m_pEventData->SetColumns(((m_pLXeSensitiveDetector)?(DARWINEventData::kTrackTableColumns):(DARWINEventData::kStepTrackColumns))
+		| ((m_bRecoilClusters)?(DARWINEventData::kRecoilColumns):(0)));
+
+	// chunks are listed in the index file as they are closed
+	m_iFileNumber = 0;
+	if(IsRotating())
+	{
+		G4String hIndexFilename = GetFilenameStem()+"_index.txt";
+
+		m_hIndexFile.open(hIndexFilename.c_str(), std::ios::out | std::ios::trunc);
+		m_hIndexFile << "# chunk\tfile\tfirst_eventid\tlast_eventid\tevents_simulated\tevents_written" << std::endl;
+	}
+
+	OpenDataFile();
+
+	// a resumed run keeps updating the record it was resumed from
+	if(m_pCheckpoint->IsEnabled())
+	{
+		if(m_hCheckpointFilename.empty())
+		{
+			m_hCheckpointFilename = GetFilenameStem()+".checkpoint";
+			m_pCheckpoint->m_hDataFilename = m_hDataFilename;
+			m_pCheckpoint->m_iNbResumes = 0;
+			m_pCheckpoint->m_hEngineStatusFilename = GetFilenameStem()+".rndm";
+		}
+
+		m_pCheckpoint->m_iNbEventsToSimulate = m_iEventIdOffset+pRun->GetNumberOfEventToBeProcessed();
+		m_pCheckpoint->BeginOfRun();
+	}
+
+	// the event file continues after the last record read before the checkpoint, the
+	// batch with the primaries left and the chain IDs after the last chain
+	DARWINParticleSource *pParticleSource = m_pPrimaryGeneratorAction->GetParticleSource();
+	DARWINEventFileReader *pEventFileReader = pParticleSource->GetEventFileReader();
+	if(m_bResumePending)
+	{
+		if(pEventFileReader->IsOpen() && m_pCheckpoint->m_lEventFilePosition >= 0)
+			pEventFileReader->SetPosition(m_pCheckpoint->m_lEventFilePosition, m_pCheckpoint->m_lNbEventFileRecords);
+
+		if(!m_pCheckpoint->m_hBatchFilename.empty())
+			pParticleSource->ReadBatch(m_pCheckpoint->m_hBatchFilename);
+
+		m_pPrimaryGeneratorAction->SetChainId(m_pCheckpoint->m_iChainId);
+	}
+
+	if(m_hOutputMode != "Full")
+		BookSummaryHistograms();
+
+	m_iNbEventsWritten = 0;
+
+	m_hKilledTracks.clear();
+
+	m_hRegionSteps.clear();
+	m_pLastRegion = 0;
+	m_pLastRegionSteps = 0;
+
+	if(m_pStepProfiler)
+		m_pStepProfiler->Reset();
+
+	m_pPrimaryGeneratorAction->GetParticleSource()->ResetSurfaceFluxCounters();
 }
 
 void
-DARWINAnalysisManager::EndOfRun(const G4Run *pRun)
+DARWINAnalysisManager::OpenDataFile()
+{
+	G4String hFilename = m_hDataFilename;
+	G4String hStem = GetFilenameStem();
+
+	if(IsRotating())
+	{
+		std::ostringstream hStream;
+		hStream << hStem << "_" << std::setw(4) << std::setfill('0') << m_iFileNumber;
+		hStem = hStream.str();
+		hFilename = hStem+".root";
+	}
+
+	m_pTreeFile = new TFile(hFilename.c_str(), "RECREATE", "File containing event data for DARWIN");
+	m_pOutputSettings->Apply(m_pTreeFile);
+	m_pPmtSensitiveDetector = 0;
+
+	// chunks get the number of events they contain when they are closed
+	if(!IsRotating())
+	{
+		m_pNbEventsToSimulateParameter = new TParameter<int>("nbevents", m_iNbEventsToSimulate);
+		m_pNbEventsToSimulateParameter->Write();
+	}
+
+	TParameter<int>("nbtoppmts", m_iNbTopPmts).Write();
+	TParameter<int>("nbbottompmts", m_iNbBottomPmts).Write();
+	TParameter<int>("nblspmts", m_iNbLSPmts).Write();
+	TParameter<int>("nbwaterpmts", m_iNbWaterPmts).Write();
+
+	TNamed("output_settings", m_pOutputSettings->GetDescription().c_str()).Write();
+
+	if(m_bRecoilClusters)
+	{
+		TNamed("quenching", m_pQuenchingModel->GetModel().c_str()).Write();
+		if(m_pQuenchingModel->GetModel() == "Lindhard")
+			TParameter<double>("lindhardk", m_pQuenchingModel->GetLindhardK()).Write();
+	}
+
+	// event tree and columnar events, not written in summary mode
+	if(m_hOutputMode != "Summary")
+	{
+		DARWINOutputColumns hColumns;
+		hColumns.bSparsePmtHits = m_bSparsePmtHits;
+		hColumns.bPmtHitTimes = m_bPmtHitTimes;
+		hColumns.bPmtTiming = SetupPmtTiming();
+		hColumns.bTrackTable = (m_hOutputLayout == "Tracks");
+		hColumns.bRecoilClusters = m_bRecoilClusters;
+		hColumns.bFastS2 = m_bFastS2;
+
+		if(m_hOutputFormat != "columnar")
+			m_hOutputBackends.push_back(new DARWINRootOutput(m_pTreeFile, m_pEventData, m_pOutputSettings, hColumns));
+		if(m_hOutputFormat != "root")
+			m_hOutputBackends.push_back(new DARWINColumnarOutput(hColumns));
+
+		for(vector<DARWINOutputBackend *>::iterator pIt = m_hOutputBackends.begin(); pIt != m_hOutputBackends.end(); )
+		{
+			if((*pIt)->Open(hStem+(*pIt)->GetExtension()))
+				pIt++;
+			else
+			{
+				delete *pIt;
+				pIt = m_hOutputBackends.erase(pIt);
+			}
+		}
+	}
+
+	m_iNbEventsInFile = 0;
+	m_iNbEventsWrittenInFile = 0;
+	m_iFirstEventIdInFile = -1;
+	m_iLastEventIdInFile = -1;
+}
+
+void
+DARWINAnalysisManager::CloseDataFile()
 {
+	// the t1 tree is written with the file
+	for(vector<DARWINOutputBackend *>::iterator pIt = m_hOutputBackends.begin(); pIt != m_hOutputBackends.end(); pIt++)
+	{
+		(*pIt)->Close();
+		delete *pIt;
+	}
+	m_hOutputBackends.clear();
+
+	m_pTreeFile->cd();
+
+	// the summary histograms of the events in this file, they add up over the chunks
+	if(m_hOutputMode != "Full")
+	{
+		m_pSummaryHistograms->Write(m_pTreeFile);
+		m_pSummaryHistograms->Reset();
+	}
+
+	// the events actually simulated in the file, fewer than requested if the run was aborted
+	TParameter<int>("nbevents", m_iNbEventsInFile).Write(0, TObject::kOverwrite);
+
+	if(IsRotating())
+		m_hIndexFile << m_iFileNumber << "\t" << m_pTreeFile->GetName() << "\t" << m_iFirstEventIdInFile << "\t" << m_iLastEventIdInFile
+			<< "\t" << m_iNbEventsInFile << "\t" << m_iNbEventsWrittenInFile << std::endl;
+
 	m_pTreeFile->Write();
 	m_pTreeFile->Close();
+
+	delete m_pTreeFile;
+	m_pTreeFile = 0;
+}
+
+void
+DARWINAnalysisManager::RotateDataFile()
+{
+	G4cout << "----> Closing " << m_pTreeFile->GetName() << " after " << m_iNbEventsInFile << " events" << G4endl;
+
+	CloseDataFile();
+
+	m_iFileNumber++;
+	OpenDataFile();
+}
+
+G4String
+DARWINAnalysisManager::GetFilenameStem() const
+{
+	G4String hStem = m_hDataFilename;
+
+	if(hStem.size() > 5 && hStem.substr(hStem.size()-5) == ".root")
+		hStem = hStem.substr(0, hStem.size()-5);
+
+	return hStem;
+}
+
+void
+DARWINAnalysisManager::BookSummaryHistograms()
+{
+	// default fiducial volume from the geometry, centered on the tpc as placed
+	G4double dTPCCenterZ = DARWINDetectorConstruction::GetGeometryParameter("TPCCenterZ");
+
+	if(!m_pSummaryHistograms->HasFiducialVolume())
+	{
+		G4double dFiducialRadius = DARWINDetectorConstruction::GetGeometryParameter("FiducialRadius");
+		G4double dFiducialDriftLength = DARWINDetectorConstruction::GetGeometryParameter("FiducialDriftLength");
+
+		m_pSummaryHistograms->SetFiducialVolume(dFiducialRadius, dTPCCenterZ-0.5*dFiducialDriftLength, dTPCCenterZ+0.5*dFiducialDriftLength);
+	}
+
+	G4double dTPCOuterRadius = DARWINDetectorConstruction::GetGeometryParameter("TPCOuterRadius");
+	G4double dTPCHeight = DARWINDetectorConstruction::GetGeometryParameter("TPCHeight");
+
+	m_pSummaryHistograms->Book(dTPCOuterRadius, dTPCCenterZ-0.5*dTPCHeight, dTPCCenterZ+0.5*dTPCHeight);
+}
+
+void
+DARWINAnalysisManager::EndOfRun(const G4Run *pRun)
+{
+	if(m_bRegionStepReport)
+		PrintRegionStepReport(pRun);
+
+	if(!m_hKilledTracks.empty())
+		WriteKilledTracksSummary(pRun);
+
+	if(m_pPrimaryGeneratorAction->GetParticleSource()->GetPosDisType() == "SurfaceFlux")
+		WriteSurfaceFluxSummary();
+
+	if(m_pStepProfiler)
+	{
+		m_pStepProfiler->PrintReport(pRun->GetNumberOfEvent());
+		m_pStepProfiler->FillTree(m_pTreeFile);
+	}
+
+	// a run aborted by a signal keeps the events done, with a checkpoint to resume it from
+	if(pRun->GetNumberOfEvent() < pRun->GetNumberOfEventToBeProcessed())
+	{
+		G4cout << "----> Run aborted after " << pRun->GetNumberOfEvent() << " of " << pRun->GetNumberOfEventToBeProcessed() << " events" << G4endl;
+
+		m_pTreeFile->cd();
+		TParameter<int>("nbevents_requested", pRun->GetNumberOfEventToBeProcessed()).Write();
+
+		if(m_pCheckpoint->IsEnabled() && m_iLastEventIdInFile >= 0)
+		{
+			if(!m_pPrimaryGeneratorAction->IsInChain())
+				WriteCheckpoint(m_iLastEventIdInFile);
+			else
+				G4cout << "----> Decay chain in progress, the run resumes from the previous checkpoint" << G4endl;
+		}
+	}
+
+	CloseDataFile();
+
+	if(m_hIndexFile.is_open())
+		m_hIndexFile.close();
 }
 
 void
@@ -96,6 +438,18 @@ DARWINAnalysisManager::BeginOfEvent(const G4Event *pEvent)
 		G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
 		m_iPmtHitsCollectionID = pSDManager->GetCollectionID("PmtHitsCollection");
 	}
+
+	// start a new chunk once the current one is full, the size of its first file
+	if(!m_hOutputBackends.empty() && m_iNbEventsInFile > 0)
+	{
+		G4long lFileSize = m_hOutputBackends.front()->GetBytesWritten();
+
+		if((m_iMaxEventsPerFile > 0 && m_iNbEventsInFile >= m_iMaxEventsPerFile) || (m_lMaxFileSize > 0 && lFileSize >= m_lMaxFileSize))
+			RotateDataFile();
+	}
+
+	if(m_pStepProfiler)
+		m_pStepProfiler->BeginOfEvent();
 }
 
 void
@@ -106,6 +460,11 @@ DARWINAnalysisManager::EndOfEvent(const G4Event *pEvent)
 	DARWINPmtHitsCollection* pPmtHitsCollection = 0;
 
 	G4int iNbLXeHits = 0, iNbPmtHits = 0;
+
+	if(m_iFirstEventIdInFile < 0)
+		m_iFirstEventIdInFile = pEvent->GetEventID()+m_iEventIdOffset;
+	m_iLastEventIdInFile = pEvent->GetEventID()+m_iEventIdOffset;
+	m_iNbEventsInFile++;
 	
 	if(pHCofThisEvent)
 	{
@@ -122,9 +481,20 @@ DARWINAnalysisManager::EndOfEvent(const G4Event *pEvent)
 		}
 	}
 
-	if(iNbLXeHits || iNbPmtHits)
+	// clustered once for the summary histograms, the recoil clusters and the S2
+	if(iNbLXeHits && (m_hOutputMode != "Full" || m_bRecoilClusters || m_bFastS2))
+		ClusterDeposits(pLXeHitsCollection, iNbLXeHits);
+
+	if(m_hOutputMode != "Full" && iNbLXeHits)
+		FillSummaryHistograms();
+
+	// summary mode has no event output, its checkpoints still have to be written
+	if(!m_hOutputBackends.empty() && (iNbLXeHits || iNbPmtHits))
 	{
-		m_pEventData->m_iEventId = pEvent->GetEventID();
+		m_pEventData->m_iEventId = pEvent->GetEventID()+m_iEventIdOffset;
+		m_pEventData->m_iChainId = m_pPrimaryGeneratorAction->GetChainId();
+		m_pEventData->m_dChainTime = m_pPrimaryGeneratorAction->GetChainTime()/ns;
+		m_pEventData->m_fWeight = m_pPrimaryGeneratorAction->GetEventWeight();
 
 		m_pEventData->m_pPrimaryParticleType->push_back(m_pPrimaryGeneratorAction->GetParticleTypeOfPrimary());
 
@@ -137,6 +507,11 @@ DARWINAnalysisManager::EndOfEvent(const G4Event *pEvent)
 		G4int iNbSteps = 0;
 		G4float fTotalEnergyDeposited = 0.;
 
+		if(m_pLXeSensitiveDetector)
+			FillTrackTable();
+
+		m_pEventData->ReserveSteps(iNbLXeHits);
+
 		// LXe hits
 		for(G4int i=0; i<iNbLXeHits; i++)
 		{
@@ -144,12 +519,17 @@ DARWINAnalysisManager::EndOfEvent(const G4Event *pEvent)
 
 			if(pHit->GetParticleType() != "opticalphoton")
 			{
-				m_pEventData->m_pTrackId->push_back(pHit->GetTrackId());
-				m_pEventData->m_pParentId->push_back(pHit->GetParentId());
-
-				m_pEventData->m_pParticleType->push_back(pHit->GetParticleType());
-				m_pEventData->m_pParentType->push_back(pHit->GetParentType());
-				m_pEventData->m_pCreatorProcess->push_back(pHit->GetCreatorProcess());
+				if(m_pLXeSensitiveDetector)
+					m_pEventData->m_pStepTrackIndex->push_back(m_hTrackTableIndices[pHit->GetTrackIndex()]);
+				else
+				{
+					m_pEventData->m_pTrackId->push_back(pHit->GetTrackId());
+					m_pEventData->m_pParentId->push_back(pHit->GetParentId());
+
+					m_pEventData->m_pParticleType->push_back(pHit->GetParticleType());
+					m_pEventData->m_pParentType->push_back(pHit->GetParentType());
+					m_pEventData->m_pCreatorProcess->push_back(pHit->GetCreatorProcess());
+				}
 				m_pEventData->m_pDepositingProcess->push_back(pHit->GetDepositingProcess());
 
 				m_pEventData->m_pX->push_back(pHit->GetPosition().x()/mm);
@@ -159,9 +539,11 @@ DARWINAnalysisManager::EndOfEvent(const G4Event *pEvent)
 				fTotalEnergyDeposited += pHit->GetEnergyDeposited()/keV;
 				m_pEventData->m_pEnergyDeposited->push_back(pHit->GetEnergyDeposited()/keV);
 
-				m_pEventData->m_pKineticEnergy->push_back(pHit->GetKineticEnergy()/keV);
 				m_pEventData->m_pTime->push_back(pHit->GetTime()/second);
 
+				if(m_bRecoilClusters)
+					m_pEventData->m_pNr->push_back(pHit->IsNuclearRecoil());
+
 				iNbSteps++;
 			}
 		};
@@ -169,44 +551,445 @@ DARWINAnalysisManager::EndOfEvent(const G4Event *pEvent)
 		m_pEventData->m_iNbSteps = iNbSteps;
 		m_pEventData->m_fTotalEnergyDeposited = fTotalEnergyDeposited;
 
+		if(m_bRecoilClusters && iNbLXeHits)
+			FillRecoilClusters();
+
+		if(m_bFastS2 && iNbLXeHits)
+			m_pFastS2->Simulate(m_pClusterer->GetClusters(), m_pQuenchingModel, m_pEventData->m_pS2PmtHits,
+				m_pEventData->m_pS2Electrons, m_pEventData->m_pS2Time, m_pEventData->m_pS2Width);
+
 		//G4int iNbTopPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbTopPmts");
 		//G4int iNbBottomPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbBottomPmts");
 		//G4int iNbTopVetoPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbTopVetoPmts");
 		//G4int iNbBottomVetoPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbBottomVetoPmts");
 		//m_pEventData->m_pPmtHits->resize(iNbTopPmts+iNbBottomPmts+iNbTopVetoPmts+iNbBottomVetoPmts, 0);
 
-		G4int iNbTopPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbTopPMTs");
-		G4int iNbBottomPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbBottomPMTs");
-		G4int iNbLSPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbLSPMTs");
-		G4int iNbWaterPmts = (G4int) DARWINDetectorConstruction::GetGeometryParameter("NbWaterPMTs");
-		m_pEventData->m_pPmtHits->resize(iNbTopPmts+iNbBottomPmts+iNbLSPmts+iNbWaterPmts, 0);
-
-		// Pmt hits
-		// Pmt hits
-		for(G4int i=0; i<iNbPmtHits; i++)
-			(*(m_pEventData->m_pPmtHits))[(*pPmtHitsCollection)[i]->GetPmtNb()]++;
-
-		m_pEventData->m_iNbTopPmtHits =
-			accumulate(m_pEventData->m_pPmtHits->begin(), m_pEventData->m_pPmtHits->begin()+iNbTopPmts, 0);
-		m_pEventData->m_iNbBottomPmtHits =
-			accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, 0);
-		m_pEventData->m_iNbLSPmtHits =
-			accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbLSPmts, 0);
-		m_pEventData->m_iNbWaterPmtHits =
-			accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbLSPmts, m_pEventData->m_pPmtHits->end(), 0);
+		if(m_pPmtSensitiveDetector)
+		{
+			m_pPmtSensitiveDetector->GetPackedTiming(m_pEventData->m_pPmtTimeId, m_pEventData->m_pPmtTimeN, m_pEventData->m_pPmtTimes);
+			m_pEventData->m_dPmtTime0 = m_pPmtSensitiveDetector->GetFirstPhotonTime()/ns;
+		}
+
+		if(m_bSparsePmtHits)
+			FillSparsePmtHits(pPmtHitsCollection, iNbPmtHits);
+		else
+		{
+			G4int iNbTopPmts = m_iNbTopPmts;
+			G4int iNbBottomPmts = m_iNbBottomPmts;
+			G4int iNbLSPmts = m_iNbLSPmts;
+			G4int iNbWaterPmts = m_iNbWaterPmts;
+			m_pEventData->m_pPmtHits->resize(iNbTopPmts+iNbBottomPmts+iNbLSPmts+iNbWaterPmts, 0);
+
+			// Pmt hits
+			for(G4int i=0; i<iNbPmtHits; i++)
+				(*(m_pEventData->m_pPmtHits))[(*pPmtHitsCollection)[i]->GetPmtNb()]++;
+
+			m_pEventData->m_iNbTopPmtHits =
+				accumulate(m_pEventData->m_pPmtHits->begin(), m_pEventData->m_pPmtHits->begin()+iNbTopPmts, 0);
+			m_pEventData->m_iNbBottomPmtHits =
+				accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, 0);
+			m_pEventData->m_iNbLSPmtHits =
+				accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts, m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbLSPmts, 0);
+			m_pEventData->m_iNbWaterPmtHits =
+				accumulate(m_pEventData->m_pPmtHits->begin()+iNbTopPmts+iNbBottomPmts+iNbLSPmts, m_pEventData->m_pPmtHits->end(), 0);
+		}
 
 //      if((fTotalEnergyDeposited > 0. || iNbPmtHits > 0) && !FilterEvent(m_pEventData))
 		//if(fTotalEnergyDeposited > 0. || iNbPmtHits > 0)
 		if(fTotalEnergyDeposited > 0.)
-			m_pTree->Fill();
+		{
+			for(vector<DARWINOutputBackend *>::iterator pIt = m_hOutputBackends.begin(); pIt != m_hOutputBackends.end(); pIt++)
+				(*pIt)->WriteEvent(m_pEventData);
+			m_iNbEventsWritten++;
+			m_iNbEventsWrittenInFile++;
+		}
 
 		m_pEventData->Clear();
 	}
+
+	if(m_pCheckpoint->IsEnabled() && m_pCheckpoint->IsDue(pEvent->GetEventID()+1))
+	{
+		// the tracks of a decay chain in progress live in the stacks, the checkpoint waits for its end
+		if(m_pPrimaryGeneratorAction->IsInChain())
+			m_pCheckpoint->Defer();
+		else
+			WriteCheckpoint(pEvent->GetEventID()+m_iEventIdOffset);
+	}
 }
 
 void
 DARWINAnalysisManager::Step(const G4Step *pStep)
 {
+	if(m_bRegionStepReport)
+	{
+		const G4Region *pRegion = pStep->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()->GetRegion();
+
+		// consecutive steps are mostly in the same region, avoid the map lookup
+		if(pRegion != m_pLastRegion)
+		{
+			m_pLastRegion = pRegion;
+			m_pLastRegionSteps = &m_hRegionSteps[pRegion];
+		}
+
+		(*m_pLastRegionSteps)++;
+	}
+
+	if(m_pStepProfiler)
+		m_pStepProfiler->Step(pStep);
+}
+
+void
+DARWINAnalysisManager::ClusterDeposits(DARWINLXeHitsCollection *pLXeHitsCollection, G4int iNbLXeHits)
+{
+	m_pClusterer->Clear();
+
+	for(G4int i=0; i<iNbLXeHits; i++)
+	{
+		DARWINLXeHit *pHit = (*pLXeHitsCollection)[i];
+
+		if(pHit->GetParticleType() != "opticalphoton")
+			m_pClusterer->AddDeposit(pHit->GetPosition(), pHit->GetEnergyDeposited(), pHit->GetTime(), pHit->IsNuclearRecoil());
+	}
+
+	m_pClusterer->MakeClusters();
+}
+
+void
+DARWINAnalysisManager::FillSummaryHistograms()
+{
+	// volume of the primary vertex, with its own navigator to leave the tracking state alone
+	if(!m_pSummaryNavigator)
+	{
+		m_pSummaryNavigator = new G4Navigator();
+		m_pSummaryNavigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+	}
+
+	G4VPhysicalVolume *pVolume = m_pSummaryNavigator->LocateGlobalPointAndSetup(m_pPrimaryGeneratorAction->GetPositionOfPrimary(), 0, true);
+	G4String hSourceVolume = (pVolume)?(pVolume->GetName()):(G4String("OutOfWorld"));
+
+	m_pSummaryHistograms->Fill(m_pClusterer->GetClusters(), hSourceVolume, m_pPrimaryGeneratorAction->GetEventWeight());
+}
+
+void
+DARWINAnalysisManager::FillRecoilClusters()
+{
+	const vector<DARWINClusterer::Cluster> &hClusters = m_pClusterer->GetClusters();
+
+	// quenching applies to the summed nuclear recoil energy of each cluster
+	for(vector<DARWINClusterer::Cluster>::const_iterator pIt = hClusters.begin(); pIt != hClusters.end(); pIt++)
+	{
+		G4double dNrEnergy = pIt->dNrEnergy;
+		G4double dErEnergy = pIt->dEnergy-pIt->dNrEnergy;
+
+		m_pEventData->m_pClusterX->push_back(pIt->hPosition.x()/mm);
+		m_pEventData->m_pClusterY->push_back(pIt->hPosition.y()/mm);
+		m_pEventData->m_pClusterZ->push_back(pIt->hPosition.z()/mm);
+		m_pEventData->m_pClusterNrEnergy->push_back(dNrEnergy/keV);
+		m_pEventData->m_pClusterErEnergy->push_back(dErEnergy/keV);
+		m_pEventData->m_pClusterEeEnergy->push_back(m_pQuenchingModel->GetElectronEquivalentEnergy(dNrEnergy, dErEnergy)/keV);
+	}
+}
+
+G4bool
+DARWINAnalysisManager::SetupPmtTiming()
+{
+	G4SDManager *pSDManager = G4SDManager::GetSDMpointer();
+	m_pPmtSensitiveDetector = dynamic_cast<DARWINPmtSensitiveDetector *>(pSDManager->FindSensitiveDetector("DARWIN/PmtSD", false));
+
+	if(!m_pPmtSensitiveDetector)
+	{
+		if(m_hPmtTiming != "None")
+			G4cout << "Error: no pmt sensitive detector, the pmt timing is not written!" << G4endl;
+		return false;
+	}
+
+	G4int iNbPmts = m_iNbTopPmts+m_iNbBottomPmts+m_iNbLSPmts+m_iNbWaterPmts;
+	G4int iNbBins = (G4int) ceil(m_dPmtTimeWindow/m_dPmtTimeBinWidth);
+
+	if(m_hPmtTiming == "FirstTimes")
+		m_pPmtSensitiveDetector->SetTiming(DARWINPmtSensitiveDetector::kFirstTimes, iNbPmts, m_iNbPmtFirstTimes, m_dPmtTimeResolution, m_dPmtTimeBinWidth, iNbBins);
+	else if(m_hPmtTiming == "Histogram")
+		m_pPmtSensitiveDetector->SetTiming(DARWINPmtSensitiveDetector::kTimeHistogram, iNbPmts, m_iNbPmtFirstTimes, m_dPmtTimeResolution, m_dPmtTimeBinWidth, iNbBins);
+	else
+	{
+		m_pPmtSensitiveDetector->SetTiming(DARWINPmtSensitiveDetector::kNoTiming, iNbPmts, 0, m_dPmtTimeResolution, m_dPmtTimeBinWidth, 0);
+		m_pPmtSensitiveDetector = 0;
+		return false;
+	}
+
+	// unpacking parameters in the root file of the chunk, times are since pmttime0
+	TParameter<int>("pmttimemode", (m_hPmtTiming == "FirstTimes")?(1):(2)).Write();
+	if(m_hPmtTiming == "FirstTimes")
+		TParameter<double>("pmttimeresolution", m_dPmtTimeResolution/ns).Write();
+	else
+	{
+		TParameter<double>("pmttimebinwidth", m_dPmtTimeBinWidth/ns).Write();
+		TParameter<int>("pmttimenbins", iNbBins).Write();
+	}
+
+	return true;
+}
+
+void
+DARWINAnalysisManager::FillSparsePmtHits(DARWINPmtHitsCollection *pPmtHitsCollection, G4int iNbPmtHits)
+{
+	vector<int> *pPmtHitId = m_pEventData->m_pPmtHitId;
+
+	// count in the scratch arrays and remember which pmts were touched
+	for(G4int i=0; i<iNbPmtHits; i++)
+	{
+		DARWINPmtHit *pHit = (*pPmtHitsCollection)[i];
+		G4int iPmtNb = pHit->GetPmtNb();
+
+		if(!m_hPmtHitCounts[iPmtNb]++)
+			pPmtHitId->push_back(iPmtNb);
+
+		if(pHit->GetTime() < m_hPmtHitTimes[iPmtNb])
+			m_hPmtHitTimes[iPmtNb] = pHit->GetTime();
+	}
+
+	sort(pPmtHitId->begin(), pPmtHitId->end());
+
+	// copy out and reset only the touched entries
+	for(vector<int>::iterator pIt = pPmtHitId->begin(); pIt != pPmtHitId->end(); pIt++)
+	{
+		G4int iPmtNb = *pIt;
+		G4int iCount = m_hPmtHitCounts[iPmtNb];
+
+		m_pEventData->m_pPmtHitCount->push_back(iCount);
+		if(m_bPmtHitTimes)
+			m_pEventData->m_pPmtHitTime->push_back(m_hPmtHitTimes[iPmtNb]/ns);
+
+		if(iPmtNb < m_iNbTopPmts)
+			m_pEventData->m_iNbTopPmtHits += iCount;
+		else if(iPmtNb < m_iNbTopPmts+m_iNbBottomPmts)
+			m_pEventData->m_iNbBottomPmtHits += iCount;
+		else if(iPmtNb < m_iNbTopPmts+m_iNbBottomPmts+m_iNbLSPmts)
+			m_pEventData->m_iNbLSPmtHits += iCount;
+		else
+			m_pEventData->m_iNbWaterPmtHits += iCount;
+
+		m_hPmtHitCounts[iPmtNb] = 0;
+		m_hPmtHitTimes[iPmtNb] = DBL_MAX;
+	}
+}
+
+void
+DARWINAnalysisManager::FillTrackTable()
+{
+	const vector<DARWINLXeSensitiveDetector::Track> &hTracks = m_pLXeSensitiveDetector->GetTracks();
+
+	// optical photons are not written, the step track indices skip them
+	m_hTrackTableIndices.resize(hTracks.size());
+	m_pEventData->ReserveTracks(hTracks.size());
+
+	G4int iNbTracks = 0;
+	for(G4int i=0; i<(G4int) hTracks.size(); i++)
+	{
+		const DARWINLXeSensitiveDetector::Track &hTrack = hTracks[i];
+
+		if(hTrack.hParticleType == "opticalphoton")
+		{
+			m_hTrackTableIndices[i] = -1;
+			continue;
+		}
+
+		m_hTrackTableIndices[i] = iNbTracks++;
+
+		m_pEventData->m_pTrackTableId->push_back(hTrack.iTrackId);
+		m_pEventData->m_pTrackTableParentId->push_back(hTrack.iParentId);
+		m_pEventData->m_pTrackTablePdg->push_back(hTrack.iPdg);
+		m_pEventData->m_pTrackTableCreatorProcess->push_back(hTrack.hCreatorProcess);
+		m_pEventData->m_pTrackTableX->push_back(hTrack.hStartPosition.x()/mm);
+		m_pEventData->m_pTrackTableY->push_back(hTrack.hStartPosition.y()/mm);
+		m_pEventData->m_pTrackTableZ->push_back(hTrack.hStartPosition.z()/mm);
+		m_pEventData->m_pTrackTableEnergy->push_back(hTrack.dStartEnergy/keV);
+	}
+}
+
+G4bool
+DARWINAnalysisManager::Resume(const G4String &hCheckpointFilename)
+{
+	if(!m_pCheckpoint->Read(hCheckpointFilename))
+		return false;
+
+	if(m_pCheckpoint->m_iLastEventId+1 >= m_pCheckpoint->m_iNbEventsToSimulate)
+	{
+		G4cout << "Error: the run of " << hCheckpointFilename << " is already complete!" << G4endl;
+		return false;
+	}
+
+	// the events left go to the next chunk, the event IDs continue those of the run
+	m_pCheckpoint->m_iNbResumes++;
+	m_hCheckpointFilename = hCheckpointFilename;
+	m_iEventIdOffset = m_pCheckpoint->m_iLastEventId+1;
+	m_iNbEventsToSimulate = m_pCheckpoint->m_iNbEventsToSimulate-m_iEventIdOffset;
+	m_bResumePending = true;
+
+	m_hDataFilename = m_pCheckpoint->m_hDataFilename;
+	std::ostringstream hStream;
+	hStream << GetFilenameStem() << "_resume" << m_pCheckpoint->m_iNbResumes << ".root";
+	m_hDataFilename = hStream.str();
+
+	G4cout << "----> Resuming " << m_pCheckpoint->m_hDataFilename << " after event " << m_pCheckpoint->m_iLastEventId
+		<< ", " << m_iNbEventsToSimulate << " events left, writing " << m_hDataFilename << G4endl;
+
+	return true;
+}
+
+void
+DARWINAnalysisManager::RestoreEngineStatus()
+{
+	if(!m_bResumePending)
+		return;
+
+	CLHEP::HepRandom::restoreEngineStatus(m_pCheckpoint->m_hEngineStatusFilename.c_str());
+	m_bResumePending = false;
+}
+
+void
+DARWINAnalysisManager::WriteCheckpoint(G4int iLastEventId)
+{
+	// the entries so far are made persistent with nbevents matching them
+	m_pTreeFile->cd();
+	TParameter<int>("nbevents", m_iNbEventsInFile).Write(0, TObject::kOverwrite);
+	for(vector<DARWINOutputBackend *>::iterator pIt = m_hOutputBackends.begin(); pIt != m_hOutputBackends.end(); pIt++)
+		(*pIt)->Flush();
+	if(m_hOutputMode != "Full")
+		m_pSummaryHistograms->Write(m_pTreeFile);
+	m_pTreeFile->Save();
+	m_pTreeFile->Flush();
+
+	// engine state after this event, the resumed run starts the next event with it
+	G4String hEngineStatusFilename = m_pCheckpoint->m_hEngineStatusFilename;
+	CLHEP::HepRandom::saveEngineStatus((hEngineStatusFilename+".tmp").c_str());
+	if(rename((hEngineStatusFilename+".tmp").c_str(), hEngineStatusFilename.c_str()) != 0)
+	{
+		G4cout << "Error: cannot rename engine status " << hEngineStatusFilename << ".tmp" << G4endl;
+		return;
+	}
+
+	// primaries drawn before the checkpoint but not generated yet
+	DARWINParticleSource *pParticleSource = m_pPrimaryGeneratorAction->GetParticleSource();
+	G4String hBatchFilename = "";
+	if(pParticleSource->HasBatchLeft())
+	{
+		hBatchFilename = GetFilenameStem()+".batch";
+		if(!pParticleSource->WriteBatch(hBatchFilename+".tmp") || rename((hBatchFilename+".tmp").c_str(), hBatchFilename.c_str()) != 0)
+		{
+			G4cout << "Error: cannot write batch " << hBatchFilename << G4endl;
+			return;
+		}
+	}
+
+	DARWINEventFileReader *pEventFileReader = pParticleSource->GetEventFileReader();
+
+	m_pCheckpoint->m_hChunkFilename = m_pTreeFile->GetName();
+	m_pCheckpoint->m_iLastEventId = iLastEventId;
+	m_pCheckpoint->m_iNbEventsInChunk = m_iNbEventsInFile;
+	m_pCheckpoint->m_lNbEntriesInChunk = m_iNbEventsWrittenInFile;
+	m_pCheckpoint->m_lEventFilePosition = pEventFileReader->GetPosition();
+	m_pCheckpoint->m_lNbEventFileRecords = pEventFileReader->GetNbRecordsRead();
+	m_pCheckpoint->m_iChainId = m_pPrimaryGeneratorAction->GetChainId();
+	m_pCheckpoint->m_hBatchFilename = hBatchFilename;
+
+	if(m_pCheckpoint->Write(m_hCheckpointFilename))
+		G4cout << "----> Checkpoint after event " << m_pCheckpoint->m_iLastEventId << " (" << m_iNbEventsWrittenInFile
+			<< " entries in " << m_pTreeFile->GetName() << ")" << G4endl;
+}
+
+void
+DARWINAnalysisManager::TrackKilled(const G4Track *pTrack)
+{
+	pair<G4long, G4double> &hKilled = m_hKilledTracks[pTrack->GetDefinition()];
+
+	hKilled.first++;
+	hKilled.second += pTrack->GetKineticEnergy();
+}
+
+void
+DARWINAnalysisManager::WriteKilledTracksSummary(const G4Run *pRun)
+{
+	G4cout << G4endl << "----> Tracks killed by the stacking action (" << pRun->GetNumberOfEvent() << " events)" << G4endl;
+
+	m_pTreeFile->cd();
+
+	map<const G4ParticleDefinition *, pair<G4long, G4double> >::iterator pIt;
+	for(pIt = m_hKilledTracks.begin(); pIt != m_hKilledTracks.end(); pIt++)
+	{
+		const G4String &hParticleName = pIt->first->GetParticleName();
+
+		G4cout << "      " << hParticleName << ": " << pIt->second.first << " tracks, "
+			<< pIt->second.second/MeV << " MeV" << G4endl;
+
+		// kept in the file to validate the policy against a simulation without it
+		TParameter<Long64_t> hKilledParameter(("killed_" + hParticleName).c_str(), pIt->second.first);
+		hKilledParameter.Write();
+
+		TParameter<double> hKilledEnergyParameter(("killedenergy_" + hParticleName).c_str(), pIt->second.second/keV);
+		hKilledEnergyParameter.Write();
+	}
+
+	G4cout << G4endl;
+}
+
+void
+DARWINAnalysisManager::WriteSurfaceFluxSummary()
+{
+	DARWINParticleSource *pParticleSource = m_pPrimaryGeneratorAction->GetParticleSource();
+
+	G4double dArea = pParticleSource->GetSurfaceFluxArea();
+	G4long lTried = pParticleSource->GetNbSurfaceFluxTried();
+	G4long lAccepted = pParticleSource->GetNbSurfaceFluxAccepted();
+
+	// exposure time for a flux of 1 cm^-2 s^-1, rates are counts/exposure*flux
+	G4double dExposure = (dArea > 0.)?(4.*lTried/(dArea/cm2)):(0.);
+
+	G4cout << G4endl << "----> Surface flux: " << lAccepted << " of " << lTried << " particles generated, area "
+		<< dArea/m2 << " m2, exposure " << dExposure << " s for 1 cm-2 s-1" << G4endl << G4endl;
+
+	m_pTreeFile->cd();
+
+	TParameter<double> hAreaParameter("flux_area", dArea/cm2);
+	hAreaParameter.Write();
+
+	TParameter<Long64_t> hTriedParameter("flux_tried", lTried);
+	hTriedParameter.Write();
+
+	TParameter<Long64_t> hAcceptedParameter("flux_accepted", lAccepted);
+	hAcceptedParameter.Write();
+
+	TParameter<double> hExposureParameter("flux_exposure", dExposure);
+	hExposureParameter.Write();
+}
+
+void
+DARWINAnalysisManager::PrintRegionStepReport(const G4Run *pRun)
+{
+	G4long lTotalSteps = 0;
+	map<const G4Region *, G4long>::iterator pIt;
+
+	for(pIt = m_hRegionSteps.begin(); pIt != m_hRegionSteps.end(); pIt++)
+		lTotalSteps += pIt->second;
+
+	G4int iNbEvents = (pRun->GetNumberOfEvent() > 0)?(pRun->GetNumberOfEvent()):(1);
+	G4int iPrecision = G4cout.precision();
+
+	G4cout << G4endl << "----> Steps per region (" << pRun->GetNumberOfEvent() << " events)" << G4endl;
+	G4cout << std::setw(36) << std::left << "region" << std::right
+		<< std::setw(16) << "steps" << std::setw(16) << "steps/event" << std::setw(10) << "%" << G4endl;
+
+	for(pIt = m_hRegionSteps.begin(); pIt != m_hRegionSteps.end(); pIt++)
+	{
+		G4cout << std::setw(36) << std::left << pIt->first->GetName() << std::right
+			<< std::setw(16) << pIt->second
+			<< std::setw(16) << std::setprecision(4) << (G4double) pIt->second/iNbEvents
+			<< std::setw(10) << std::setprecision(3) << 100.*pIt->second/((lTotalSteps)?(lTotalSteps):(1)) << G4endl;
+	}
+
+	G4cout << std::setw(36) << std::left << "total" << std::right << std::setw(16) << lTotalSteps << G4endl << G4endl;
+
+	G4cout.precision(iPrecision);
 }
 
 /*
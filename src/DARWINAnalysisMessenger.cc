@@ -0,0 +1,442 @@
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithADouble.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4Tokenizer.hh>
+
+#include "DARWINAnalysisManager.hh"
+#include "DARWINClusterer.hh"
+#include "DARWINSummaryHistograms.hh"
+#include "DARWINOutputSettings.hh"
+#include "DARWINQuenchingModel.hh"
+
+#include "DARWINAnalysisMessenger.hh"
+
+DARWINAnalysisMessenger::DARWINAnalysisMessenger(DARWINAnalysisManager *pAnalysisManager)
+:m_pAnalysisManager(pAnalysisManager)
+{
+	m_pAnalysisDir = new G4UIdirectory("/Xe/analysis/");
+	m_pAnalysisDir->SetGuidance("analysis and output control.");
+
+	m_pRegionStepReportCmd = new G4UIcmdWithABool("/Xe/analysis/setRegionStepReport", this);
+	m_pRegionStepReportCmd->SetGuidance("Count the steps taken in each region and print them at the end of the run.");
+	m_pRegionStepReportCmd->SetParameterName("Report", false);
+	m_pRegionStepReportCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pStepProfilingCmd = new G4UIcmdWithABool("/Xe/analysis/setStepProfiling", this);
+	m_pStepProfilingCmd->SetGuidance("Accumulate steps, track length and wall time per volume, particle and process.");
+	m_pStepProfilingCmd->SetGuidance("The sorted report is printed at the end of the run and saved in the \"profile\" tree.");
+	m_pStepProfilingCmd->SetParameterName("Profiling", false);
+	m_pStepProfilingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pSparsePmtHitsCmd = new G4UIcmdWithABool("/Xe/analysis/setSparsePmtHits", this);
+	m_pSparsePmtHitsCmd->SetGuidance("Write only the pmts with hits (pmthitid, pmthitcount) instead of the full pmthits vector.");
+	m_pSparsePmtHitsCmd->SetGuidance("The pmt array sizes are saved once per file (nbtoppmts, nbbottompmts, nblspmts, nbwaterpmts).");
+	m_pSparsePmtHitsCmd->SetParameterName("Sparse", false);
+	m_pSparsePmtHitsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPmtHitTimesCmd = new G4UIcmdWithABool("/Xe/analysis/setPmtHitTimes", this);
+	m_pPmtHitTimesCmd->SetGuidance("In sparse mode, also write the time of the first photon hit of each pmt (pmthittime).");
+	m_pPmtHitTimesCmd->SetParameterName("Times", false);
+	m_pPmtHitTimesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPmtTimingCmd = new G4UIcmdWithAString("/Xe/analysis/setPmtTiming", this);
+	m_pPmtTimingCmd->SetGuidance("Write the photon timing of each pmt with hits (pmttimeid, pmttimen, pmttimes).");
+	m_pPmtTimingCmd->SetGuidance("Times are counted from the first photon of the event, its global time is pmttime0.");
+	m_pPmtTimingCmd->SetGuidance("        None: no timing (default)");
+	m_pPmtTimingCmd->SetGuidance("        FirstTimes: the earliest photon times (see /Xe/analysis/setPmtFirstTimes)");
+	m_pPmtTimingCmd->SetGuidance("        Histogram: photon time histogram (see /Xe/analysis/setPmtTimeHistogram)");
+	m_pPmtTimingCmd->SetParameterName("Timing", false);
+	m_pPmtTimingCmd->SetCandidates("None FirstTimes Histogram");
+	m_pPmtTimingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPmtFirstTimesCmd = new G4UIcommand("/Xe/analysis/setPmtFirstTimes", this);
+	m_pPmtFirstTimesCmd->SetGuidance("Number of photon times kept per pmt and the time unit they are packed in.");
+	m_pPmtFirstTimesCmd->SetGuidance("[usage] /Xe/analysis/setPmtFirstTimes N Resolution Unit");
+
+	G4UIparameter *pPmtFirstTimesParameter;
+
+	pPmtFirstTimesParameter = new G4UIparameter("N", 'i', false);
+	pPmtFirstTimesParameter->SetParameterRange("N > 0");
+	m_pPmtFirstTimesCmd->SetParameter(pPmtFirstTimesParameter);
+	pPmtFirstTimesParameter = new G4UIparameter("Resolution", 'd', false);
+	pPmtFirstTimesParameter->SetParameterRange("Resolution > 0.");
+	m_pPmtFirstTimesCmd->SetParameter(pPmtFirstTimesParameter);
+	pPmtFirstTimesParameter = new G4UIparameter("Unit", 's', true);
+	pPmtFirstTimesParameter->SetDefaultValue("ns");
+	m_pPmtFirstTimesCmd->SetParameter(pPmtFirstTimesParameter);
+	m_pPmtFirstTimesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPmtTimeHistogramCmd = new G4UIcommand("/Xe/analysis/setPmtTimeHistogram", this);
+	m_pPmtTimeHistogramCmd->SetGuidance("Bin width and window of the photon time histogram of each pmt.");
+	m_pPmtTimeHistogramCmd->SetGuidance("[usage] /Xe/analysis/setPmtTimeHistogram BinWidth Window Unit");
+
+	G4UIparameter *pPmtTimeHistogramParameter;
+
+	pPmtTimeHistogramParameter = new G4UIparameter("BinWidth", 'd', false);
+	pPmtTimeHistogramParameter->SetParameterRange("BinWidth > 0.");
+	m_pPmtTimeHistogramCmd->SetParameter(pPmtTimeHistogramParameter);
+	pPmtTimeHistogramParameter = new G4UIparameter("Window", 'd', false);
+	pPmtTimeHistogramParameter->SetParameterRange("Window > 0.");
+	m_pPmtTimeHistogramCmd->SetParameter(pPmtTimeHistogramParameter);
+	pPmtTimeHistogramParameter = new G4UIparameter("Unit", 's', true);
+	pPmtTimeHistogramParameter->SetDefaultValue("ns");
+	m_pPmtTimeHistogramCmd->SetParameter(pPmtTimeHistogramParameter);
+	m_pPmtTimeHistogramCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pOutputModeCmd = new G4UIcmdWithAString("/Xe/analysis/setOutputMode", this);
+	m_pOutputModeCmd->SetGuidance("Select what is written to the output file.");
+	m_pOutputModeCmd->SetGuidance("        Full: the event tree t1 (default)");
+	m_pOutputModeCmd->SetGuidance("        Summary: only the histograms of the summary directory");
+	m_pOutputModeCmd->SetGuidance("        Both: the event tree and the histograms");
+	m_pOutputModeCmd->SetParameterName("Mode", false);
+	m_pOutputModeCmd->SetCandidates("Full Summary Both");
+	m_pOutputModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pFiducialVolumeCmd = new G4UIcommand("/Xe/analysis/setFiducialVolume", this);
+	m_pFiducialVolumeCmd->SetGuidance("Fiducial cylinder of the summary histograms, z in the laboratory (default from the geometry, centered on the TPC).");
+	m_pFiducialVolumeCmd->SetGuidance("[usage] /Xe/analysis/setFiducialVolume Radius ZMin ZMax Unit");
+
+	G4UIparameter *pFiducialVolumeParameter;
+
+	pFiducialVolumeParameter = new G4UIparameter("Radius", 'd', false);
+	pFiducialVolumeParameter->SetParameterRange("Radius > 0.");
+	m_pFiducialVolumeCmd->SetParameter(pFiducialVolumeParameter);
+	pFiducialVolumeParameter = new G4UIparameter("ZMin", 'd', false);
+	m_pFiducialVolumeCmd->SetParameter(pFiducialVolumeParameter);
+	pFiducialVolumeParameter = new G4UIparameter("ZMax", 'd', false);
+	m_pFiducialVolumeCmd->SetParameter(pFiducialVolumeParameter);
+	pFiducialVolumeParameter = new G4UIparameter("Unit", 's', true);
+	pFiducialVolumeParameter->SetDefaultValue("cm");
+	m_pFiducialVolumeCmd->SetParameter(pFiducialVolumeParameter);
+	m_pFiducialVolumeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pSummaryEnergyBinsCmd = new G4UIcommand("/Xe/analysis/setSummaryEnergyBins", this);
+	m_pSummaryEnergyBinsCmd->SetGuidance("Binning of the energy spectra of the summary histograms.");
+	m_pSummaryEnergyBinsCmd->SetGuidance("[usage] /Xe/analysis/setSummaryEnergyBins N EMin EMax Unit");
+
+	G4UIparameter *pSummaryEnergyBinsParameter;
+
+	pSummaryEnergyBinsParameter = new G4UIparameter("N", 'i', false);
+	pSummaryEnergyBinsParameter->SetParameterRange("N > 0");
+	m_pSummaryEnergyBinsCmd->SetParameter(pSummaryEnergyBinsParameter);
+	pSummaryEnergyBinsParameter = new G4UIparameter("EMin", 'd', false);
+	m_pSummaryEnergyBinsCmd->SetParameter(pSummaryEnergyBinsParameter);
+	pSummaryEnergyBinsParameter = new G4UIparameter("EMax", 'd', false);
+	m_pSummaryEnergyBinsCmd->SetParameter(pSummaryEnergyBinsParameter);
+	pSummaryEnergyBinsParameter = new G4UIparameter("Unit", 's', true);
+	pSummaryEnergyBinsParameter->SetDefaultValue("keV");
+	m_pSummaryEnergyBinsCmd->SetParameter(pSummaryEnergyBinsParameter);
+	m_pSummaryEnergyBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pSummaryThresholdCmd = new G4UIcmdWithADoubleAndUnit("/Xe/analysis/setSummaryThreshold", this);
+	m_pSummaryThresholdCmd->SetGuidance("Minimum cluster energy counted in the multiplicity of the summary histograms.");
+	m_pSummaryThresholdCmd->SetParameterName("Threshold", false);
+	m_pSummaryThresholdCmd->SetDefaultUnit("keV");
+	m_pSummaryThresholdCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pClusterResolutionCmd = new G4UIcommand("/Xe/analysis/setClusterResolution", this);
+	m_pClusterResolutionCmd->SetGuidance("Deposits closer than these distances are merged into one cluster (XY 0 to merge in z only).");
+	m_pClusterResolutionCmd->SetGuidance("[usage] /Xe/analysis/setClusterResolution Z XY Unit");
+
+	G4UIparameter *pClusterResolutionParameter;
+
+	pClusterResolutionParameter = new G4UIparameter("Z", 'd', false);
+	pClusterResolutionParameter->SetParameterRange("Z >= 0.");
+	m_pClusterResolutionCmd->SetParameter(pClusterResolutionParameter);
+	pClusterResolutionParameter = new G4UIparameter("XY", 'd', false);
+	pClusterResolutionParameter->SetParameterRange("XY >= 0.");
+	m_pClusterResolutionCmd->SetParameter(pClusterResolutionParameter);
+	pClusterResolutionParameter = new G4UIparameter("Unit", 's', true);
+	pClusterResolutionParameter->SetDefaultValue("mm");
+	m_pClusterResolutionCmd->SetParameter(pClusterResolutionParameter);
+	m_pClusterResolutionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pRecoilClustersCmd = new G4UIcmdWithABool("/Xe/analysis/setRecoilClusters", this);
+	m_pRecoilClustersCmd->SetGuidance("Write the nuclear recoil flag of each step (nr) and per cluster the nuclear and electronic");
+	m_pRecoilClustersCmd->SetGuidance("recoil energies and the quenched electron equivalent energy (cl_xp, cl_yp, cl_zp, cl_enr, cl_eer, cl_eee).");
+	m_pRecoilClustersCmd->SetParameterName("RecoilClusters", false);
+	m_pRecoilClustersCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pQuenchingModelCmd = new G4UIcmdWithAString("/Xe/analysis/setQuenchingModel", this);
+	m_pQuenchingModelCmd->SetGuidance("Quenching of the nuclear recoil energy of the clusters.");
+	m_pQuenchingModelCmd->SetGuidance("        Lindhard: Lindhard model with k from /Xe/analysis/setLindhardK (default)");
+	m_pQuenchingModelCmd->SetGuidance("        None: no quenching");
+	m_pQuenchingModelCmd->SetParameterName("Model", false);
+	m_pQuenchingModelCmd->SetCandidates("Lindhard None");
+	m_pQuenchingModelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pLindhardKCmd = new G4UIcmdWithADouble("/Xe/analysis/setLindhardK", this);
+	m_pLindhardKCmd->SetGuidance("k of the Lindhard quenching model (default 0.166).");
+	m_pLindhardKCmd->SetParameterName("K", false);
+	m_pLindhardKCmd->SetRange("K > 0.");
+	m_pLindhardKCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pOutputDir = new G4UIdirectory("/Xe/output/");
+	m_pOutputDir->SetGuidance("output file control.");
+
+	m_pMaxEventsPerFileCmd = new G4UIcmdWithAnInteger("/Xe/output/setMaxEventsPerFile", this);
+	m_pMaxEventsPerFileCmd->SetGuidance("Start a new output file after this number of simulated events (0 for no limit).");
+	m_pMaxEventsPerFileCmd->SetGuidance("The files are named <stem>_NNNN.root and listed in <stem>_index.txt.");
+	m_pMaxEventsPerFileCmd->SetParameterName("NbEvents", false);
+	m_pMaxEventsPerFileCmd->SetRange("NbEvents >= 0");
+	m_pMaxEventsPerFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pMaxFileSizeCmd = new G4UIcommand("/Xe/output/setMaxFileSize", this);
+	m_pMaxFileSizeCmd->SetGuidance("Start a new output file once the file reaches this size (0 for no limit).");
+	m_pMaxFileSizeCmd->SetGuidance("The files are named <stem>_NNNN.root and listed in <stem>_index.txt.");
+	m_pMaxFileSizeCmd->SetGuidance("[usage] /Xe/output/setMaxFileSize Size Unit");
+
+	G4UIparameter *pMaxFileSizeParameter;
+
+	pMaxFileSizeParameter = new G4UIparameter("Size", 'd', false);
+	pMaxFileSizeParameter->SetParameterRange("Size >= 0.");
+	m_pMaxFileSizeCmd->SetParameter(pMaxFileSizeParameter);
+	pMaxFileSizeParameter = new G4UIparameter("Unit", 's', true);
+	pMaxFileSizeParameter->SetParameterCandidates("kB MB GB");
+	pMaxFileSizeParameter->SetDefaultValue("MB");
+	m_pMaxFileSizeCmd->SetParameter(pMaxFileSizeParameter);
+	m_pMaxFileSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPresetCmd = new G4UIcmdWithAString("/Xe/output/preset", this);
+	m_pPresetCmd->SetGuidance("Replace the compression, basket and auto-flush settings by a preset.");
+	m_pPresetCmd->SetGuidance("        fast: LZ4, 256 kB baskets");
+	m_pPresetCmd->SetGuidance("        balanced: ZSTD, 128 kB baskets for the step vectors, LZ4 for the strings");
+	m_pPresetCmd->SetGuidance("        archive: LZMA, 512 kB baskets");
+	m_pPresetCmd->SetParameterName("Preset", false);
+	m_pPresetCmd->SetCandidates("fast balanced archive");
+	m_pPresetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pCompressionCmd = new G4UIcommand("/Xe/output/compression", this);
+	m_pCompressionCmd->SetGuidance("Compression of the output file (Branch *), or of one branch of the tree.");
+	m_pCompressionCmd->SetGuidance("[usage] /Xe/output/compression Algorithm Level Branch");
+
+	G4UIparameter *pCompressionParameter;
+
+	pCompressionParameter = new G4UIparameter("Algorithm", 's', false);
+	pCompressionParameter->SetParameterCandidates("default zlib lzma lz4 zstd");
+	m_pCompressionCmd->SetParameter(pCompressionParameter);
+	pCompressionParameter = new G4UIparameter("Level", 'i', true);
+	pCompressionParameter->SetParameterRange("Level >= 0 && Level <= 9");
+	pCompressionParameter->SetDefaultValue(4);
+	m_pCompressionCmd->SetParameter(pCompressionParameter);
+	pCompressionParameter = new G4UIparameter("Branch", 's', true);
+	pCompressionParameter->SetDefaultValue("*");
+	m_pCompressionCmd->SetParameter(pCompressionParameter);
+	m_pCompressionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pBasketSizeCmd = new G4UIcommand("/Xe/output/basketsize", this);
+	m_pBasketSizeCmd->SetGuidance("Basket size in bytes of all branches (Branch *), or of one branch (0 for the default).");
+	m_pBasketSizeCmd->SetGuidance("[usage] /Xe/output/basketsize Size Branch");
+
+	G4UIparameter *pBasketSizeParameter;
+
+	pBasketSizeParameter = new G4UIparameter("Size", 'i', false);
+	pBasketSizeParameter->SetParameterRange("Size >= 0");
+	m_pBasketSizeCmd->SetParameter(pBasketSizeParameter);
+	pBasketSizeParameter = new G4UIparameter("Branch", 's', true);
+	pBasketSizeParameter->SetDefaultValue("*");
+	m_pBasketSizeCmd->SetParameter(pBasketSizeParameter);
+	m_pBasketSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pAutoFlushCmd = new G4UIcommand("/Xe/output/autoflush", this);
+	m_pAutoFlushCmd->SetGuidance("Flush the baskets every N entries (N > 0) or every -N bytes (N < 0), 0 disables it.");
+	m_pAutoFlushCmd->SetGuidance("[usage] /Xe/output/autoflush N");
+
+	G4UIparameter *pAutoFlushParameter;
+
+	pAutoFlushParameter = new G4UIparameter("N", 'd', false);
+	m_pAutoFlushCmd->SetParameter(pAutoFlushParameter);
+	m_pAutoFlushCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pFormatCmd = new G4UIcmdWithAString("/Xe/output/format", this);
+	m_pFormatCmd->SetGuidance("Format of the event output.");
+	m_pFormatCmd->SetGuidance("        root: the t1 tree (default)");
+	m_pFormatCmd->SetGuidance("        columnar: <stem>.dcol, readable without ROOT (see readme/columnar_format.txt)");
+	m_pFormatCmd->SetGuidance("        both: the t1 tree and the columnar file");
+	m_pFormatCmd->SetParameterName("Format", false);
+	m_pFormatCmd->SetCandidates("root columnar both");
+	m_pFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pLayoutCmd = new G4UIcmdWithAString("/Xe/output/layout", this);
+	m_pLayoutCmd->SetGuidance("Layout of the LXe step data.");
+	m_pLayoutCmd->SetGuidance("        Steps: track and parent data on every step (default)");
+	m_pLayoutCmd->SetGuidance("        Tracks: a table with one entry per track, the steps point into it with trkindex");
+	m_pLayoutCmd->SetParameterName("Layout", false);
+	m_pLayoutCmd->SetCandidates("Steps Tracks");
+	m_pLayoutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+DARWINAnalysisMessenger::~DARWINAnalysisMessenger()
+{
+	delete m_pRegionStepReportCmd;
+	delete m_pStepProfilingCmd;
+	delete m_pSparsePmtHitsCmd;
+	delete m_pPmtHitTimesCmd;
+	delete m_pPmtTimingCmd;
+	delete m_pPmtFirstTimesCmd;
+	delete m_pPmtTimeHistogramCmd;
+	delete m_pOutputModeCmd;
+	delete m_pFiducialVolumeCmd;
+	delete m_pSummaryEnergyBinsCmd;
+	delete m_pSummaryThresholdCmd;
+	delete m_pClusterResolutionCmd;
+	delete m_pRecoilClustersCmd;
+	delete m_pQuenchingModelCmd;
+	delete m_pLindhardKCmd;
+
+	delete m_pMaxEventsPerFileCmd;
+	delete m_pMaxFileSizeCmd;
+	delete m_pPresetCmd;
+	delete m_pCompressionCmd;
+	delete m_pBasketSizeCmd;
+	delete m_pAutoFlushCmd;
+	delete m_pFormatCmd;
+	delete m_pLayoutCmd;
+
+	delete m_pOutputDir;
+
+	delete m_pAnalysisDir;
+}
+
+void
+DARWINAnalysisMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValue)
+{
+	if(pUIcommand == m_pRegionStepReportCmd)
+		m_pAnalysisManager->SetRegionStepReport(m_pRegionStepReportCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pStepProfilingCmd)
+		m_pAnalysisManager->SetStepProfiling(m_pStepProfilingCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pSparsePmtHitsCmd)
+		m_pAnalysisManager->SetSparsePmtHits(m_pSparsePmtHitsCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pPmtHitTimesCmd)
+		m_pAnalysisManager->SetPmtHitTimes(m_pPmtHitTimesCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pPmtTimingCmd)
+		m_pAnalysisManager->SetPmtTiming(hNewValue);
+
+	if(pUIcommand == m_pPmtFirstTimesCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4int iNbFirstTimes = StoI(next());
+		G4double dResolution = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pAnalysisManager->SetPmtFirstTimes(iNbFirstTimes, dResolution*dUnit);
+	}
+
+	if(pUIcommand == m_pPmtTimeHistogramCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4double dBinWidth = StoD(next());
+		G4double dWindow = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pAnalysisManager->SetPmtTimeHistogram(dBinWidth*dUnit, dWindow*dUnit);
+	}
+
+	if(pUIcommand == m_pOutputModeCmd)
+		m_pAnalysisManager->SetOutputMode(hNewValue);
+
+	if(pUIcommand == m_pFiducialVolumeCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4double dRadius = StoD(next());
+		G4double dZMin = StoD(next());
+		G4double dZMax = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pAnalysisManager->GetSummaryHistograms()->SetFiducialVolume(dRadius*dUnit, dZMin*dUnit, dZMax*dUnit);
+	}
+
+	if(pUIcommand == m_pSummaryEnergyBinsCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4int iNbBins = StoI(next());
+		G4double dEnergyMin = StoD(next());
+		G4double dEnergyMax = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pAnalysisManager->GetSummaryHistograms()->SetEnergyBinning(iNbBins, dEnergyMin*dUnit, dEnergyMax*dUnit);
+	}
+
+	if(pUIcommand == m_pSummaryThresholdCmd)
+		m_pAnalysisManager->GetSummaryHistograms()->SetThreshold(m_pSummaryThresholdCmd->GetNewDoubleValue(hNewValue));
+
+	if(pUIcommand == m_pClusterResolutionCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4double dResolutionZ = StoD(next());
+		G4double dResolutionXY = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pAnalysisManager->GetClusterer()->SetResolution(dResolutionZ*dUnit, dResolutionXY*dUnit);
+	}
+
+	if(pUIcommand == m_pRecoilClustersCmd)
+		m_pAnalysisManager->SetRecoilClusters(m_pRecoilClustersCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pQuenchingModelCmd)
+		m_pAnalysisManager->GetQuenchingModel()->SetModel(hNewValue);
+
+	if(pUIcommand == m_pLindhardKCmd)
+		m_pAnalysisManager->GetQuenchingModel()->SetLindhardK(m_pLindhardKCmd->GetNewDoubleValue(hNewValue));
+
+	if(pUIcommand == m_pMaxEventsPerFileCmd)
+		m_pAnalysisManager->SetMaxEventsPerFile(m_pMaxEventsPerFileCmd->GetNewIntValue(hNewValue));
+
+	if(pUIcommand == m_pMaxFileSizeCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4double dSize = StoD(next());
+		G4String hUnit = next();
+
+		G4double dBytes = dSize*((hUnit == "GB")?(1073741824.):((hUnit == "kB")?(1024.):(1048576.)));
+
+		m_pAnalysisManager->SetMaxFileSize((G4long) dBytes);
+	}
+
+	if(pUIcommand == m_pPresetCmd)
+		m_pAnalysisManager->GetOutputSettings()->SetPreset(hNewValue);
+
+	if(pUIcommand == m_pCompressionCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4String hAlgorithm = next();
+		G4int iLevel = StoI(next());
+		G4String hBranch = next();
+
+		m_pAnalysisManager->GetOutputSettings()->SetCompression(hAlgorithm, iLevel, hBranch);
+	}
+
+	if(pUIcommand == m_pBasketSizeCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4int iBasketSize = StoI(next());
+		G4String hBranch = next();
+
+		m_pAnalysisManager->GetOutputSettings()->SetBasketSize(iBasketSize, hBranch);
+	}
+
+	if(pUIcommand == m_pAutoFlushCmd)
+		m_pAnalysisManager->GetOutputSettings()->SetAutoFlush((G4long) StoD(hNewValue));
+
+	if(pUIcommand == m_pFormatCmd)
+		m_pAnalysisManager->SetOutputFormat(hNewValue);
+
+	if(pUIcommand == m_pLayoutCmd)
+		m_pAnalysisManager->SetOutputLayout(hNewValue);
+}
+
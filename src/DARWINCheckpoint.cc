@@ -0,0 +1,177 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <time.h>
+
+using std::ifstream;
+using std::ofstream;
+
+#include "DARWINCheckpointMessenger.hh"
+
+#include "DARWINCheckpoint.hh"
+
+DARWINCheckpoint::DARWINCheckpoint()
+{
+	m_iEventInterval = 0;
+	m_dTimeInterval = 0.;
+
+	m_iNextEvents = 0;
+	m_dNextTime = 0.;
+	m_bDeferred = false;
+
+	m_iNbResumes = 0;
+	m_iLastEventId = -1;
+	m_iNbEventsToSimulate = 0;
+	m_iNbEventsInChunk = 0;
+	m_lNbEntriesInChunk = 0;
+	m_lEventFilePosition = -1;
+	m_lNbEventFileRecords = 0;
+	m_iChainId = -1;
+
+	m_pMessenger = new DARWINCheckpointMessenger(this);
+}
+
+DARWINCheckpoint::~DARWINCheckpoint()
+{
+	delete m_pMessenger;
+}
+
+void
+DARWINCheckpoint::BeginOfRun()
+{
+	m_iNextEvents = m_iEventInterval;
+	m_dNextTime = GetWallTime() + m_dTimeInterval;
+	m_bDeferred = false;
+}
+
+G4bool
+DARWINCheckpoint::IsDue(G4int iNbEventsDone)
+{
+	G4bool bDue = m_bDeferred;
+	m_bDeferred = false;
+
+	if(m_iEventInterval > 0 && iNbEventsDone >= m_iNextEvents)
+	{
+		bDue = true;
+		m_iNextEvents = iNbEventsDone + m_iEventInterval;
+	}
+
+	if(m_dTimeInterval > 0. && (bDue || iNbEventsDone % 16 == 0))
+	{
+		G4double dTime = GetWallTime();
+
+		if(bDue || dTime >= m_dNextTime)
+		{
+			bDue = true;
+			m_dNextTime = dTime + m_dTimeInterval;
+		}
+	}
+
+	return bDue;
+}
+
+G4bool
+DARWINCheckpoint::Write(const G4String &hFilename) const
+{
+	G4String hTemporaryFilename = hFilename + ".tmp";
+
+	ofstream hFile(hTemporaryFilename.c_str());
+	if(!hFile)
+	{
+		G4cout << "Error: cannot write checkpoint " << hTemporaryFilename << G4endl;
+		return false;
+	}
+
+	hFile << "time " << (long) time(0) << "\n";
+	hFile << "datafile " << m_hDataFilename << "\n";
+	hFile << "resumes " << m_iNbResumes << "\n";
+	hFile << "chunk " << m_hChunkFilename << "\n";
+	hFile << "last_eventid " << m_iLastEventId << "\n";
+	hFile << "events_total " << m_iNbEventsToSimulate << "\n";
+	hFile << "chunk_events " << m_iNbEventsInChunk << "\n";
+	hFile << "chunk_entries " << m_lNbEntriesInChunk << "\n";
+	hFile << "engine_status " << m_hEngineStatusFilename << "\n";
+	hFile << "eventfile_position " << m_lEventFilePosition << "\n";
+	hFile << "eventfile_records " << m_lNbEventFileRecords << "\n";
+	hFile << "chainid " << m_iChainId << "\n";
+	if(!m_hBatchFilename.empty())
+		hFile << "batch_file " << m_hBatchFilename << "\n";
+	hFile.close();
+
+	if(!hFile || rename(hTemporaryFilename.c_str(), hFilename.c_str()) != 0)
+	{
+		G4cout << "Error: cannot rename checkpoint " << hTemporaryFilename << G4endl;
+		return false;
+	}
+
+	return true;
+}
+
+G4bool
+DARWINCheckpoint::Read(const G4String &hFilename)
+{
+	ifstream hFile(hFilename.c_str());
+	if(!hFile)
+	{
+		G4cout << "Error: cannot open checkpoint " << hFilename << G4endl;
+		return false;
+	}
+
+	m_hDataFilename = "";
+	m_iLastEventId = -1;
+	m_iChainId = -1;
+	m_hBatchFilename = "";
+
+	G4String hLine;
+	while(std::getline(hFile, hLine))
+	{
+		std::istringstream hStream(hLine);
+		G4String hKey;
+
+		if(!(hStream >> hKey))
+			continue;
+
+		if(hKey == "datafile")
+			hStream >> m_hDataFilename;
+		else if(hKey == "resumes")
+			hStream >> m_iNbResumes;
+		else if(hKey == "chunk")
+			hStream >> m_hChunkFilename;
+		else if(hKey == "last_eventid")
+			hStream >> m_iLastEventId;
+		else if(hKey == "events_total")
+			hStream >> m_iNbEventsToSimulate;
+		else if(hKey == "chunk_events")
+			hStream >> m_iNbEventsInChunk;
+		else if(hKey == "chunk_entries")
+			hStream >> m_lNbEntriesInChunk;
+		else if(hKey == "engine_status")
+			hStream >> m_hEngineStatusFilename;
+		else if(hKey == "eventfile_position")
+			hStream >> m_lEventFilePosition;
+		else if(hKey == "eventfile_records")
+			hStream >> m_lNbEventFileRecords;
+		else if(hKey == "chainid")
+			hStream >> m_iChainId;
+		else if(hKey == "batch_file")
+			hStream >> m_hBatchFilename;
+	}
+
+	if(m_hDataFilename.empty() || m_iLastEventId < 0 || m_hEngineStatusFilename.empty())
+	{
+		G4cout << "Error: incomplete checkpoint " << hFilename << G4endl;
+		return false;
+	}
+
+	return true;
+}
+
+G4double
+DARWINCheckpoint::GetWallTime()
+{
+	struct timespec hTime;
+	clock_gettime(CLOCK_MONOTONIC, &hTime);
+
+	return hTime.tv_sec + 1.e-9*hTime.tv_nsec;
+}
+
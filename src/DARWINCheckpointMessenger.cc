@@ -0,0 +1,48 @@
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+
+#include "DARWINCheckpoint.hh"
+
+#include "DARWINCheckpointMessenger.hh"
+
+DARWINCheckpointMessenger::DARWINCheckpointMessenger(DARWINCheckpoint *pCheckpoint)
+:m_pCheckpoint(pCheckpoint)
+{
+	m_pCheckpointDir = new G4UIdirectory("/Xe/checkpoint/");
+	m_pCheckpointDir->SetGuidance("checkpoint control, resume with Darwin4.0 --resume <stem>.checkpoint.");
+
+	m_pEventIntervalCmd = new G4UIcmdWithAnInteger("/Xe/checkpoint/setEventInterval", this);
+	m_pEventIntervalCmd->SetGuidance("Checkpoint every N simulated events, 0 switches it off.");
+	m_pEventIntervalCmd->SetParameterName("NbEvents", false);
+	m_pEventIntervalCmd->SetRange("NbEvents >= 0");
+	m_pEventIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pTimeIntervalCmd = new G4UIcmdWithADoubleAndUnit("/Xe/checkpoint/setTimeInterval", this);
+	m_pTimeIntervalCmd->SetGuidance("Wall time between two checkpoints, 0 switches it off.");
+	m_pTimeIntervalCmd->SetParameterName("Interval", false);
+	m_pTimeIntervalCmd->SetRange("Interval >= 0.");
+	m_pTimeIntervalCmd->SetUnitCategory("Time");
+	m_pTimeIntervalCmd->SetDefaultUnit("s");
+	m_pTimeIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+DARWINCheckpointMessenger::~DARWINCheckpointMessenger()
+{
+	delete m_pEventIntervalCmd;
+	delete m_pTimeIntervalCmd;
+
+	delete m_pCheckpointDir;
+}
+
+void
+DARWINCheckpointMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValue)
+{
+	if(pUIcommand == m_pEventIntervalCmd)
+		m_pCheckpoint->SetEventInterval(m_pEventIntervalCmd->GetNewIntValue(hNewValue));
+
+	// the wall time is measured in seconds, not in G4 time units
+	if(pUIcommand == m_pTimeIntervalCmd)
+		m_pCheckpoint->SetTimeInterval(m_pTimeIntervalCmd->GetNewDoubleValue(hNewValue)/s);
+}
+
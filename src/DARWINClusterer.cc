@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+
+#include "DARWINClusterer.hh"
+
+DARWINClusterer::DARWINClusterer()
+{
+	m_dResolutionZ = 3.*mm;
+	m_dResolutionXY = 0.;
+}
+
+DARWINClusterer::~DARWINClusterer()
+{
+}
+
+void
+DARWINClusterer::Clear()
+{
+	m_hDeposits.clear();
+	m_hClusters.clear();
+	m_hDepositClusters.clear();
+}
+
+void
+DARWINClusterer::AddDeposit(const G4ThreeVector &hPosition, G4double dEnergy, G4double dTime, G4bool bNuclearRecoil)
+{
+	if(dEnergy <= 0.)
+		return;
+
+	Deposit hDeposit;
+
+	hDeposit.hPosition = hPosition;
+	hDeposit.dEnergy = dEnergy;
+	hDeposit.dTime = dTime;
+	hDeposit.bNuclearRecoil = bNuclearRecoil;
+	hDeposit.iIndex = m_hDeposits.size();
+
+	m_hDeposits.push_back(hDeposit);
+}
+
+const vector<DARWINClusterer::Cluster> &
+DARWINClusterer::MakeClusters()
+{
+	m_hClusters.clear();
+	m_hDepositClusters.assign(m_hDeposits.size(), -1);
+
+	sort(m_hDeposits.begin(), m_hDeposits.end());
+
+	// z of the last deposit of each cluster, clusters further away in z are closed
+	vector<G4double> hLastZ;
+	G4int iFirstOpen = 0;
+
+	for(vector<Deposit>::iterator pIt = m_hDeposits.begin(); pIt != m_hDeposits.end(); pIt++)
+	{
+		const G4double dZ = pIt->hPosition.z();
+
+		while(iFirstOpen < (G4int) m_hClusters.size() && dZ-hLastZ[iFirstOpen] > m_dResolutionZ)
+			iFirstOpen++;
+
+		G4int iCluster = -1;
+		for(G4int i = iFirstOpen; i < (G4int) m_hClusters.size() && iCluster < 0; i++)
+		{
+			if(dZ-hLastZ[i] > m_dResolutionZ)
+				continue;
+
+			if(m_dResolutionXY > 0.)
+			{
+				const Cluster &hCluster = m_hClusters[i];
+				G4double dX = pIt->hPosition.x()-hCluster.hPosition.x()/hCluster.dEnergy;
+				G4double dY = pIt->hPosition.y()-hCluster.hPosition.y()/hCluster.dEnergy;
+
+				if(dX*dX+dY*dY > m_dResolutionXY*m_dResolutionXY)
+					continue;
+			}
+
+			iCluster = i;
+		}
+
+		if(iCluster < 0)
+		{
+			Cluster hCluster;
+			hCluster.hPosition = G4ThreeVector();
+			hCluster.dEnergy = 0.;
+			hCluster.dNrEnergy = 0.;
+			hCluster.dTime = pIt->dTime;
+			hCluster.iNbDeposits = 0;
+
+			m_hClusters.push_back(hCluster);
+			hLastZ.push_back(dZ);
+			iCluster = m_hClusters.size()-1;
+		}
+
+		// position summed with the energy as weight, normalized below
+		Cluster &hCluster = m_hClusters[iCluster];
+		hCluster.hPosition += pIt->dEnergy*pIt->hPosition;
+		hCluster.dEnergy += pIt->dEnergy;
+		if(pIt->bNuclearRecoil)
+			hCluster.dNrEnergy += pIt->dEnergy;
+		hCluster.dTime = std::min(hCluster.dTime, pIt->dTime);
+		hCluster.iNbDeposits++;
+
+		hLastZ[iCluster] = dZ;
+		m_hDepositClusters[pIt->iIndex] = iCluster;
+	}
+
+	for(vector<Cluster>::iterator pIt = m_hClusters.begin(); pIt != m_hClusters.end(); pIt++)
+		if(pIt->dEnergy > 0.)
+			pIt->hPosition /= pIt->dEnergy;
+
+	return m_hClusters;
+}
+
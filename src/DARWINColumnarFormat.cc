@@ -0,0 +1,489 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <iostream>
+
+#include "DARWINColumnarFormat.hh"
+
+static const char g_pColumnarFileMagic[8] = {'D', 'A', 'R', 'W', 'I', 'N', 'C', '1'};
+static const char g_pColumnarFooterMagic[8] = {'D', 'A', 'R', 'W', 'I', 'N', 'C', 'F'};
+
+// blocks start on 8 byte boundaries so the mapped arrays are aligned
+static const size_t g_lBlockAlignment = 8;
+
+static size_t
+GetElementSize(DARWINColumnType iType)
+{
+	return (iType == kColumnDouble)?(8):(4);
+}
+
+DARWINColumnarWriter::DARWINColumnarWriter()
+{
+	m_pFile = 0;
+	m_lPosition = 0;
+	m_iChunkSize = 4096;
+	m_iNbChunkEvents = 0;
+}
+
+DARWINColumnarWriter::~DARWINColumnarWriter()
+{
+	Close();
+}
+
+bool
+DARWINColumnarWriter::Open(const std::string &hFilename, uint32_t iChunkSize)
+{
+	Close();
+
+	m_pFile = fopen(hFilename.c_str(), "wb");
+	if(!m_pFile)
+	{
+		std::cerr << "Error: cannot create columnar file " << hFilename << "!" << std::endl;
+		return false;
+	}
+
+	m_lPosition = 0;
+	m_iChunkSize = (iChunkSize > 0)?(iChunkSize):(1);
+	m_iNbChunkEvents = 0;
+
+	m_hColumns.clear();
+	m_hChunks.clear();
+
+	WriteRaw(g_pColumnarFileMagic, sizeof(g_pColumnarFileMagic));
+
+	return true;
+}
+
+bool
+DARWINColumnarWriter::Close()
+{
+	if(!m_pFile)
+		return false;
+
+	if(m_iNbChunkEvents)
+		FlushChunk();
+
+	WriteFooter();
+
+	bool bOk = !ferror(m_pFile);
+	bOk = (fclose(m_pFile) == 0) && bOk;
+	m_pFile = 0;
+
+	return bOk;
+}
+
+int
+DARWINColumnarWriter::AddColumn(const std::string &hName, DARWINColumnType iType, bool bVector)
+{
+	Column hColumn;
+
+	hColumn.hName = hName;
+	hColumn.iType = iType;
+	hColumn.bVector = bVector;
+	hColumn.bFilled = false;
+	hColumn.iNbElements = 0;
+	if(bVector)
+		hColumn.hOffsets.push_back(0);
+
+	m_hColumns.push_back(hColumn);
+
+	return m_hColumns.size()-1;
+}
+
+void
+DARWINColumnarWriter::SetInt(int iColumn, int32_t iValue)
+{
+	Append(m_hColumns[iColumn], &iValue, sizeof(iValue), 1);
+}
+
+void
+DARWINColumnarWriter::SetFloat(int iColumn, float fValue)
+{
+	Append(m_hColumns[iColumn], &fValue, sizeof(fValue), 1);
+}
+
+void
+DARWINColumnarWriter::SetDouble(int iColumn, double dValue)
+{
+	Append(m_hColumns[iColumn], &dValue, sizeof(dValue), 1);
+}
+
+void
+DARWINColumnarWriter::SetString(int iColumn, const std::string &hValue)
+{
+	Column &hColumn = m_hColumns[iColumn];
+	int32_t iCode = GetCode(hColumn, hValue);
+
+	Append(hColumn, &iCode, sizeof(iCode), 1);
+}
+
+void
+DARWINColumnarWriter::AppendInts(int iColumn, const std::vector<int> &hValues)
+{
+	if(!hValues.empty())
+		Append(m_hColumns[iColumn], &hValues[0], hValues.size()*sizeof(int32_t), hValues.size());
+}
+
+void
+DARWINColumnarWriter::AppendFloats(int iColumn, const std::vector<float> &hValues)
+{
+	if(!hValues.empty())
+		Append(m_hColumns[iColumn], &hValues[0], hValues.size()*sizeof(float), hValues.size());
+}
+
+void
+DARWINColumnarWriter::AppendStrings(int iColumn, const std::vector<std::string> &hValues)
+{
+	Column &hColumn = m_hColumns[iColumn];
+
+	for(std::vector<std::string>::const_iterator pIt = hValues.begin(); pIt != hValues.end(); pIt++)
+	{
+		int32_t iCode = GetCode(hColumn, *pIt);
+		Append(hColumn, &iCode, sizeof(iCode), 1);
+	}
+}
+
+void
+DARWINColumnarWriter::EndEvent()
+{
+	for(std::vector<Column>::iterator pIt = m_hColumns.begin(); pIt != m_hColumns.end(); pIt++)
+	{
+		if(pIt->bVector)
+			pIt->hOffsets.push_back(pIt->iNbElements);
+		else if(!pIt->bFilled)
+		{
+			const char pZero[8] = {0};
+			Append(*pIt, pZero, GetElementSize(pIt->iType), 1);
+		}
+
+		pIt->bFilled = false;
+	}
+
+	if(++m_iNbChunkEvents >= m_iChunkSize)
+		FlushChunk();
+}
+
+void
+DARWINColumnarWriter::Append(Column &hColumn, const void *pValues, size_t lSize, uint32_t iNbValues)
+{
+	// a scalar keeps the first value of the event
+	if(!hColumn.bVector && hColumn.bFilled)
+		return;
+
+	const char *pBytes = static_cast<const char *>(pValues);
+	hColumn.hData.insert(hColumn.hData.end(), pBytes, pBytes+lSize);
+	hColumn.iNbElements += iNbValues;
+	hColumn.bFilled = true;
+}
+
+int32_t
+DARWINColumnarWriter::GetCode(Column &hColumn, const std::string &hValue)
+{
+	std::map<std::string, int32_t>::iterator pIt = hColumn.hCodes.find(hValue);
+
+	if(pIt != hColumn.hCodes.end())
+		return pIt->second;
+
+	int32_t iCode = hColumn.hStrings.size();
+	hColumn.hCodes[hValue] = iCode;
+	hColumn.hStrings.push_back(hValue);
+
+	return iCode;
+}
+
+void
+DARWINColumnarWriter::FlushChunk()
+{
+	Chunk hChunk;
+	hChunk.lNbEvents = m_iNbChunkEvents;
+
+	for(std::vector<Column>::iterator pIt = m_hColumns.begin(); pIt != m_hColumns.end(); pIt++)
+	{
+		ChunkColumn hChunkColumn;
+
+		hChunkColumn.lNbElements = pIt->iNbElements;
+		hChunkColumn.lDataOffset = WriteBlock((pIt->hData.empty())?(0):(&pIt->hData[0]), pIt->hData.size());
+		hChunkColumn.lOffsetsOffset = (pIt->bVector)?(WriteBlock(&pIt->hOffsets[0], pIt->hOffsets.size()*sizeof(uint32_t))):(0);
+
+		hChunk.hColumns.push_back(hChunkColumn);
+
+		// the buffers keep their capacity for the next chunk
+		pIt->hData.clear();
+		pIt->iNbElements = 0;
+		if(pIt->bVector)
+			pIt->hOffsets.assign(1, 0);
+	}
+
+	m_hChunks.push_back(hChunk);
+	m_iNbChunkEvents = 0;
+}
+
+uint64_t
+DARWINColumnarWriter::WriteBlock(const void *pData, size_t lSize)
+{
+	const char pPadding[g_lBlockAlignment] = {0};
+
+	if(m_lPosition % g_lBlockAlignment)
+		WriteRaw(pPadding, g_lBlockAlignment - m_lPosition % g_lBlockAlignment);
+
+	uint64_t lOffset = m_lPosition;
+	if(lSize)
+		WriteRaw(pData, lSize);
+
+	return lOffset;
+}
+
+void
+DARWINColumnarWriter::WriteRaw(const void *pData, size_t lSize)
+{
+	fwrite(pData, 1, lSize, m_pFile);
+	m_lPosition += lSize;
+}
+
+void
+DARWINColumnarWriter::WriteFooter()
+{
+	uint64_t lFooterOffset = WriteBlock(0, 0);
+
+	uint32_t iNbColumns = m_hColumns.size();
+	WriteRaw(&iNbColumns, sizeof(iNbColumns));
+
+	for(std::vector<Column>::const_iterator pIt = m_hColumns.begin(); pIt != m_hColumns.end(); pIt++)
+	{
+		uint32_t iLength = pIt->hName.size();
+		WriteRaw(&iLength, sizeof(iLength));
+		WriteRaw(pIt->hName.data(), iLength);
+
+		uint8_t pTypeAndVector[2] = {(uint8_t) pIt->iType, (uint8_t) pIt->bVector};
+		WriteRaw(pTypeAndVector, sizeof(pTypeAndVector));
+
+		uint32_t iNbStrings = pIt->hStrings.size();
+		WriteRaw(&iNbStrings, sizeof(iNbStrings));
+		for(std::vector<std::string>::const_iterator pString = pIt->hStrings.begin(); pString != pIt->hStrings.end(); pString++)
+		{
+			iLength = pString->size();
+			WriteRaw(&iLength, sizeof(iLength));
+			WriteRaw(pString->data(), iLength);
+		}
+	}
+
+	uint32_t iNbChunks = m_hChunks.size();
+	WriteRaw(&iNbChunks, sizeof(iNbChunks));
+
+	for(std::vector<Chunk>::const_iterator pIt = m_hChunks.begin(); pIt != m_hChunks.end(); pIt++)
+	{
+		WriteRaw(&pIt->lNbEvents, sizeof(pIt->lNbEvents));
+		for(std::vector<ChunkColumn>::const_iterator pColumn = pIt->hColumns.begin(); pColumn != pIt->hColumns.end(); pColumn++)
+		{
+			WriteRaw(&pColumn->lDataOffset, sizeof(pColumn->lDataOffset));
+			WriteRaw(&pColumn->lNbElements, sizeof(pColumn->lNbElements));
+			WriteRaw(&pColumn->lOffsetsOffset, sizeof(pColumn->lOffsetsOffset));
+		}
+	}
+
+	WriteRaw(&lFooterOffset, sizeof(lFooterOffset));
+	WriteRaw(g_pColumnarFooterMagic, sizeof(g_pColumnarFooterMagic));
+}
+
+DARWINColumnarReader::DARWINColumnarReader()
+{
+	m_iFileDescriptor = -1;
+	m_pData = 0;
+	m_lSize = 0;
+	m_lNbEvents = 0;
+}
+
+DARWINColumnarReader::~DARWINColumnarReader()
+{
+	Close();
+}
+
+bool
+DARWINColumnarReader::Open(const std::string &hFilename)
+{
+	Close();
+
+	m_iFileDescriptor = open(hFilename.c_str(), O_RDONLY);
+
+	struct stat hStat;
+	if(m_iFileDescriptor < 0 || fstat(m_iFileDescriptor, &hStat) != 0 || hStat.st_size == 0)
+	{
+		std::cerr << "Error: cannot open columnar file " << hFilename << "!" << std::endl;
+		Close();
+		return false;
+	}
+
+	m_lSize = (size_t) hStat.st_size;
+
+	void *pMap = mmap(0, m_lSize, PROT_READ, MAP_PRIVATE, m_iFileDescriptor, 0);
+	if(pMap == MAP_FAILED)
+	{
+		std::cerr << "Error: cannot map columnar file " << hFilename << "!" << std::endl;
+		Close();
+		return false;
+	}
+
+	m_pData = static_cast<const char *>(pMap);
+
+	if(m_lSize < sizeof(g_pColumnarFileMagic) || memcmp(m_pData, g_pColumnarFileMagic, sizeof(g_pColumnarFileMagic)) || !ReadFooter())
+	{
+		std::cerr << "Error: " << hFilename << " is not a complete columnar file!" << std::endl;
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void
+DARWINColumnarReader::Close()
+{
+	if(m_pData)
+		munmap((void *) m_pData, m_lSize);
+
+	if(m_iFileDescriptor >= 0)
+		close(m_iFileDescriptor);
+
+	m_iFileDescriptor = -1;
+	m_pData = 0;
+	m_lSize = 0;
+
+	m_lNbEvents = 0;
+	m_hColumns.clear();
+	m_hChunks.clear();
+}
+
+int
+DARWINColumnarReader::FindColumn(const std::string &hName) const
+{
+	for(size_t i = 0; i < m_hColumns.size(); i++)
+		if(m_hColumns[i].hName == hName)
+			return i;
+
+	return -1;
+}
+
+const void *
+DARWINColumnarReader::GetData(int iColumn, int iChunk, uint64_t &lNbElements) const
+{
+	const ChunkColumn &hChunkColumn = m_hChunks[iChunk].hColumns[iColumn];
+
+	lNbElements = hChunkColumn.lNbElements;
+
+	return m_pData+hChunkColumn.lDataOffset;
+}
+
+const uint32_t *
+DARWINColumnarReader::GetOffsets(int iColumn, int iChunk) const
+{
+	if(!m_hColumns[iColumn].bVector)
+		return 0;
+
+	return reinterpret_cast<const uint32_t *>(m_pData+m_hChunks[iChunk].hColumns[iColumn].lOffsetsOffset);
+}
+
+bool
+DARWINColumnarReader::ReadFooter()
+{
+	// trailer: footer offset and magic
+	const size_t lTrailerSize = sizeof(uint64_t)+sizeof(g_pColumnarFooterMagic);
+	if(m_lSize < sizeof(g_pColumnarFileMagic)+lTrailerSize)
+		return false;
+
+	const char *pTrailer = m_pData+m_lSize-lTrailerSize;
+	if(memcmp(pTrailer+sizeof(uint64_t), g_pColumnarFooterMagic, sizeof(g_pColumnarFooterMagic)))
+		return false;
+
+	uint64_t lFooterOffset;
+	memcpy(&lFooterOffset, pTrailer, sizeof(lFooterOffset));
+	if(lFooterOffset >= m_lSize-lTrailerSize)
+		return false;
+
+	const char *pCursor = m_pData+lFooterOffset;
+
+	uint32_t iNbColumns;
+	if(!Read(pCursor, &iNbColumns, sizeof(iNbColumns)))
+		return false;
+
+	for(uint32_t i = 0; i < iNbColumns; i++)
+	{
+		Column hColumn;
+		uint8_t pTypeAndVector[2];
+		uint32_t iNbStrings;
+
+		if(!ReadString(pCursor, hColumn.hName) || !Read(pCursor, pTypeAndVector, sizeof(pTypeAndVector)) || !Read(pCursor, &iNbStrings, sizeof(iNbStrings)))
+			return false;
+
+		hColumn.iType = (DARWINColumnType) pTypeAndVector[0];
+		hColumn.bVector = pTypeAndVector[1];
+
+		hColumn.hStrings.resize(iNbStrings);
+		for(uint32_t j = 0; j < iNbStrings; j++)
+			if(!ReadString(pCursor, hColumn.hStrings[j]))
+				return false;
+
+		m_hColumns.push_back(hColumn);
+	}
+
+	uint32_t iNbChunks;
+	if(!Read(pCursor, &iNbChunks, sizeof(iNbChunks)))
+		return false;
+
+	for(uint32_t i = 0; i < iNbChunks; i++)
+	{
+		Chunk hChunk;
+
+		if(!Read(pCursor, &hChunk.lNbEvents, sizeof(hChunk.lNbEvents)))
+			return false;
+
+		hChunk.hColumns.resize(iNbColumns);
+		for(uint32_t j = 0; j < iNbColumns; j++)
+		{
+			ChunkColumn &hChunkColumn = hChunk.hColumns[j];
+
+			if(!Read(pCursor, &hChunkColumn.lDataOffset, sizeof(uint64_t))
+				|| !Read(pCursor, &hChunkColumn.lNbElements, sizeof(uint64_t))
+				|| !Read(pCursor, &hChunkColumn.lOffsetsOffset, sizeof(uint64_t)))
+				return false;
+
+			size_t lDataSize = hChunkColumn.lNbElements*GetElementSize(m_hColumns[j].iType);
+			size_t lOffsetsSize = (m_hColumns[j].bVector)?((hChunk.lNbEvents+1)*sizeof(uint32_t)):(0);
+			if(hChunkColumn.lDataOffset+lDataSize > lFooterOffset || hChunkColumn.lOffsetsOffset+lOffsetsSize > lFooterOffset)
+				return false;
+		}
+
+		m_lNbEvents += hChunk.lNbEvents;
+		m_hChunks.push_back(hChunk);
+	}
+
+	return true;
+}
+
+bool
+DARWINColumnarReader::Read(const char *&pCursor, void *pValue, size_t lSize) const
+{
+	if(pCursor+lSize > m_pData+m_lSize)
+		return false;
+
+	memcpy(pValue, pCursor, lSize);
+	pCursor += lSize;
+
+	return true;
+}
+
+bool
+DARWINColumnarReader::ReadString(const char *&pCursor, std::string &hString) const
+{
+	uint32_t iLength;
+
+	if(!Read(pCursor, &iLength, sizeof(iLength)) || pCursor+iLength > m_pData+m_lSize)
+		return false;
+
+	hString.assign(pCursor, iLength);
+	pCursor += iLength;
+
+	return true;
+}
+
@@ -0,0 +1,204 @@
+#include "DARWINEventData.hh"
+
+#include "DARWINColumnarOutput.hh"
+
+DARWINColumnarOutput::DARWINColumnarOutput(const DARWINOutputColumns &hColumns)
+{
+	m_hColumns = hColumns;
+
+	for(G4int i = 0; i < kNbColumns; i++)
+		m_pColumns[i] = -1;
+}
+
+DARWINColumnarOutput::~DARWINColumnarOutput()
+{
+	Close();
+}
+
+G4bool
+DARWINColumnarOutput::Open(const G4String &hFilename)
+{
+	if(!m_hWriter.Open(hFilename))
+		return false;
+
+	DefineColumns();
+
+	return true;
+}
+
+void
+DARWINColumnarOutput::Close()
+{
+	if(m_hWriter.IsOpen())
+		m_hWriter.Close();
+}
+
+void
+DARWINColumnarOutput::DefineColumns()
+{
+	// same names and units as the t1 branches
+	m_pColumns[kEventId] = m_hWriter.AddColumn("eventid", kColumnInt, false);
+	m_pColumns[kChainId] = m_hWriter.AddColumn("chainid", kColumnInt, false);
+	m_pColumns[kChainTime] = m_hWriter.AddColumn("chaintime", kColumnDouble, false);
+	m_pColumns[kWeight] = m_hWriter.AddColumn("weight", kColumnFloat, false);
+	m_pColumns[kNbTopPmtHits] = m_hWriter.AddColumn("ntpmthits", kColumnInt, false);
+	m_pColumns[kNbBottomPmtHits] = m_hWriter.AddColumn("nbpmthits", kColumnInt, false);
+	if(m_hColumns.bSparsePmtHits)
+	{
+		m_pColumns[kPmtHitId] = m_hWriter.AddColumn("pmthitid", kColumnInt, true);
+		m_pColumns[kPmtHitCount] = m_hWriter.AddColumn("pmthitcount", kColumnInt, true);
+		if(m_hColumns.bPmtHitTimes)
+			m_pColumns[kPmtHitTime] = m_hWriter.AddColumn("pmthittime", kColumnFloat, true);
+	}
+	else
+		m_pColumns[kPmtHits] = m_hWriter.AddColumn("pmthits", kColumnInt, true);
+	if(m_hColumns.bPmtTiming)
+	{
+		m_pColumns[kPmtTimeId] = m_hWriter.AddColumn("pmttimeid", kColumnInt, true);
+		m_pColumns[kPmtTimeN] = m_hWriter.AddColumn("pmttimen", kColumnInt, true);
+		m_pColumns[kPmtTimes] = m_hWriter.AddColumn("pmttimes", kColumnInt, true);
+		m_pColumns[kPmtTime0] = m_hWriter.AddColumn("pmttime0", kColumnDouble, false);
+	}
+	m_pColumns[kTotalEnergyDeposited] = m_hWriter.AddColumn("etot", kColumnFloat, false);
+	m_pColumns[kNbSteps] = m_hWriter.AddColumn("nsteps", kColumnInt, false);
+
+	if(m_hColumns.bTrackTable)
+	{
+		m_pColumns[kTrackTableId] = m_hWriter.AddColumn("trk_id", kColumnInt, true);
+		m_pColumns[kTrackTableParentId] = m_hWriter.AddColumn("trk_parentid", kColumnInt, true);
+		m_pColumns[kTrackTablePdg] = m_hWriter.AddColumn("trk_pdg", kColumnInt, true);
+		m_pColumns[kTrackTableCreatorProcess] = m_hWriter.AddColumn("trk_creaproc", kColumnString, true);
+		m_pColumns[kTrackTableX] = m_hWriter.AddColumn("trk_xp", kColumnFloat, true);
+		m_pColumns[kTrackTableY] = m_hWriter.AddColumn("trk_yp", kColumnFloat, true);
+		m_pColumns[kTrackTableZ] = m_hWriter.AddColumn("trk_zp", kColumnFloat, true);
+		m_pColumns[kTrackTableEnergy] = m_hWriter.AddColumn("trk_e", kColumnFloat, true);
+
+		m_pColumns[kStepTrackIndex] = m_hWriter.AddColumn("trkindex", kColumnInt, true);
+	}
+	else
+	{
+		m_pColumns[kTrackId] = m_hWriter.AddColumn("trackid", kColumnInt, true);
+		m_pColumns[kParticleType] = m_hWriter.AddColumn("type", kColumnString, true);
+		m_pColumns[kParentId] = m_hWriter.AddColumn("parentid", kColumnInt, true);
+		m_pColumns[kParentType] = m_hWriter.AddColumn("parenttype", kColumnString, true);
+		m_pColumns[kCreatorProcess] = m_hWriter.AddColumn("creaproc", kColumnString, true);
+	}
+	m_pColumns[kDepositingProcess] = m_hWriter.AddColumn("edproc", kColumnString, true);
+	m_pColumns[kX] = m_hWriter.AddColumn("xp", kColumnFloat, true);
+	m_pColumns[kY] = m_hWriter.AddColumn("yp", kColumnFloat, true);
+	m_pColumns[kZ] = m_hWriter.AddColumn("zp", kColumnFloat, true);
+	m_pColumns[kEnergyDeposited] = m_hWriter.AddColumn("ed", kColumnFloat, true);
+	m_pColumns[kTime] = m_hWriter.AddColumn("time", kColumnFloat, true);
+
+	if(m_hColumns.bRecoilClusters)
+	{
+		m_pColumns[kNuclearRecoil] = m_hWriter.AddColumn("nr", kColumnInt, true);
+		m_pColumns[kClusterX] = m_hWriter.AddColumn("cl_xp", kColumnFloat, true);
+		m_pColumns[kClusterY] = m_hWriter.AddColumn("cl_yp", kColumnFloat, true);
+		m_pColumns[kClusterZ] = m_hWriter.AddColumn("cl_zp", kColumnFloat, true);
+		m_pColumns[kClusterNrEnergy] = m_hWriter.AddColumn("cl_enr", kColumnFloat, true);
+		m_pColumns[kClusterErEnergy] = m_hWriter.AddColumn("cl_eer", kColumnFloat, true);
+		m_pColumns[kClusterEeEnergy] = m_hWriter.AddColumn("cl_eee", kColumnFloat, true);
+	}
+
+	if(m_hColumns.bFastS2)
+	{
+		m_pColumns[kS2PmtHits] = m_hWriter.AddColumn("s2pmthits", kColumnInt, true);
+		m_pColumns[kS2Electrons] = m_hWriter.AddColumn("s2ne", kColumnInt, true);
+		m_pColumns[kS2Time] = m_hWriter.AddColumn("s2time", kColumnFloat, true);
+		m_pColumns[kS2Width] = m_hWriter.AddColumn("s2width", kColumnFloat, true);
+	}
+
+	m_pColumns[kPrimaryParticleType] = m_hWriter.AddColumn("type_pri", kColumnString, true);
+	m_pColumns[kPrimaryX] = m_hWriter.AddColumn("xp_pri", kColumnFloat, false);
+	m_pColumns[kPrimaryY] = m_hWriter.AddColumn("yp_pri", kColumnFloat, false);
+	m_pColumns[kPrimaryZ] = m_hWriter.AddColumn("zp_pri", kColumnFloat, false);
+	m_pColumns[kPrimaryE] = m_hWriter.AddColumn("e_pri", kColumnFloat, false);
+}
+
+void
+DARWINColumnarOutput::WriteEvent(const DARWINEventData *pEventData)
+{
+	m_hWriter.SetInt(m_pColumns[kEventId], pEventData->m_iEventId);
+	m_hWriter.SetInt(m_pColumns[kChainId], pEventData->m_iChainId);
+	m_hWriter.SetDouble(m_pColumns[kChainTime], pEventData->m_dChainTime);
+	m_hWriter.SetFloat(m_pColumns[kWeight], pEventData->m_fWeight);
+	m_hWriter.SetInt(m_pColumns[kNbTopPmtHits], pEventData->m_iNbTopPmtHits);
+	m_hWriter.SetInt(m_pColumns[kNbBottomPmtHits], pEventData->m_iNbBottomPmtHits);
+	if(m_hColumns.bSparsePmtHits)
+	{
+		m_hWriter.AppendInts(m_pColumns[kPmtHitId], *pEventData->m_pPmtHitId);
+		m_hWriter.AppendInts(m_pColumns[kPmtHitCount], *pEventData->m_pPmtHitCount);
+		if(m_hColumns.bPmtHitTimes)
+			m_hWriter.AppendFloats(m_pColumns[kPmtHitTime], *pEventData->m_pPmtHitTime);
+	}
+	else
+		m_hWriter.AppendInts(m_pColumns[kPmtHits], *pEventData->m_pPmtHits);
+	if(m_hColumns.bPmtTiming)
+	{
+		m_hWriter.AppendInts(m_pColumns[kPmtTimeId], *pEventData->m_pPmtTimeId);
+		m_hConverted.assign(pEventData->m_pPmtTimeN->begin(), pEventData->m_pPmtTimeN->end());
+		m_hWriter.AppendInts(m_pColumns[kPmtTimeN], m_hConverted);
+		m_hConverted.assign(pEventData->m_pPmtTimes->begin(), pEventData->m_pPmtTimes->end());
+		m_hWriter.AppendInts(m_pColumns[kPmtTimes], m_hConverted);
+		m_hWriter.SetDouble(m_pColumns[kPmtTime0], pEventData->m_dPmtTime0);
+	}
+	m_hWriter.SetFloat(m_pColumns[kTotalEnergyDeposited], pEventData->m_fTotalEnergyDeposited);
+	m_hWriter.SetInt(m_pColumns[kNbSteps], pEventData->m_iNbSteps);
+
+	if(m_hColumns.bTrackTable)
+	{
+		m_hWriter.AppendInts(m_pColumns[kTrackTableId], *pEventData->m_pTrackTableId);
+		m_hWriter.AppendInts(m_pColumns[kTrackTableParentId], *pEventData->m_pTrackTableParentId);
+		m_hWriter.AppendInts(m_pColumns[kTrackTablePdg], *pEventData->m_pTrackTablePdg);
+		m_hWriter.AppendStrings(m_pColumns[kTrackTableCreatorProcess], *pEventData->m_pTrackTableCreatorProcess);
+		m_hWriter.AppendFloats(m_pColumns[kTrackTableX], *pEventData->m_pTrackTableX);
+		m_hWriter.AppendFloats(m_pColumns[kTrackTableY], *pEventData->m_pTrackTableY);
+		m_hWriter.AppendFloats(m_pColumns[kTrackTableZ], *pEventData->m_pTrackTableZ);
+		m_hWriter.AppendFloats(m_pColumns[kTrackTableEnergy], *pEventData->m_pTrackTableEnergy);
+
+		m_hWriter.AppendInts(m_pColumns[kStepTrackIndex], *pEventData->m_pStepTrackIndex);
+	}
+	else
+	{
+		m_hWriter.AppendInts(m_pColumns[kTrackId], *pEventData->m_pTrackId);
+		m_hWriter.AppendStrings(m_pColumns[kParticleType], *pEventData->m_pParticleType);
+		m_hWriter.AppendInts(m_pColumns[kParentId], *pEventData->m_pParentId);
+		m_hWriter.AppendStrings(m_pColumns[kParentType], *pEventData->m_pParentType);
+		m_hWriter.AppendStrings(m_pColumns[kCreatorProcess], *pEventData->m_pCreatorProcess);
+	}
+	m_hWriter.AppendStrings(m_pColumns[kDepositingProcess], *pEventData->m_pDepositingProcess);
+	m_hWriter.AppendFloats(m_pColumns[kX], *pEventData->m_pX);
+	m_hWriter.AppendFloats(m_pColumns[kY], *pEventData->m_pY);
+	m_hWriter.AppendFloats(m_pColumns[kZ], *pEventData->m_pZ);
+	m_hWriter.AppendFloats(m_pColumns[kEnergyDeposited], *pEventData->m_pEnergyDeposited);
+	m_hWriter.AppendFloats(m_pColumns[kTime], *pEventData->m_pTime);
+
+	if(m_hColumns.bRecoilClusters)
+	{
+		m_hWriter.AppendInts(m_pColumns[kNuclearRecoil], *pEventData->m_pNr);
+		m_hWriter.AppendFloats(m_pColumns[kClusterX], *pEventData->m_pClusterX);
+		m_hWriter.AppendFloats(m_pColumns[kClusterY], *pEventData->m_pClusterY);
+		m_hWriter.AppendFloats(m_pColumns[kClusterZ], *pEventData->m_pClusterZ);
+		m_hWriter.AppendFloats(m_pColumns[kClusterNrEnergy], *pEventData->m_pClusterNrEnergy);
+		m_hWriter.AppendFloats(m_pColumns[kClusterErEnergy], *pEventData->m_pClusterErEnergy);
+		m_hWriter.AppendFloats(m_pColumns[kClusterEeEnergy], *pEventData->m_pClusterEeEnergy);
+	}
+
+	if(m_hColumns.bFastS2)
+	{
+		m_hWriter.AppendInts(m_pColumns[kS2PmtHits], *pEventData->m_pS2PmtHits);
+		m_hWriter.AppendInts(m_pColumns[kS2Electrons], *pEventData->m_pS2Electrons);
+		m_hWriter.AppendFloats(m_pColumns[kS2Time], *pEventData->m_pS2Time);
+		m_hWriter.AppendFloats(m_pColumns[kS2Width], *pEventData->m_pS2Width);
+	}
+
+	m_hWriter.AppendStrings(m_pColumns[kPrimaryParticleType], *pEventData->m_pPrimaryParticleType);
+	m_hWriter.SetFloat(m_pColumns[kPrimaryX], pEventData->m_fPrimaryX);
+	m_hWriter.SetFloat(m_pColumns[kPrimaryY], pEventData->m_fPrimaryY);
+	m_hWriter.SetFloat(m_pColumns[kPrimaryZ], pEventData->m_fPrimaryZ);
+	m_hWriter.SetFloat(m_pColumns[kPrimaryE], pEventData->m_fPrimaryE);
+
+	m_hWriter.EndEvent();
+}
+
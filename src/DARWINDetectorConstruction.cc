@@ -18,6 +18,10 @@
 #include <G4PVParameterised.hh>
 #include <G4OpBoundaryProcess.hh>
 #include <G4SDManager.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4UserLimits.hh>
 #include <G4ThreeVector.hh>
 #include <G4RotationMatrix.hh>
 #include <G4VisAttributes.hh>
@@ -121,6 +125,8 @@ DARWINDetectorConstruction::Construct()
 
 	//ConstructVetoPMTArrays(); G4cout<<"Constructing Veto PMT arrays"<<G4endl;
 
+	ConstructRegions(); G4cout<<"Constructing Regions"<<G4endl;
+
 	//CheckOverlapping();
 
 	//PrintGeometryInformation();
@@ -949,6 +955,15 @@ DARWINDetectorConstruction::ConstructXenon()
 	m_pOuterLXePhysicalVolume = new G4PVPlacement(0, G4ThreeVector(OuterLXeXOffset, OuterLXeYOffset, OuterLXeZOffset),
 			"m_pOuterLXePhysicalVolume", m_pOuterLXeLogicalVolume, m_pGXePhysicalVolume, false, 0);
 
+	// z of the outer LXe in the laboratory, summed over the placements of its mothers
+	m_hGeometryParameters["OuterLXeZ"] = m_pWaterTankPhysicalVolume->GetTranslation().z()+
+										m_pWaterPhysicalVolume->GetTranslation().z()+
+										m_pOuterCryostatPhysicalVolume->GetTranslation().z()+
+										m_pCryostatVacuumPhysicalVolume->GetTranslation().z()+
+										m_pInnerCryostatPhysicalVolume->GetTranslation().z()+
+										m_pGXePhysicalVolume->GetTranslation().z()+
+										m_pOuterLXePhysicalVolume->GetTranslation().z();
+
 	// =============================== Top Gas inside the Diving Bell ====================================
 	G4double dInnerGasHeight = dBellHeight;
 	G4Tubs *InnerGXeTubs = new G4Tubs("InnerGXeTubs",0.0*cm,dBellInnerRadius,0.5*(dInnerGasHeight)-0.1*mm,0.0*deg,360.0*deg);
@@ -1041,6 +1056,9 @@ DARWINDetectorConstruction::ConstructTPC()
 	m_pTPCPhysicalVolume = new G4PVPlacement(0, G4ThreeVector(TPCXOffset, TPCYOffset, TPCZOffset),
 			"TPC", m_pTPCLogicalVolume, m_pOuterLXePhysicalVolume, false, 0);
 
+	// the tpc is not centered at 0, its z in the laboratory
+	m_hGeometryParameters["TPCCenterZ"] = GetGeometryParameter("OuterLXeZ")+TPCZOffset;
+
 	G4Colour hPTFEColor(1., 1., 1., 0.05);
 	G4VisAttributes *pPTFEVisAtt = new G4VisAttributes(hPTFEColor);
 	pPTFEVisAtt->SetVisibility(true);
@@ -1139,6 +1157,10 @@ DARWINDetectorConstruction::ConstructFieldCage()
 	m_pCathodeGridMeshPhysicalVolume = new G4PVPlacement(0, G4ThreeVector(dGridsXOffset, dGridsYOffset, dCathodeGridMeshZOffset),
 		"CathodeMesh", m_pGridMeshLogicalVolume, m_pOuterLXePhysicalVolume, false, 0);
 
+	// drift region in the laboratory, from the gate (below liquid mesh) to the cathode mesh
+	m_hGeometryParameters["GateZ"] = GetGeometryParameter("OuterLXeZ")+dBelowLiquidGridMeshZOffset;
+	m_hGeometryParameters["CathodeZ"] = GetGeometryParameter("OuterLXeZ")+dCathodeGridMeshZOffset;
+
 	//================================== Very Bottom grid ring + mesh =================================
 	G4double dVeryBottomGridZOffset = -0.5*dTPCHeight+
 									dPhotoSensorsHeight+
@@ -1714,6 +1736,110 @@ DARWINDetectorConstruction::ConstructSensitiveLXe()
 
 }
 
+void
+DARWINDetectorConstruction::ConstructRegions()
+{
+	// a daughter volume belongs to the region of its mother unless it is the root of another
+	// region, the laboratory stays in the default region of the world
+	
+	//================================== water shield ==================================
+	G4Region *pWaterRegion = new G4Region("Water");
+	pWaterRegion->AddRootLogicalVolume(m_pWaterTankLogicalVolume);
+
+	//================================== cryostat shells ===============================
+	G4Region *pCryostatRegion = new G4Region("Cryostat");
+	pCryostatRegion->AddRootLogicalVolume(m_pOuterCryostatLogicalVolume);
+
+	//================================== liquid and gaseous xenon ======================
+	G4Region *pLXeRegion = new G4Region("LXe");
+	pLXeRegion->AddRootLogicalVolume(m_pGXeLogicalVolume);
+
+	//================================== TPC, field cage and photosensors ==============
+	G4Region *pTPCRegion = new G4Region("TPC");
+	pTPCRegion->AddRootLogicalVolume(m_pTPCLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pBellLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pTopGridsRingLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pBottomGridsRingLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pGridMeshLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pQUPIDWindowLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pQUPIDBodyLogicalVolume);
+	pTPCRegion->AddRootLogicalVolume(m_pQUPIDBaseLogicalVolume);
+
+	// regions without a cut of their own use the default cut of the physics list
+	map<G4String, G4double>::iterator pIt;
+
+	for(pIt = m_hRegionCuts.begin(); pIt != m_hRegionCuts.end(); pIt++)
+		ApplyRegionCut(pIt->first);
+
+	for(pIt = m_hRegionMaxSteps.begin(); pIt != m_hRegionMaxSteps.end(); pIt++)
+		ApplyRegionMaxStep(pIt->first);
+}
+
+void
+DARWINDetectorConstruction::SetRegionCut(const G4String &hRegionName, G4double dCut)
+{
+	m_hRegionCuts[hRegionName] = dCut;
+
+	// regions already built, change the cut right away
+	if(G4RegionStore::GetInstance()->GetRegion(hRegionName, false))
+		ApplyRegionCut(hRegionName);
+}
+
+void
+DARWINDetectorConstruction::SetRegionMaxStep(const G4String &hRegionName, G4double dMaxStep)
+{
+	m_hRegionMaxSteps[hRegionName] = dMaxStep;
+
+	if(G4RegionStore::GetInstance()->GetRegion(hRegionName, false))
+		ApplyRegionMaxStep(hRegionName);
+}
+
+void
+DARWINDetectorConstruction::ApplyRegionCut(const G4String &hRegionName)
+{
+	G4Region *pRegion = G4RegionStore::GetInstance()->GetRegion(hRegionName, false);
+
+	if(!pRegion)
+	{
+		G4cout << "Error: region " << hRegionName << " not found!" << G4endl;
+		return;
+	}
+
+	G4ProductionCuts *pCuts = pRegion->GetProductionCuts();
+	if(!pCuts)
+	{
+		pCuts = new G4ProductionCuts();
+		pRegion->SetProductionCuts(pCuts);
+	}
+
+	pCuts->SetProductionCut(m_hRegionCuts[hRegionName]);
+
+	G4cout << "----> Setting production cut in region " << hRegionName << " to " << m_hRegionCuts[hRegionName]/mm << " mm" << G4endl;
+}
+
+void
+DARWINDetectorConstruction::ApplyRegionMaxStep(const G4String &hRegionName)
+{
+	G4Region *pRegion = G4RegionStore::GetInstance()->GetRegion(hRegionName, false);
+
+	if(!pRegion)
+	{
+		G4cout << "Error: region " << hRegionName << " not found!" << G4endl;
+		return;
+	}
+
+	G4UserLimits *pUserLimits = pRegion->GetUserLimits();
+	if(!pUserLimits)
+	{
+		pUserLimits = new G4UserLimits();
+		pRegion->SetUserLimits(pUserLimits);
+	}
+
+	pUserLimits->SetMaxAllowedStep(m_hRegionMaxSteps[hRegionName]);
+
+	G4cout << "----> Setting maximum step in region " << hRegionName << " to " << m_hRegionMaxSteps[hRegionName]/mm << " mm" << G4endl;
+}
+
 /*
 void
 DARWINDetectorConstruction::CheckOverlapping()
@@ -2,6 +2,8 @@
 #include <G4RotationMatrix.hh>
 #include <G4ParticleTable.hh>
 #include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
 #include <G4UIcmdWithoutParameter.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithADoubleAndUnit.hh>
@@ -50,6 +52,54 @@ DARWINDetectorMessenger::DARWINDetectorMessenger(DARWINDetectorConstruction *pXe
 	m_pLXeRayScatterLengthCmd->SetUnitCategory("Length");
 	m_pLXeRayScatterLengthCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 
+	m_pCutsDir = new G4UIdirectory("/Xe/cuts/");
+	m_pCutsDir->SetGuidance("production cuts and step limits per region.");
+
+	m_pWaterCutCmd = new G4UIcmdWithADoubleAndUnit("/Xe/cuts/Water", this);
+	m_pWaterCutCmd->SetGuidance("Set the production cut (range) in the water shield and water tank.");
+	m_pWaterCutCmd->SetParameterName("Cut", false);
+	m_pWaterCutCmd->SetRange("Cut > 0.");
+	m_pWaterCutCmd->SetUnitCategory("Length");
+	m_pWaterCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pCryostatCutCmd = new G4UIcmdWithADoubleAndUnit("/Xe/cuts/Cryostat", this);
+	m_pCryostatCutCmd->SetGuidance("Set the production cut (range) in the cryostat shells and vacuum.");
+	m_pCryostatCutCmd->SetParameterName("Cut", false);
+	m_pCryostatCutCmd->SetRange("Cut > 0.");
+	m_pCryostatCutCmd->SetUnitCategory("Length");
+	m_pCryostatCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pTPCCutCmd = new G4UIcmdWithADoubleAndUnit("/Xe/cuts/TPC", this);
+	m_pTPCCutCmd->SetGuidance("Set the production cut (range) in the TPC, bell, field cage and QUPIDs.");
+	m_pTPCCutCmd->SetParameterName("Cut", false);
+	m_pTPCCutCmd->SetRange("Cut > 0.");
+	m_pTPCCutCmd->SetUnitCategory("Length");
+	m_pTPCCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pLXeCutCmd = new G4UIcmdWithADoubleAndUnit("/Xe/cuts/LXe", this);
+	m_pLXeCutCmd->SetGuidance("Set the production cut (range) in the liquid and gaseous xenon.");
+	m_pLXeCutCmd->SetParameterName("Cut", false);
+	m_pLXeCutCmd->SetRange("Cut > 0.");
+	m_pLXeCutCmd->SetUnitCategory("Length");
+	m_pLXeCutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pMaxStepCmd = new G4UIcommand("/Xe/cuts/setMaxStep", this);
+	m_pMaxStepCmd->SetGuidance("Limit the step length in a region.");
+	m_pMaxStepCmd->SetGuidance("  usage: /Xe/cuts/setMaxStep Region Value Unit");
+
+	G4UIparameter *pRegionParameter = new G4UIparameter("Region", 's', false);
+	pRegionParameter->SetParameterCandidates("Water Cryostat TPC LXe");
+	m_pMaxStepCmd->SetParameter(pRegionParameter);
+
+	G4UIparameter *pMaxStepParameter = new G4UIparameter("MaxStep", 'd', false);
+	pMaxStepParameter->SetParameterRange("MaxStep > 0.");
+	m_pMaxStepCmd->SetParameter(pMaxStepParameter);
+
+	G4UIparameter *pUnitParameter = new G4UIparameter("Unit", 's', true);
+	pUnitParameter->SetDefaultValue("mm");
+	m_pMaxStepCmd->SetParameter(pUnitParameter);
+
+	m_pMaxStepCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 }
 
 DARWINDetectorMessenger::~DARWINDetectorMessenger()
@@ -59,7 +109,13 @@ DARWINDetectorMessenger::~DARWINDetectorMessenger()
 	delete m_pLXeAbsorbtionLengthCmd;
 	delete m_pLXeRayScatterLengthCmd;
 
+	delete m_pWaterCutCmd;
+	delete m_pCryostatCutCmd;
+	delete m_pTPCCutCmd;
+	delete m_pLXeCutCmd;
+	delete m_pMaxStepCmd;
 
+	delete m_pCutsDir;
 	delete m_pDetectorDir;
 }
 
@@ -77,6 +133,29 @@ void DARWINDetectorMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNew
 
 		if(pUIcommand == m_pLXeRayScatterLengthCmd)
 			m_pXeDetector->SetLXeRayScatterLength(m_pLXeRayScatterLengthCmd->GetNewDoubleValue(hNewValue));
+
+		if(pUIcommand == m_pWaterCutCmd)
+			m_pXeDetector->SetRegionCut("Water", m_pWaterCutCmd->GetNewDoubleValue(hNewValue));
+
+		if(pUIcommand == m_pCryostatCutCmd)
+			m_pXeDetector->SetRegionCut("Cryostat", m_pCryostatCutCmd->GetNewDoubleValue(hNewValue));
+
+		if(pUIcommand == m_pTPCCutCmd)
+			m_pXeDetector->SetRegionCut("TPC", m_pTPCCutCmd->GetNewDoubleValue(hNewValue));
+
+		if(pUIcommand == m_pLXeCutCmd)
+			m_pXeDetector->SetRegionCut("LXe", m_pLXeCutCmd->GetNewDoubleValue(hNewValue));
+
+		if(pUIcommand == m_pMaxStepCmd)
+		{
+			G4Tokenizer hNextToken(hNewValue);
+
+			G4String hRegionName = hNextToken();
+			G4double dMaxStep = StoD(hNextToken());
+			G4String hUnit = hNextToken();
+
+			m_pXeDetector->SetRegionMaxStep(hRegionName, dMaxStep*G4UIcommand::ValueOf(hUnit));
+		}
 		
 		
 
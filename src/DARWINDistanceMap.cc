@@ -0,0 +1,99 @@
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VSolid.hh>
+#include <G4Timer.hh>
+
+#include <cmath>
+#include <cfloat>
+
+#include "DARWINDistanceMap.hh"
+
+DARWINDistanceMap::DARWINDistanceMap()
+{
+	m_dVoxelSize = 0.;
+	m_iNbX = m_iNbY = m_iNbZ = 0;
+}
+
+DARWINDistanceMap::~DARWINDistanceMap()
+{
+}
+
+G4bool
+DARWINDistanceMap::Build(G4VPhysicalVolume *pWorld, const G4String &hTargetName, G4double dVoxelSize,
+	const G4ThreeVector &hMin, const G4ThreeVector &hMax)
+{
+	G4VPhysicalVolume *pTarget = 0;
+	G4AffineTransform hTargetTransform;
+
+	if(!pWorld || !FindVolume(pWorld, hTargetName, G4AffineTransform(), pTarget, hTargetTransform))
+	{
+		G4cout << "Error: distance map target volume " << hTargetName << " not found!" << G4endl;
+		return false;
+	}
+
+	G4Timer hTimer;
+	hTimer.Start();
+
+	const G4VSolid *pSolid = pTarget->GetLogicalVolume()->GetSolid();
+	const G4AffineTransform hGlobalToLocal = hTargetTransform.Inverse();
+
+	m_hMin = hMin;
+	m_dVoxelSize = dVoxelSize;
+	m_iNbX = (G4int) std::ceil((hMax.x()-hMin.x())/dVoxelSize);
+	m_iNbY = (G4int) std::ceil((hMax.y()-hMin.y())/dVoxelSize);
+	m_iNbZ = (G4int) std::ceil((hMax.z()-hMin.z())/dVoxelSize);
+
+	m_hDistances.assign((size_t) m_iNbX*m_iNbY*m_iNbZ, 0.);
+
+	// DistanceToIn(p) is an underestimate of the true distance, removing the half
+	// diagonal of the voxel keeps the value a lower bound for the whole voxel
+	const G4double dHalfDiagonal = 0.5*std::sqrt(3.)*dVoxelSize;
+
+	for(G4int iZ=0; iZ<m_iNbZ; iZ++)
+		for(G4int iY=0; iY<m_iNbY; iY++)
+			for(G4int iX=0; iX<m_iNbX; iX++)
+			{
+				G4ThreeVector hCenter = hMin + G4ThreeVector((iX+0.5)*dVoxelSize, (iY+0.5)*dVoxelSize, (iZ+0.5)*dVoxelSize);
+				G4ThreeVector hLocal = hGlobalToLocal.TransformPoint(hCenter);
+
+				G4double dDistance = (pSolid->Inside(hLocal) == kOutside)?(pSolid->DistanceToIn(hLocal)):(0.);
+
+				m_hDistances[(iZ*m_iNbY + iY)*m_iNbX + iX] = (float) std::max(0., dDistance - dHalfDiagonal);
+			}
+
+	hTimer.Stop();
+
+	G4cout << "----> Distance map to " << hTargetName << ": " << m_iNbX << "x" << m_iNbY << "x" << m_iNbZ
+		<< " voxels of " << dVoxelSize/cm << " cm, " << m_hDistances.size()*sizeof(float)/1048576. << " MB, built in "
+		<< hTimer.GetRealElapsed() << " s" << G4endl;
+
+	return true;
+}
+
+G4bool
+DARWINDistanceMap::FindVolume(G4VPhysicalVolume *pVolume, const G4String &hName,
+	const G4AffineTransform &hTransform, G4VPhysicalVolume *&pFound, G4AffineTransform &hFoundTransform)
+{
+	if(pVolume->GetName() == hName)
+	{
+		pFound = pVolume;
+		hFoundTransform = hTransform;
+		return true;
+	}
+
+	G4LogicalVolume *pLogicalVolume = pVolume->GetLogicalVolume();
+
+	for(G4int i=0; i<(G4int) pLogicalVolume->GetNoDaughters(); i++)
+	{
+		G4VPhysicalVolume *pDaughter = pLogicalVolume->GetDaughter(i);
+
+		// daughter to mother frame, then mother to world frame
+		G4AffineTransform hDaughterTransform(pDaughter->GetRotation(), pDaughter->GetTranslation());
+
+		if(FindVolume(pDaughter, hName, hDaughterTransform*hTransform, pFound, hFoundTransform))
+			return true;
+	}
+
+	return false;
+}
+
@@ -1,26 +1,26 @@
 #include <G4Event.hh>
+#include <G4RunManager.hh>
+
+#include "DARWINProgressReporter.hh"
+#include "DARWINRunAction.hh"
 
 #include "DARWINEventAction.hh"
 
-DARWINEventAction::DARWINEventAction(DARWINAnalysisManager *pAnalysisManager)
+DARWINEventAction::DARWINEventAction(DARWINAnalysisManager *pAnalysisManager, DARWINProgressReporter *pProgressReporter)
 {
 	m_pAnalysisManager = pAnalysisManager;
+
+	m_pProgressReporter = pProgressReporter;
 }
 
 DARWINEventAction::~DARWINEventAction()
 {
+
 }
 
 void
 DARWINEventAction::BeginOfEventAction(const G4Event *pEvent)
 {
-	if(pEvent->GetEventID() % 10000 == 0)
-	{
-		G4cout << G4endl;
-		G4cout << "------ Begin event " << pEvent->GetEventID()
-			<< "------" << G4endl;
-	}
-	
 	if(m_pAnalysisManager)
 		m_pAnalysisManager->BeginOfEvent(pEvent);
 }
@@ -29,6 +29,16 @@ void DARWINEventAction::EndOfEventAction(const G4Event *pEvent)
 {
 	if(m_pAnalysisManager)
 		m_pAnalysisManager->EndOfEvent(pEvent);
+
+	if(m_pProgressReporter)
+		m_pProgressReporter->EndOfEvent(pEvent);
+
+	if(DARWINRunAction::GetPendingSignal())
+	{
+		// soft abort, the run ends after this event and EndOfRun writes the file
+		G4cout << "----> Signal " << DARWINRunAction::GetPendingSignal() << ", aborting the run after event " << pEvent->GetEventID() << G4endl;
+		G4RunManager::GetRunManager()->AbortRun(true);
+	}
 }
 
 
@@ -3,11 +3,21 @@
 DARWINEventData::DARWINEventData()
 {
 	m_iEventId = 0;
+	m_iChainId = 0;
+	m_dChainTime = 0.;
+	m_fWeight = 1.;
 	m_iNbTopPmtHits = 0;
 	m_iNbBottomPmtHits = 0;
 	m_iNbLSPmtHits = 0;
 	m_iNbWaterPmtHits = 0;
 	m_pPmtHits = new vector<int>;
+	m_pPmtHitId = new vector<int>;
+	m_pPmtHitCount = new vector<int>;
+	m_pPmtHitTime = new vector<float>;
+	m_pPmtTimeId = new vector<int>;
+	m_pPmtTimeN = new vector<unsigned short>;
+	m_pPmtTimes = new vector<unsigned short>;
+	m_dPmtTime0 = 0.;
 
 	m_fTotalEnergyDeposited = 0.;
 	m_iNbSteps = 0;
@@ -15,7 +25,6 @@ DARWINEventData::DARWINEventData()
 	m_pTrackId = new vector<int>;
 	m_pParentId = new vector<int>;
 	m_pParticleType = new vector<string>;
-	m_pParticlePdg = new vector<int>;
 	m_pParentType = new vector<string>;
 	m_pCreatorProcess = new vector<string>;
 	m_pDepositingProcess = new vector<string>;
@@ -23,40 +32,51 @@ DARWINEventData::DARWINEventData()
 	m_pY = new vector<float>;
 	m_pZ = new vector<float>;
 	m_pEnergyDeposited = new vector<float>;
-	m_pKineticEnergy = new vector<float>;
 	m_pTime = new vector<float>;
 	m_pNr = new vector<int>;
+	m_pClusterX = new vector<float>;
+	m_pClusterY = new vector<float>;
+	m_pClusterZ = new vector<float>;
+	m_pClusterNrEnergy = new vector<float>;
+	m_pClusterErEnergy = new vector<float>;
+	m_pClusterEeEnergy = new vector<float>;
+	m_pS2PmtHits = new vector<int>;
+	m_pS2Electrons = new vector<int>;
+	m_pS2Time = new vector<float>;
+	m_pS2Width = new vector<float>;
+	m_pStepTrackIndex = new vector<int>;
+	m_pTrackTableId = new vector<int>;
+	m_pTrackTableParentId = new vector<int>;
+	m_pTrackTablePdg = new vector<int>;
+	m_pTrackTableCreatorProcess = new vector<string>;
+	m_pTrackTableX = new vector<float>;
+	m_pTrackTableY = new vector<float>;
+	m_pTrackTableZ = new vector<float>;
+	m_pTrackTableEnergy = new vector<float>;
 
 	m_pPrimaryParticleType = new vector<string>;
 	m_fPrimaryX = 0.;
 	m_fPrimaryY = 0.;
 	m_fPrimaryZ = 0.;	
-	m_fPrimaryCx = 0.;
-	m_fPrimaryCy = 0.;
-	m_fPrimaryCz = 0.;	
 	m_fPrimaryE = 0.;	
 
-	m_iNSave = 0;
-	m_pSave_flag = new vector<int>;
-	m_pSave_type = new vector<int>;
-	m_pSave_x = new vector<float>;
-	m_pSave_y = new vector<float>;
-	m_pSave_z = new vector<float>;
-	m_pSave_cx = new vector<float>;
-	m_pSave_cy = new vector<float>;
-	m_pSave_cz = new vector<float>;
-	m_pSave_e = new vector<float>;
-
-	m_iTotOptPhot = 0;
+	m_iColumns = kStepTrackColumns;
+	m_lStepCapacity = 0;
+	m_lTrackCapacity = 0;
 }
 
 DARWINEventData::~DARWINEventData()
 {
 	delete m_pPmtHits;
+	delete m_pPmtHitId;
+	delete m_pPmtHitCount;
+	delete m_pPmtHitTime;
+	delete m_pPmtTimeId;
+	delete m_pPmtTimeN;
+	delete m_pPmtTimes;
 	delete m_pTrackId;
 	delete m_pParentId;
 	delete m_pParticleType;
-	delete m_pParticlePdg;
 	delete m_pParentType;
 	delete m_pCreatorProcess;
 	delete m_pDepositingProcess;
@@ -64,72 +84,167 @@ DARWINEventData::~DARWINEventData()
 	delete m_pY;
 	delete m_pZ;
 	delete m_pEnergyDeposited;
-	delete m_pKineticEnergy;
 	delete m_pTime;
 	delete m_pNr;
+	delete m_pClusterX;
+	delete m_pClusterY;
+	delete m_pClusterZ;
+	delete m_pClusterNrEnergy;
+	delete m_pClusterErEnergy;
+	delete m_pClusterEeEnergy;
+	delete m_pS2PmtHits;
+	delete m_pS2Electrons;
+	delete m_pS2Time;
+	delete m_pS2Width;
+	delete m_pStepTrackIndex;
+	delete m_pTrackTableId;
+	delete m_pTrackTableParentId;
+	delete m_pTrackTablePdg;
+	delete m_pTrackTableCreatorProcess;
+	delete m_pTrackTableX;
+	delete m_pTrackTableY;
+	delete m_pTrackTableZ;
+	delete m_pTrackTableEnergy;
 
 	delete m_pPrimaryParticleType;
+}
+
+void
+DARWINEventData::SetColumns(int iColumns)
+{
+	// columns dropped by the new layout are emptied once here
+	m_iColumns = kStepTrackColumns | kTrackTableColumns | kRecoilColumns;
+	Clear();
 
-	delete m_pSave_flag ;
-	delete m_pSave_type ;
-	delete m_pSave_x ;
-	delete m_pSave_y ;
-	delete m_pSave_z ;
-	delete m_pSave_cx ;
-	delete m_pSave_cy ;
-	delete m_pSave_cz ;
-	delete m_pSave_e ;
+	m_iColumns = iColumns;
+}
+
+void
+DARWINEventData::ReserveSteps(size_t lNbSteps)
+{
+	if(lNbSteps <= m_lStepCapacity)
+		return;
+
+	m_lStepCapacity = lNbSteps + lNbSteps/2;
+
+	if(m_iColumns & kStepTrackColumns)
+	{
+		m_pTrackId->reserve(m_lStepCapacity);
+		m_pParentId->reserve(m_lStepCapacity);
+		m_pParticleType->reserve(m_lStepCapacity);
+		m_pParentType->reserve(m_lStepCapacity);
+		m_pCreatorProcess->reserve(m_lStepCapacity);
+	}
+
+	if(m_iColumns & kTrackTableColumns)
+		m_pStepTrackIndex->reserve(m_lStepCapacity);
+
+	if(m_iColumns & kRecoilColumns)
+		m_pNr->reserve(m_lStepCapacity);
+
+	m_pDepositingProcess->reserve(m_lStepCapacity);
+	m_pX->reserve(m_lStepCapacity);
+	m_pY->reserve(m_lStepCapacity);
+	m_pZ->reserve(m_lStepCapacity);
+	m_pEnergyDeposited->reserve(m_lStepCapacity);
+	m_pTime->reserve(m_lStepCapacity);
+}
+
+void
+DARWINEventData::ReserveTracks(size_t lNbTracks)
+{
+	if(lNbTracks <= m_lTrackCapacity || !(m_iColumns & kTrackTableColumns))
+		return;
+
+	m_lTrackCapacity = lNbTracks + lNbTracks/2;
+
+	m_pTrackTableId->reserve(m_lTrackCapacity);
+	m_pTrackTableParentId->reserve(m_lTrackCapacity);
+	m_pTrackTablePdg->reserve(m_lTrackCapacity);
+	m_pTrackTableCreatorProcess->reserve(m_lTrackCapacity);
+	m_pTrackTableX->reserve(m_lTrackCapacity);
+	m_pTrackTableY->reserve(m_lTrackCapacity);
+	m_pTrackTableZ->reserve(m_lTrackCapacity);
+	m_pTrackTableEnergy->reserve(m_lTrackCapacity);
 }
 
 void
 DARWINEventData::Clear()
 {
 	m_iEventId = 0;
+	m_iChainId = 0;
+	m_dChainTime = 0.;
+	m_fWeight = 1.;
 	m_iNbTopPmtHits = 0;
 	m_iNbBottomPmtHits = 0;
 	m_iNbLSPmtHits = 0;
 	m_iNbWaterPmtHits = 0;
 
+	// clear() keeps the capacity, the numeric columns are only allocated while they
+	// grow, the strings of the string columns (type, parenttype, creaproc, edproc,
+	// trk_creaproc) are freed here and names longer than the short string buffer
+	// (e.g. RadioactiveDecay) are allocated again with every push_back
 	m_pPmtHits->clear();
+	m_pPmtHitId->clear();
+	m_pPmtHitCount->clear();
+	m_pPmtHitTime->clear();
+	m_pPmtTimeId->clear();
+	m_pPmtTimeN->clear();
+	m_pPmtTimes->clear();
+	m_dPmtTime0 = 0.;
 
 	m_fTotalEnergyDeposited = 0.0;
 	m_iNbSteps = 0;
 
-	m_pTrackId->clear();
-	m_pParentId->clear();
-	m_pParticleType->clear();
-	m_pParticlePdg->clear();
-	m_pParentType->clear();
-	m_pCreatorProcess->clear();
+	if(m_iColumns & kStepTrackColumns)
+	{
+		m_pTrackId->clear();
+		m_pParentId->clear();
+		m_pParticleType->clear();
+		m_pParentType->clear();
+		m_pCreatorProcess->clear();
+	}
+
 	m_pDepositingProcess->clear();
 	m_pX->clear();
 	m_pY->clear();
 	m_pZ->clear();
 	m_pEnergyDeposited->clear();
-	m_pKineticEnergy->clear();
 	m_pTime->clear();
-	m_pNr->clear();
+
+	if(m_iColumns & kRecoilColumns)
+	{
+		m_pNr->clear();
+		m_pClusterX->clear();
+		m_pClusterY->clear();
+		m_pClusterZ->clear();
+		m_pClusterNrEnergy->clear();
+		m_pClusterErEnergy->clear();
+		m_pClusterEeEnergy->clear();
+	}
+
+	m_pS2PmtHits->clear();
+	m_pS2Electrons->clear();
+	m_pS2Time->clear();
+	m_pS2Width->clear();
+
+	if(m_iColumns & kTrackTableColumns)
+	{
+		m_pStepTrackIndex->clear();
+		m_pTrackTableId->clear();
+		m_pTrackTableParentId->clear();
+		m_pTrackTablePdg->clear();
+		m_pTrackTableCreatorProcess->clear();
+		m_pTrackTableX->clear();
+		m_pTrackTableY->clear();
+		m_pTrackTableZ->clear();
+		m_pTrackTableEnergy->clear();
+	}
 
 	m_pPrimaryParticleType->clear();
 	m_fPrimaryX = 0.;
 	m_fPrimaryY = 0.;
 	m_fPrimaryZ = 0.;	
-	m_fPrimaryCx = 0.;
-	m_fPrimaryCy = 0.;
-	m_fPrimaryCz = 0.;	
 	m_fPrimaryE = 0.;	
-
-	m_iNSave = 0;
-	m_pSave_flag->clear();
-	m_pSave_type->clear();
-	m_pSave_x->clear(); 
-	m_pSave_y->clear(); 
-	m_pSave_z->clear(); 
-	m_pSave_cx->clear(); 
-	m_pSave_cy->clear(); 
-	m_pSave_cz->clear(); 
-	m_pSave_e->clear();
-
-	m_iTotOptPhot = 0;
 }
 
@@ -0,0 +1,443 @@
+#include <G4Event.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4PrimaryParticle.hh>
+#include <G4ParticleTable.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4IonTable.hh>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "DARWINEventFileReader.hh"
+
+static const char g_pBinaryFileMagic[8] = {'D', 'A', 'R', 'W', 'I', 'N', 'E', 'V'};
+static const char g_pBinaryRecordMarker[4] = {'E', 'V', 'T', '1'};
+
+// marker, number of particles, x, y, z, t, weight
+static const size_t g_lBinaryRecordHeaderSize = 4 + 4 + 5*8;
+// pdg code, status, px, py, pz
+static const size_t g_lBinaryParticleSize = 4 + 4 + 3*8;
+static const G4int g_iMaxParticlesPerRecord = 100000;
+
+DARWINEventFileReader::DARWINEventFileReader()
+{
+	m_bBinary = false;
+
+	m_iFileDescriptor = -1;
+	m_pData = 0;
+	m_lSize = 0;
+
+	m_iPartition = 0;
+	m_iNbPartitions = 1;
+	m_pCursor = 0;
+	m_pPartitionEnd = 0;
+
+	m_hOffset = G4ThreeVector(0., 0., 0.);
+	m_lNbRecordsRead = 0;
+}
+
+DARWINEventFileReader::~DARWINEventFileReader()
+{
+	Close();
+}
+
+G4bool
+DARWINEventFileReader::Open(const G4String &hFileName, const G4String &hFormat)
+{
+	Close();
+
+	m_iFileDescriptor = open(hFileName.c_str(), O_RDONLY);
+
+	struct stat hStat;
+	if(m_iFileDescriptor < 0 || fstat(m_iFileDescriptor, &hStat) != 0 || hStat.st_size == 0)
+	{
+		G4cout << "Error: cannot open event file " << hFileName << "!" << G4endl;
+		Close();
+		return false;
+	}
+
+	m_lSize = (size_t) hStat.st_size;
+
+	void *pMap = mmap(0, m_lSize, PROT_READ, MAP_PRIVATE, m_iFileDescriptor, 0);
+	if(pMap == MAP_FAILED)
+	{
+		G4cout << "Error: cannot map event file " << hFileName << "!" << G4endl;
+		Close();
+		return false;
+	}
+
+	// records are read once, in order
+	madvise(pMap, m_lSize, MADV_SEQUENTIAL);
+
+	m_pData = (const char *) pMap;
+	m_hFileName = hFileName;
+
+	G4bool bHasMagic = m_lSize >= sizeof(g_pBinaryFileMagic) && !memcmp(m_pData, g_pBinaryFileMagic, sizeof(g_pBinaryFileMagic));
+
+	if(hFormat == "binary" && !bHasMagic)
+	{
+		G4cout << "Error: " << hFileName << " is not a binary event file!" << G4endl;
+		Close();
+		return false;
+	}
+
+	m_bBinary = (hFormat == "binary") || (hFormat == "auto" && bHasMagic);
+
+	Rewind();
+
+	G4cout << "----> Event file " << hFileName << ": " << m_lSize/1048576. << " MB, "
+		<< ((m_bBinary)?("binary"):("text")) << ", partition " << m_iPartition << "/" << m_iNbPartitions << G4endl;
+
+	return true;
+}
+
+void
+DARWINEventFileReader::Close()
+{
+	if(m_pData)
+		munmap((void *) m_pData, m_lSize);
+
+	if(m_iFileDescriptor >= 0)
+		close(m_iFileDescriptor);
+
+	m_iFileDescriptor = -1;
+	m_pData = 0;
+	m_lSize = 0;
+	m_pCursor = 0;
+	m_pPartitionEnd = 0;
+}
+
+void
+DARWINEventFileReader::SetPartition(G4int iIndex, G4int iNbPartitions)
+{
+	if(iNbPartitions < 1 || iIndex < 0 || iIndex >= iNbPartitions)
+	{
+		G4cout << "Error: invalid event file partition " << iIndex << "/" << iNbPartitions << "!" << G4endl;
+		return;
+	}
+
+	m_iPartition = iIndex;
+	m_iNbPartitions = iNbPartitions;
+
+	if(IsOpen())
+		Rewind();
+}
+
+void
+DARWINEventFileReader::Rewind()
+{
+	// a record belongs to the partition its header starts in, the boundaries are
+	// moved to the next record start so that partitions never overlap
+	const char *pEnd = m_pData + m_lSize;
+	const char *pBegin = m_pData + m_lSize/m_iNbPartitions*m_iPartition;
+	const char *pNextBegin = m_pData + m_lSize/m_iNbPartitions*(m_iPartition+1);
+
+	if(m_bBinary)
+	{
+		m_pCursor = FindBinaryRecord(pBegin);
+		m_pPartitionEnd = (m_iPartition+1 == m_iNbPartitions)?(pEnd):(FindBinaryRecord(pNextBegin));
+	}
+	else
+	{
+		m_pCursor = FindTextRecord(pBegin);
+		m_pPartitionEnd = (m_iPartition+1 == m_iNbPartitions)?(pEnd):(FindTextRecord(pNextBegin));
+	}
+
+	m_lNbRecordsRead = 0;
+}
+
+void
+DARWINEventFileReader::SetPosition(G4long lPosition, G4long lNbRecordsRead)
+{
+	if(!IsOpen() || lPosition < 0 || m_pData+lPosition > m_pPartitionEnd)
+	{
+		G4cout << "Error: invalid event file position " << lPosition << "!" << G4endl;
+		return;
+	}
+
+	m_pCursor = m_pData+lPosition;
+	m_lNbRecordsRead = lNbRecordsRead;
+}
+
+G4bool
+DARWINEventFileReader::GeneratePrimaryVertex(G4Event *pEvent, G4double &dWeight)
+{
+	dWeight = 1.;
+
+	if(!IsOpen())
+		return false;
+
+	if(m_bBinary)
+		return ReadBinaryRecord(pEvent, dWeight);
+	else
+		return ReadTextRecord(pEvent, dWeight);
+}
+
+// a record header has less fields than a particle line
+const char *
+DARWINEventFileReader::FindTextRecord(const char *pPosition) const
+{
+	const char *pEnd = m_pData + m_lSize;
+
+	// start of the next line
+	if(pPosition != m_pData && *(pPosition-1) != '\n')
+	{
+		const char *pNewLine = (const char *) memchr(pPosition, '\n', pEnd-pPosition);
+		pPosition = (pNewLine)?(pNewLine+1):(pEnd);
+	}
+
+	G4String hLine;
+	G4double pFields[8];
+
+	while(pPosition < pEnd)
+	{
+		const char *pNext = GetLine(pPosition, hLine);
+		G4int iNbFields = GetFields(hLine, pFields, 8);
+
+		if(iNbFields > 0 && iNbFields < 8)
+			return pPosition;
+
+		pPosition = pNext;
+	}
+
+	return pEnd;
+}
+
+const char *
+DARWINEventFileReader::FindBinaryRecord(const char *pPosition) const
+{
+	const char *pEnd = m_pData + m_lSize;
+
+	pPosition = std::max(pPosition, m_pData + sizeof(g_pBinaryFileMagic));
+
+	for(; pPosition + g_lBinaryRecordHeaderSize <= pEnd; pPosition++)
+	{
+		if(IsBinaryRecord(pPosition))
+			return pPosition;
+	}
+
+	return pEnd;
+}
+
+G4bool
+DARWINEventFileReader::IsBinaryRecord(const char *pPosition) const
+{
+	const char *pEnd = m_pData + m_lSize;
+
+	if(pPosition + g_lBinaryRecordHeaderSize > pEnd)
+		return false;
+
+	if(memcmp(pPosition, g_pBinaryRecordMarker, sizeof(g_pBinaryRecordMarker)))
+		return false;
+
+	// a marker in the data is very unlikely to also give a consistent record size
+	int iNbParticles;
+	memcpy(&iNbParticles, pPosition+4, sizeof(iNbParticles));
+
+	return iNbParticles >= 0 && iNbParticles <= g_iMaxParticlesPerRecord
+		&& pPosition + g_lBinaryRecordHeaderSize + iNbParticles*g_lBinaryParticleSize <= pEnd;
+}
+
+G4bool
+DARWINEventFileReader::ReadTextRecord(G4Event *pEvent, G4double &dWeight)
+{
+	const char *pEnd = m_pData + m_lSize;
+
+	G4String hLine;
+	G4double pFields[8];
+
+	while(m_pCursor < m_pPartitionEnd)
+	{
+		const char *pNext = GetLine(m_pCursor, hLine);
+		G4int iNbFields = GetFields(hLine, pFields, 8);
+
+		m_pCursor = pNext;
+
+		// empty line or comment
+		if(iNbFields == 0)
+			continue;
+
+		if(iNbFields == 8)
+		{
+			G4cout << "Error: particle line outside of a record in " << m_hFileName << "!" << G4endl;
+			continue;
+		}
+
+		// header: NHEP [X Y Z [T [W]]]
+		G4int iNbParticles = (G4int) pFields[0];
+		G4ThreeVector hPosition = (iNbFields >= 4)?(G4ThreeVector(pFields[1], pFields[2], pFields[3])*mm):(G4ThreeVector(0., 0., 0.));
+		G4double dTime = (iNbFields >= 5)?(pFields[4]*ns):(0.);
+		dWeight = (iNbFields >= 6)?(pFields[5]):(1.);
+
+		G4PrimaryVertex *pVertex = 0;
+		G4int iNbParticlesRead = 0;
+
+		// particles: ISTHEP IDHEP JDAHEP1 JDAHEP2 PX PY PZ MASS, momenta in GeV
+		for(; iNbParticlesRead<iNbParticles && m_pCursor < pEnd; iNbParticlesRead++)
+		{
+			// a line that is not a particle stays for the next record
+			pNext = GetLine(m_pCursor, hLine);
+			if(GetFields(hLine, pFields, 8) < 8)
+				break;
+			m_pCursor = pNext;
+
+			// only final state particles are tracked
+			if((G4int) pFields[0] != 1)
+				continue;
+
+			G4ParticleDefinition *pDefinition = FindParticle((G4int) pFields[1]);
+			if(!pDefinition)
+			{
+				G4cout << "Error: unknown PDG code " << (G4int) pFields[1] << " in " << m_hFileName << "!" << G4endl;
+				continue;
+			}
+
+			if(!pVertex)
+				pVertex = new G4PrimaryVertex(hPosition + m_hOffset, dTime);
+
+			G4PrimaryParticle *pPrimary = new G4PrimaryParticle(pDefinition, pFields[4]*GeV, pFields[5]*GeV, pFields[6]*GeV);
+			pPrimary->SetMass(pDefinition->GetPDGMass());
+			pPrimary->SetCharge(pDefinition->GetPDGCharge());
+
+			pVertex->SetPrimary(pPrimary);
+		}
+
+		// a truncated record is never read, as in the binary format
+		if(iNbParticlesRead < iNbParticles)
+		{
+			G4cout << "Error: truncated record in " << m_hFileName << ", skipped!" << G4endl;
+			delete pVertex;
+			continue;
+		}
+
+		// a record without final state particles gives an event without vertex
+		if(pVertex)
+			pEvent->AddPrimaryVertex(pVertex);
+
+		m_lNbRecordsRead++;
+
+		return true;
+	}
+
+	return false;
+}
+
+G4bool
+DARWINEventFileReader::ReadBinaryRecord(G4Event *pEvent, G4double &dWeight)
+{
+	if(m_pCursor >= m_pPartitionEnd)
+		return false;
+
+	// a truncated or corrupted record is never read, the last one of a truncated file is dropped
+	if(!IsBinaryRecord(m_pCursor))
+	{
+		G4cout << "Error: corrupted record in " << m_hFileName << ", skipping to the next one!" << G4endl;
+
+		m_pCursor = FindBinaryRecord(m_pCursor+1);
+
+		if(m_pCursor >= m_pPartitionEnd)
+			return false;
+	}
+
+	// header: marker, number of particles, x y z (mm), t (ns), weight
+	int iNbParticles;
+	double pHeader[5];
+
+	memcpy(&iNbParticles, m_pCursor+4, sizeof(iNbParticles));
+	memcpy(pHeader, m_pCursor+8, sizeof(pHeader));
+
+	G4ThreeVector hPosition(pHeader[0]*mm, pHeader[1]*mm, pHeader[2]*mm);
+	dWeight = pHeader[4];
+
+	const char *pParticle = m_pCursor + g_lBinaryRecordHeaderSize;
+	G4PrimaryVertex *pVertex = 0;
+
+	// particles: pdg code, status, px py pz (MeV)
+	for(G4int i=0; i<iNbParticles; i++, pParticle += g_lBinaryParticleSize)
+	{
+		int pCodes[2];
+		double pMomentum[3];
+
+		memcpy(pCodes, pParticle, sizeof(pCodes));
+		memcpy(pMomentum, pParticle+8, sizeof(pMomentum));
+
+		if(pCodes[1] != 1)
+			continue;
+
+		G4ParticleDefinition *pDefinition = FindParticle(pCodes[0]);
+		if(!pDefinition)
+		{
+			G4cout << "Error: unknown PDG code " << pCodes[0] << " in " << m_hFileName << "!" << G4endl;
+			continue;
+		}
+
+		if(!pVertex)
+			pVertex = new G4PrimaryVertex(hPosition + m_hOffset, pHeader[3]*ns);
+
+		G4PrimaryParticle *pPrimary = new G4PrimaryParticle(pDefinition, pMomentum[0]*MeV, pMomentum[1]*MeV, pMomentum[2]*MeV);
+		pPrimary->SetMass(pDefinition->GetPDGMass());
+		pPrimary->SetCharge(pDefinition->GetPDGCharge());
+
+		pVertex->SetPrimary(pPrimary);
+	}
+
+	if(pVertex)
+		pEvent->AddPrimaryVertex(pVertex);
+
+	m_pCursor = pParticle;
+	m_lNbRecordsRead++;
+
+	return true;
+}
+
+const char *
+DARWINEventFileReader::GetLine(const char *pPosition, G4String &hLine) const
+{
+	const char *pEnd = m_pData + m_lSize;
+	const char *pNewLine = (const char *) memchr(pPosition, '\n', pEnd-pPosition);
+	const char *pLineEnd = (pNewLine)?(pNewLine):(pEnd);
+
+	hLine.assign(pPosition, pLineEnd-pPosition);
+
+	return (pNewLine)?(pNewLine+1):(pEnd);
+}
+
+// number of leading numeric fields, up to iMaxFields, comments start with #
+G4int
+DARWINEventFileReader::GetFields(const G4String &hLine, G4double *pFields, G4int iMaxFields)
+{
+	const char *pPosition = hLine.c_str();
+	G4int iNbFields = 0;
+
+	while(iNbFields < iMaxFields)
+	{
+		char *pFieldEnd;
+		G4double dValue = strtod(pPosition, &pFieldEnd);
+
+		if(pFieldEnd == pPosition)
+			break;
+
+		pFields[iNbFields++] = dValue;
+		pPosition = pFieldEnd;
+	}
+
+	return iNbFields;
+}
+
+G4ParticleDefinition *
+DARWINEventFileReader::FindParticle(G4int iPdgCode)
+{
+	G4ParticleDefinition *pDefinition = G4ParticleTable::GetParticleTable()->FindParticle(iPdgCode);
+
+	// nuclei, 10LZZZAAAI
+	if(!pDefinition && iPdgCode > 1000000000)
+		pDefinition = G4IonTable::GetIonTable()->GetIon((iPdgCode/10000)%1000, (iPdgCode/10)%1000, 0.);
+
+	return pDefinition;
+}
+
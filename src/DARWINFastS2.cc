@@ -0,0 +1,359 @@
+#include <G4UIcommand.hh>
+#include <G4Poisson.hh>
+#include <Randomize.hh>
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sys/stat.h>
+
+#include "DARWINDetectorConstruction.hh"
+#include "DARWINQuenchingModel.hh"
+#include "DARWINFastS2Messenger.hh"
+
+#include "DARWINFastS2.hh"
+
+using std::ifstream;
+using std::ofstream;
+
+static const char g_pFastS2CacheMagic[8] = {'D', 'A', 'R', 'W', 'I', 'N', 'S', '2'};
+
+DARWINFastS2::DARWINFastS2()
+{
+	m_bEnabled = false;
+
+	m_dElectronLifetime = 1.*ms;
+	m_dDriftVelocity = 1.5*mm/microsecond;
+	m_dLongitudinalDiffusion = 25.*cm2/s;
+	m_dTransverseDiffusion = 50.*cm2/s;
+	m_dChargeYield = 30./keV;
+	m_dExtractionEfficiency = 0.95;
+	m_dElectroluminescenceYield = 300.;
+	m_dLiquidSurfaceZ = 0.;
+	m_bLiquidSurfaceSet = false;
+	m_dDriftLength = 0.;
+	m_iNbElectronGroups = 100;
+
+	m_lMapModificationTime = 0;
+	m_iNbMapPmts = 0;
+	m_iNbX = m_iNbY = 0;
+	m_dXMin = m_dXMax = m_dYMin = m_dYMax = 0.;
+
+	m_pMessenger = new DARWINFastS2Messenger(this);
+}
+
+DARWINFastS2::~DARWINFastS2()
+{
+	delete m_pMessenger;
+}
+
+G4bool
+DARWINFastS2::LoadMap(const G4String &hFilename)
+{
+	struct stat hStat;
+
+	if(stat(hFilename.c_str(), &hStat))
+	{
+		G4cout << "Error: cannot open S2 map file " << hFilename << "!" << G4endl;
+		return false;
+	}
+
+	// already in memory
+	if(hFilename == m_hMapFilename && (long) hStat.st_mtime == m_lMapModificationTime)
+		return true;
+
+	m_hMapFilename = "";
+	m_hMap.clear();
+
+	if(!ReadMapCache(hFilename))
+	{
+		if(!ReadMapText(hFilename))
+			return false;
+
+		WriteMapCache(hFilename);
+	}
+
+	m_hMapFilename = hFilename;
+	m_lMapModificationTime = (long) hStat.st_mtime;
+
+	G4cout << "----> S2 map " << hFilename << ": " << m_iNbMapPmts << " pmts, " << m_iNbX << "x" << m_iNbY << " bins, "
+		<< m_hMap.size()*sizeof(float)/1048576. << " MB" << G4endl;
+
+	return true;
+}
+
+G4bool
+DARWINFastS2::ReadMapText(const G4String &hFilename)
+{
+	ifstream hIn(hFilename.c_str());
+
+	if(hIn.fail())
+	{
+		G4cout << "Error: cannot open S2 map file " << hFilename << "!" << G4endl;
+		return false;
+	}
+
+	// header tags, then the values of each bin
+	G4String hLengthUnit = "mm";
+	m_iNbMapPmts = m_iNbX = m_iNbY = 0;
+
+	while(!hIn.eof())
+	{
+		G4String hHeader;
+		hIn >> hHeader;
+
+		if(hHeader == "pmts:")
+			hIn >> m_iNbMapPmts;
+		else if(hHeader == "x:")
+			hIn >> m_iNbX >> m_dXMin >> m_dXMax;
+		else if(hHeader == "y:")
+			hIn >> m_iNbY >> m_dYMin >> m_dYMax;
+		else if(hHeader == "unit:")
+			hIn >> hLengthUnit;
+		else if(hHeader == "map:")
+			break;
+		else
+		{
+			G4cout << "Error: unknown tag " << hHeader << " in S2 map file!" << G4endl;
+			return false;
+		}
+	}
+
+	if(m_iNbMapPmts <= 0 || m_iNbX <= 0 || m_iNbY <= 0 || m_dXMax <= m_dXMin || m_dYMax <= m_dYMin)
+	{
+		G4cout << "Error: incomplete header in S2 map file " << hFilename << "!" << G4endl;
+		return false;
+	}
+
+	G4double dUnit = G4UIcommand::ValueOf(hLengthUnit);
+	m_dXMin *= dUnit;
+	m_dXMax *= dUnit;
+	m_dYMin *= dUnit;
+	m_dYMax *= dUnit;
+
+	m_hMap.resize((size_t) m_iNbX*m_iNbY*m_iNbMapPmts);
+
+	for(size_t i = 0; i < m_hMap.size(); i++)
+	{
+		if(!(hIn >> m_hMap[i]))
+		{
+			G4cout << "Error: S2 map file " << hFilename << " ends after " << i << " of " << m_hMap.size() << " values!" << G4endl;
+			m_hMap.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+G4bool
+DARWINFastS2::ReadMapCache(const G4String &hFilename)
+{
+	G4String hCacheFilename = hFilename+".bin";
+	struct stat hStat, hCacheStat;
+
+	// only a cache newer than the map file is used
+	if(stat(hFilename.c_str(), &hStat) || stat(hCacheFilename.c_str(), &hCacheStat) || hCacheStat.st_mtime < hStat.st_mtime)
+		return false;
+
+	ifstream hIn(hCacheFilename.c_str(), std::ios::binary);
+	char pMagic[sizeof(g_pFastS2CacheMagic)];
+
+	hIn.read(pMagic, sizeof(pMagic));
+	if(!hIn || memcmp(pMagic, g_pFastS2CacheMagic, sizeof(pMagic)))
+		return false;
+
+	hIn.read((char *) &m_iNbMapPmts, sizeof(m_iNbMapPmts));
+	hIn.read((char *) &m_iNbX, sizeof(m_iNbX));
+	hIn.read((char *) &m_iNbY, sizeof(m_iNbY));
+	hIn.read((char *) &m_dXMin, sizeof(m_dXMin));
+	hIn.read((char *) &m_dXMax, sizeof(m_dXMax));
+	hIn.read((char *) &m_dYMin, sizeof(m_dYMin));
+	hIn.read((char *) &m_dYMax, sizeof(m_dYMax));
+
+	if(!hIn || m_iNbMapPmts <= 0 || m_iNbX <= 0 || m_iNbY <= 0)
+		return false;
+
+	m_hMap.resize((size_t) m_iNbX*m_iNbY*m_iNbMapPmts);
+	hIn.read((char *) &m_hMap[0], m_hMap.size()*sizeof(float));
+
+	if(!hIn)
+	{
+		m_hMap.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void
+DARWINFastS2::WriteMapCache(const G4String &hFilename) const
+{
+	G4String hCacheFilename = hFilename+".bin";
+	ofstream hOut(hCacheFilename.c_str(), std::ios::binary | std::ios::trunc);
+
+	// not being able to write the cache only costs time on the next load
+	if(hOut.fail())
+		return;
+
+	hOut.write(g_pFastS2CacheMagic, sizeof(g_pFastS2CacheMagic));
+	hOut.write((const char *) &m_iNbMapPmts, sizeof(m_iNbMapPmts));
+	hOut.write((const char *) &m_iNbX, sizeof(m_iNbX));
+	hOut.write((const char *) &m_iNbY, sizeof(m_iNbY));
+	hOut.write((const char *) &m_dXMin, sizeof(m_dXMin));
+	hOut.write((const char *) &m_dXMax, sizeof(m_dXMax));
+	hOut.write((const char *) &m_dYMin, sizeof(m_dYMin));
+	hOut.write((const char *) &m_dYMax, sizeof(m_dYMax));
+	hOut.write((const char *) &m_hMap[0], m_hMap.size()*sizeof(float));
+}
+
+G4bool
+DARWINFastS2::LoadParameters(const G4String &hFilename)
+{
+	ifstream hIn(hFilename.c_str());
+
+	if(hIn.fail())
+	{
+		G4cout << "Error: cannot open S2 parameter file " << hFilename << "!" << G4endl;
+		return false;
+	}
+
+	// one parameter per line: name value, in the units of readme/fasts2.txt
+	G4String hLine;
+	while(std::getline(hIn, hLine))
+	{
+		std::istringstream hStream(hLine.substr(0, hLine.find('#')));
+		G4String hName;
+		G4double dValue, dValue2;
+
+		if(!(hStream >> hName))
+			continue;
+
+		if(!(hStream >> dValue))
+		{
+			G4cout << "Error: no value for " << hName << " in S2 parameter file!" << G4endl;
+			return false;
+		}
+
+		if(hName == "ElectronLifetime")
+			SetElectronLifetime(dValue*microsecond);
+		else if(hName == "DriftVelocity")
+			SetDriftVelocity(dValue*mm/microsecond);
+		else if(hName == "Diffusion" && hStream >> dValue2)
+			SetDiffusion(dValue*cm2/s, dValue2*cm2/s);
+		else if(hName == "ChargeYield")
+			SetChargeYield(dValue/keV);
+		else if(hName == "ExtractionEfficiency")
+			SetExtractionEfficiency(dValue);
+		else if(hName == "ElectroluminescenceYield")
+			SetElectroluminescenceYield(dValue);
+		else if(hName == "LiquidSurface")
+			SetLiquidSurface(dValue*mm);
+		else if(hName == "ElectronGroups")
+			SetNbElectronGroups((G4int) dValue);
+		else
+		{
+			G4cout << "Error: unknown parameter " << hName << " in S2 parameter file!" << G4endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+G4bool
+DARWINFastS2::Initialize(G4int iNbTopPmts)
+{
+	// drift region from the placed grids, the electrons drift from the cathode up to the surface
+	G4double dGateZ = DARWINDetectorConstruction::GetGeometryParameter("GateZ");
+	G4double dCathodeZ = DARWINDetectorConstruction::GetGeometryParameter("CathodeZ");
+
+	if(!m_bLiquidSurfaceSet)
+		m_dLiquidSurfaceZ = dGateZ;
+
+	m_dDriftLength = m_dLiquidSurfaceZ-dCathodeZ;
+
+	if(m_hMap.empty())
+	{
+		G4cout << "Error: no S2 map loaded, use /Xe/fasts2/setMapFile!" << G4endl;
+		return false;
+	}
+
+	if(m_iNbMapPmts != iNbTopPmts)
+	{
+		G4cout << "Error: the S2 map has " << m_iNbMapPmts << " pmts, the top array " << iNbTopPmts << "!" << G4endl;
+		return false;
+	}
+
+	m_hMeanHits.assign(m_iNbMapPmts, 0.);
+
+	PrintParameters();
+
+	return true;
+}
+
+void
+DARWINFastS2::Simulate(const vector<DARWINClusterer::Cluster> &hClusters, const DARWINQuenchingModel *pQuenchingModel,
+	vector<int> *pPmtHits, vector<int> *pElectrons, vector<float> *pTimes, vector<float> *pWidths)
+{
+	std::fill(m_hMeanHits.begin(), m_hMeanHits.end(), 0.);
+
+	for(vector<DARWINClusterer::Cluster>::const_iterator pIt = hClusters.begin(); pIt != hClusters.end(); pIt++)
+	{
+		G4double dDriftDistance = m_dLiquidSurfaceZ-pIt->hPosition.z();
+
+		// above the surface or below the cathode there is no S2
+		if(dDriftDistance < 0. || dDriftDistance > m_dDriftLength)
+			continue;
+
+		G4double dEnergy = pQuenchingModel->GetElectronEquivalentEnergy(pIt->dNrEnergy, pIt->dEnergy-pIt->dNrEnergy);
+		G4double dDriftTime = dDriftDistance/m_dDriftVelocity;
+
+		// electrons surviving the drift and extracted, in one binomial draw
+		G4long lNbElectrons = G4Poisson(dEnergy*m_dChargeYield);
+		G4double dSurvival = std::exp(-dDriftTime/m_dElectronLifetime)*m_dExtractionEfficiency;
+		G4long lNbExtracted = (lNbElectrons > 0)?(CLHEP::RandBinomial::shoot(lNbElectrons, dSurvival)):(0);
+
+		G4double dSigmaXY = std::sqrt(2.*m_dTransverseDiffusion*dDriftTime);
+		G4double dSigmaT = std::sqrt(2.*m_dLongitudinalDiffusion*dDriftTime)/m_dDriftVelocity;
+
+		pElectrons->push_back(lNbExtracted);
+		pTimes->push_back((pIt->dTime+dDriftTime)/ns);
+		pWidths->push_back(dSigmaT/ns);
+
+		// electrons diffused in groups, the light of each group seen from its position
+		G4long lNbGroups = std::min(lNbExtracted, (G4long) m_iNbElectronGroups);
+		for(G4long i = 0; i < lNbGroups; i++)
+		{
+			G4long lNbGroupElectrons = lNbExtracted/lNbGroups+((i < lNbExtracted%lNbGroups)?(1):(0));
+			G4double dX = pIt->hPosition.x()+CLHEP::RandGauss::shoot(0., dSigmaXY);
+			G4double dY = pIt->hPosition.y()+CLHEP::RandGauss::shoot(0., dSigmaXY);
+
+			const float *pLightCollection = GetLightCollection(dX, dY);
+			if(!pLightCollection)
+				continue;
+
+			G4double dNbPhotons = lNbGroupElectrons*m_dElectroluminescenceYield;
+			for(G4int j = 0; j < m_iNbMapPmts; j++)
+				m_hMeanHits[j] += dNbPhotons*pLightCollection[j];
+		}
+	}
+
+	pPmtHits->resize(m_iNbMapPmts);
+	for(G4int j = 0; j < m_iNbMapPmts; j++)
+		(*pPmtHits)[j] = (m_hMeanHits[j] > 0.)?(G4Poisson(m_hMeanHits[j])):(0);
+}
+
+void
+DARWINFastS2::PrintParameters() const
+{
+	G4cout << "----> Fast S2: lifetime " << m_dElectronLifetime/microsecond << " us, drift velocity "
+		<< m_dDriftVelocity/(mm/microsecond) << " mm/us, diffusion " << m_dLongitudinalDiffusion/(cm2/s) << " (L) "
+		<< m_dTransverseDiffusion/(cm2/s) << " (T) cm2/s" << G4endl;
+	G4cout << "      charge yield " << m_dChargeYield*keV << " e-/keVee, extraction " << m_dExtractionEfficiency
+		<< ", electroluminescence " << m_dElectroluminescenceYield << " photons/e-" << G4endl;
+	G4cout << "      liquid surface at z = " << m_dLiquidSurfaceZ/mm << " mm, drift length " << m_dDriftLength/mm << " mm, map "
+		<< m_hMapFilename << G4endl;
+}
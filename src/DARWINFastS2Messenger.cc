@@ -0,0 +1,102 @@
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4Tokenizer.hh>
+
+#include "DARWINFastS2.hh"
+
+#include "DARWINFastS2Messenger.hh"
+
+DARWINFastS2Messenger::DARWINFastS2Messenger(DARWINFastS2 *pFastS2)
+:m_pFastS2(pFastS2)
+{
+	m_pFastS2Dir = new G4UIdirectory("/Xe/fasts2/");
+	m_pFastS2Dir->SetGuidance("fast S2 model control.");
+
+	m_pEnabledCmd = new G4UIcmdWithABool("/Xe/fasts2/setEnabled", this);
+	m_pEnabledCmd->SetGuidance("Simulate the S2 top pmt hits of the clustered LXe deposits (s2pmthits, s2ne, s2time, s2width).");
+	m_pEnabledCmd->SetParameterName("Enabled", false);
+	m_pEnabledCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pMapFileCmd = new G4UIcmdWithAString("/Xe/fasts2/setMapFile", this);
+	m_pMapFileCmd->SetGuidance("Per pmt S2 light collection map of the top array (see readme/fasts2.txt).");
+	m_pMapFileCmd->SetGuidance("The parsed map is cached in <file>.bin and reused while it is newer than the file.");
+	m_pMapFileCmd->SetParameterName("File", false);
+	m_pMapFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pParameterFileCmd = new G4UIcmdWithAString("/Xe/fasts2/setParameterFile", this);
+	m_pParameterFileCmd->SetGuidance("Read the drift, diffusion and yield parameters from a file (see readme/fasts2.txt).");
+	m_pParameterFileCmd->SetParameterName("File", false);
+	m_pParameterFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pElectronLifetimeCmd = new G4UIcmdWithADoubleAndUnit("/Xe/fasts2/setElectronLifetime", this);
+	m_pElectronLifetimeCmd->SetGuidance("Electron lifetime in the liquid (default 1 ms).");
+	m_pElectronLifetimeCmd->SetParameterName("Lifetime", false);
+	m_pElectronLifetimeCmd->SetRange("Lifetime > 0.");
+	m_pElectronLifetimeCmd->SetDefaultUnit("microsecond");
+	m_pElectronLifetimeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pLiquidSurfaceCmd = new G4UIcmdWithADoubleAndUnit("/Xe/fasts2/setLiquidSurface", this);
+	m_pLiquidSurfaceCmd->SetGuidance("z of the liquid surface (default the gate from the geometry).");
+	m_pLiquidSurfaceCmd->SetParameterName("Z", false);
+	m_pLiquidSurfaceCmd->SetDefaultUnit("mm");
+	m_pLiquidSurfaceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pDiffusionCmd = new G4UIcommand("/Xe/fasts2/setDiffusion", this);
+	m_pDiffusionCmd->SetGuidance("Longitudinal and transverse diffusion constants in cm2/s (default 25 and 50).");
+	m_pDiffusionCmd->SetGuidance("[usage] /Xe/fasts2/setDiffusion DL DT");
+
+	G4UIparameter *pDiffusionParameter;
+
+	pDiffusionParameter = new G4UIparameter("DL", 'd', false);
+	pDiffusionParameter->SetParameterRange("DL >= 0.");
+	m_pDiffusionCmd->SetParameter(pDiffusionParameter);
+	pDiffusionParameter = new G4UIparameter("DT", 'd', false);
+	pDiffusionParameter->SetParameterRange("DT >= 0.");
+	m_pDiffusionCmd->SetParameter(pDiffusionParameter);
+	m_pDiffusionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+DARWINFastS2Messenger::~DARWINFastS2Messenger()
+{
+	delete m_pEnabledCmd;
+	delete m_pMapFileCmd;
+	delete m_pParameterFileCmd;
+	delete m_pElectronLifetimeCmd;
+	delete m_pLiquidSurfaceCmd;
+	delete m_pDiffusionCmd;
+
+	delete m_pFastS2Dir;
+}
+
+void
+DARWINFastS2Messenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValue)
+{
+	if(pUIcommand == m_pEnabledCmd)
+		m_pFastS2->SetEnabled(m_pEnabledCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pMapFileCmd)
+		m_pFastS2->LoadMap(hNewValue);
+
+	if(pUIcommand == m_pParameterFileCmd)
+		m_pFastS2->LoadParameters(hNewValue);
+
+	if(pUIcommand == m_pElectronLifetimeCmd)
+		m_pFastS2->SetElectronLifetime(m_pElectronLifetimeCmd->GetNewDoubleValue(hNewValue));
+
+	if(pUIcommand == m_pLiquidSurfaceCmd)
+		m_pFastS2->SetLiquidSurface(m_pLiquidSurfaceCmd->GetNewDoubleValue(hNewValue));
+
+	if(pUIcommand == m_pDiffusionCmd)
+	{
+		G4Tokenizer next(hNewValue);
+
+		G4double dLongitudinal = StoD(next());
+		G4double dTransverse = StoD(next());
+
+		m_pFastS2->SetDiffusion(dLongitudinal*cm2/s, dTransverse*cm2/s);
+	}
+}
@@ -21,6 +21,7 @@ DARWINLXeHit::~DARWINLXeHit()
 DARWINLXeHit::DARWINLXeHit(const DARWINLXeHit &hDARWINLXeHit):G4VHit()
 {
 	m_iTrackId = hDARWINLXeHit.m_iTrackId;
+	m_iTrackIndex = hDARWINLXeHit.m_iTrackIndex;
 	m_iParentId = hDARWINLXeHit.m_iParentId;
 	m_pParticleType = hDARWINLXeHit.m_pParticleType;
 	m_pParticlePdg = hDARWINLXeHit.m_pParticlePdg;
@@ -31,12 +32,14 @@ DARWINLXeHit::DARWINLXeHit(const DARWINLXeHit &hDARWINLXeHit):G4VHit()
 	m_dEnergyDeposited = hDARWINLXeHit.m_dEnergyDeposited;
 	m_dKineticEnergy = hDARWINLXeHit.m_dKineticEnergy ;
 	m_dTime = hDARWINLXeHit.m_dTime;
+	m_bNuclearRecoil = hDARWINLXeHit.m_bNuclearRecoil;
 }
 
 const DARWINLXeHit &
 DARWINLXeHit::operator=(const DARWINLXeHit &hDARWINLXeHit)
 {
 	m_iTrackId = hDARWINLXeHit.m_iTrackId;
+	m_iTrackIndex = hDARWINLXeHit.m_iTrackIndex;
 	m_iParentId = hDARWINLXeHit.m_iParentId;
 	m_pParticleType = hDARWINLXeHit.m_pParticleType;
 	m_pParticlePdg = hDARWINLXeHit.m_pParticlePdg;
@@ -47,6 +50,7 @@ DARWINLXeHit::operator=(const DARWINLXeHit &hDARWINLXeHit)
 	m_dEnergyDeposited = hDARWINLXeHit.m_dEnergyDeposited;
 	m_dKineticEnergy = hDARWINLXeHit.m_dKineticEnergy ;
 	m_dTime = hDARWINLXeHit.m_dTime;
+	m_bNuclearRecoil = hDARWINLXeHit.m_bNuclearRecoil;
 
 	return *this;
 }
@@ -90,6 +94,7 @@ void DARWINLXeHit::Print()
 		<< " mm" << G4endl
 		<< "EnergyDeposited: " << m_dEnergyDeposited/keV << " keV"
 		<< " KineticEnergyLeft: " << m_dKineticEnergy/keV << " keV"
-		<< " Time: " << m_dTime/s << " s" << G4endl;
+		<< " Time: " << m_dTime/s << " s"
+		<< " NuclearRecoil: " << m_bNuclearRecoil << G4endl;
 }
 
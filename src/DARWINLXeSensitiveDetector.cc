@@ -31,7 +31,8 @@ void DARWINLXeSensitiveDetector::Initialize(G4HCofThisEvent* pHitsCollectionOfTh
 	
 	pHitsCollectionOfThisEvent->AddHitsCollection(iHitsCollectionID, m_pLXeHitsCollection);
 
-	m_hParticleTypes.clear();
+	m_hTrackIndices.clear();
+	m_hTracks.clear();
 }
 
 G4bool DARWINLXeSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory *pHistory)
@@ -41,25 +42,34 @@ G4bool DARWINLXeSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory
 
 	DARWINLXeHit* pHit = new DARWINLXeHit();
 
-	pHit->SetTrackId(pTrack->GetTrackID());
+	// track data once per track, one lookup per step
+	map<int,int>::iterator pTrackIndex = m_hTrackIndices.find(pTrack->GetTrackID());
+	G4int iTrackIndex = (pTrackIndex != m_hTrackIndices.end())?(pTrackIndex->second):(AddTrack(pTrack));
+	const Track &hTrack = m_hTracks[iTrackIndex];
 
-	if(!m_hParticleTypes.count(pTrack->GetTrackID()))
-		m_hParticleTypes[pTrack->GetTrackID()] = pTrack->GetDefinition()->GetParticleName();
+	pHit->SetTrackId(hTrack.iTrackId);
+	pHit->SetTrackIndex(iTrackIndex);
+	pHit->SetParentId(hTrack.iParentId);
+	pHit->SetParticleType(hTrack.hParticleType);
+	pHit->SetParticlePdg(hTrack.iPdg);
 
-	pHit->SetParentId(pTrack->GetParentID());
-	pHit->SetParticleType(pTrack->GetDefinition()->GetParticleName());
+	map<int,int>::iterator pParentIndex = m_hTrackIndices.find(hTrack.iParentId);
 
-	if(pTrack->GetParentID())
-		pHit->SetParentType(m_hParticleTypes[pTrack->GetParentID()]);
-	else
+	if(!hTrack.iParentId)
 		pHit->SetParentType(G4String("none"));
-
-	if(pTrack->GetCreatorProcess())
-		pHit->SetCreatorProcess(pTrack->GetCreatorProcess()->GetProcessName());
+	else if(pParentIndex != m_hTrackIndices.end())
+		pHit->SetParentType(m_hTracks[pParentIndex->second].hParticleType);
 	else
-		pHit->SetCreatorProcess(G4String("Null"));
+		pHit->SetParentType(G4String(""));
+
+	pHit->SetCreatorProcess(hTrack.hCreatorProcess);
 
-	pHit->SetDepositingProcess(pStep->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName());
+	const G4String &hDepositingProcess = pStep->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName();
+
+	// nuclear recoil: ions heavier than alphas, and neutron elastic scatters depositing the recoil locally
+	pHit->SetNuclearRecoil(hTrack.bNucleus || (hTrack.iPdg == 2112 && hDepositingProcess == "hadElastic"));
+
+	pHit->SetDepositingProcess(hDepositingProcess);
 	pHit->SetPosition(pStep->GetPostStepPoint()->GetPosition());
 	pHit->SetEnergyDeposited(dEnergyDeposited);
 	pHit->SetKineticEnergy(pTrack->GetKineticEnergy());
@@ -70,6 +80,30 @@ G4bool DARWINLXeSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory
 	return true;
 }
 
+G4int DARWINLXeSensitiveDetector::AddTrack(const G4Track *pTrack)
+{
+	Track hTrack;
+
+	hTrack.iTrackId = pTrack->GetTrackID();
+	hTrack.iParentId = pTrack->GetParentID();
+	hTrack.iPdg = pTrack->GetDefinition()->GetPDGEncoding();
+	hTrack.bNucleus = pTrack->GetDefinition()->GetParticleType() == "nucleus" && pTrack->GetDefinition()->GetBaryonNumber() > 4;
+	hTrack.hParticleType = pTrack->GetDefinition()->GetParticleName();
+
+	if(pTrack->GetCreatorProcess())
+		hTrack.hCreatorProcess = pTrack->GetCreatorProcess()->GetProcessName();
+	else
+		hTrack.hCreatorProcess = "Null";
+
+	hTrack.hStartPosition = pTrack->GetVertexPosition();
+	hTrack.dStartEnergy = pTrack->GetVertexKineticEnergy();
+
+	m_hTrackIndices[hTrack.iTrackId] = m_hTracks.size();
+	m_hTracks.push_back(hTrack);
+
+	return m_hTracks.size()-1;
+}
+
 void DARWINLXeSensitiveDetector::EndOfEvent(G4HCofThisEvent *pHitsCollectionOfThisEvent)
 {
 //  if (verboseLevel>0) { 
@@ -0,0 +1,198 @@
+#include <G4ios.hh>
+
+#include <sstream>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TBranch.h>
+
+#include "DARWINOutputSettings.hh"
+
+DARWINOutputSettings::DARWINOutputSettings()
+{
+	Reset();
+}
+
+DARWINOutputSettings::~DARWINOutputSettings()
+{
+}
+
+void
+DARWINOutputSettings::Reset()
+{
+	m_hPreset = "none";
+
+	m_iCompressionSettings = -1;
+	m_iBasketSize = 0;
+	m_bAutoFlush = false;
+	m_lAutoFlush = 0;
+
+	m_hBranchCompressionSettings.clear();
+	m_hBranchBasketSizes.clear();
+	m_hPresetBranches.clear();
+}
+
+G4bool
+DARWINOutputSettings::SetPreset(const G4String &hPreset)
+{
+	// branches of both layouts, those not in the tree are skipped
+	const char *szStepBranches[] = {"xp", "yp", "zp", "ed", "time", "trackid", "parentid", "trkindex"};
+	const char *szStringBranches[] = {"type", "parenttype", "creaproc", "edproc", "trk_creaproc", "type_pri"};
+	const G4int iNbStepBranches = sizeof(szStepBranches)/sizeof(szStepBranches[0]);
+	const G4int iNbStringBranches = sizeof(szStringBranches)/sizeof(szStringBranches[0]);
+
+	if(hPreset == "fast")
+	{
+		Reset();
+		SetCompression("lz4", 1);
+		SetBasketSize(256000);
+		SetAutoFlush(-30000000);
+	}
+	else if(hPreset == "balanced")
+	{
+		// large baskets for the per step vectors, strings are cheap to compress with lz4
+		Reset();
+		SetCompression("zstd", 5);
+		for(G4int i = 0; i < iNbStepBranches; i++)
+		{
+			SetBasketSize(128000, szStepBranches[i]);
+			m_hPresetBranches.insert(szStepBranches[i]);
+		}
+		for(G4int i = 0; i < iNbStringBranches; i++)
+		{
+			SetCompression("lz4", 4, szStringBranches[i]);
+			m_hPresetBranches.insert(szStringBranches[i]);
+		}
+		SetAutoFlush(-30000000);
+	}
+	else if(hPreset == "archive")
+	{
+		Reset();
+		SetCompression("lzma", 8);
+		SetBasketSize(512000);
+		SetAutoFlush(-100000000);
+	}
+	else
+	{
+		G4cout << "Error: unknown output preset " << hPreset << G4endl;
+		return false;
+	}
+
+	m_hPreset = hPreset;
+
+	return true;
+}
+
+G4bool
+DARWINOutputSettings::SetCompression(const G4String &hAlgorithm, G4int iLevel, const G4String &hBranch)
+{
+	G4int iSettings = GetCompressionSettings(hAlgorithm, iLevel);
+
+	if(iSettings < -1)
+	{
+		G4cout << "Error: unknown compression algorithm " << hAlgorithm << G4endl;
+		return false;
+	}
+
+	if(hBranch.empty() || hBranch == "*")
+		m_iCompressionSettings = iSettings;
+	else if(iSettings < 0)
+		m_hBranchCompressionSettings.erase(hBranch);
+	else
+		m_hBranchCompressionSettings[hBranch] = iSettings;
+
+	// a branch named by the user has to exist
+	m_hPresetBranches.erase(hBranch);
+
+	return true;
+}
+
+void
+DARWINOutputSettings::SetBasketSize(G4int iBasketSize, const G4String &hBranch)
+{
+	if(hBranch.empty() || hBranch == "*")
+		m_iBasketSize = iBasketSize;
+	else if(iBasketSize <= 0)
+		m_hBranchBasketSizes.erase(hBranch);
+	else
+		m_hBranchBasketSizes[hBranch] = iBasketSize;
+
+	m_hPresetBranches.erase(hBranch);
+}
+
+void
+DARWINOutputSettings::Apply(TFile *pFile) const
+{
+	// branches created afterwards inherit the file settings
+	if(m_iCompressionSettings >= 0)
+		pFile->SetCompressionSettings(m_iCompressionSettings);
+}
+
+void
+DARWINOutputSettings::Apply(TTree *pTree) const
+{
+	if(m_iBasketSize > 0)
+		pTree->SetBasketSize("*", m_iBasketSize);
+
+	// the branches of a preset are only set if the layout has them
+	map<G4String, G4int>::const_iterator pIt;
+	for(pIt = m_hBranchBasketSizes.begin(); pIt != m_hBranchBasketSizes.end(); pIt++)
+	{
+		if(!m_hPresetBranches.count(pIt->first) || pTree->GetBranch(pIt->first.c_str()))
+			pTree->SetBasketSize(pIt->first.c_str(), pIt->second);
+	}
+
+	for(pIt = m_hBranchCompressionSettings.begin(); pIt != m_hBranchCompressionSettings.end(); pIt++)
+	{
+		TBranch *pBranch = pTree->GetBranch(pIt->first.c_str());
+
+		if(pBranch)
+			pBranch->SetCompressionSettings(pIt->second);
+		else if(!m_hPresetBranches.count(pIt->first))
+			G4cout << "Error: no branch " << pIt->first << " for the compression setting" << G4endl;
+	}
+
+	if(m_bAutoFlush)
+		pTree->SetAutoFlush(m_lAutoFlush);
+}
+
+G4String
+DARWINOutputSettings::GetDescription() const
+{
+	std::ostringstream hStream;
+
+	hStream << "preset " << m_hPreset << "\n";
+	hStream << "compression " << m_iCompressionSettings << "\n";
+	hStream << "basketsize " << m_iBasketSize << "\n";
+	if(m_bAutoFlush)
+		hStream << "autoflush " << m_lAutoFlush << "\n";
+	else
+		hStream << "autoflush default\n";
+
+	map<G4String, G4int>::const_iterator pIt;
+	for(pIt = m_hBranchCompressionSettings.begin(); pIt != m_hBranchCompressionSettings.end(); pIt++)
+		hStream << "compression " << pIt->second << " " << pIt->first << "\n";
+	for(pIt = m_hBranchBasketSizes.begin(); pIt != m_hBranchBasketSizes.end(); pIt++)
+		hStream << "basketsize " << pIt->second << " " << pIt->first << "\n";
+
+	return hStream.str();
+}
+
+G4int
+DARWINOutputSettings::GetCompressionSettings(const G4String &hAlgorithm, G4int iLevel)
+{
+	// ROOT settings are 100*algorithm+level, -1 keeps the default
+	if(hAlgorithm == "default")
+		return -1;
+	else if(hAlgorithm == "zlib")
+		return 100+iLevel;
+	else if(hAlgorithm == "lzma")
+		return 200+iLevel;
+	else if(hAlgorithm == "lz4")
+		return 400+iLevel;
+	else if(hAlgorithm == "zstd")
+		return 500+iLevel;
+	else
+		return -2;
+}
+
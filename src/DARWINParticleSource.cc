@@ -9,16 +9,24 @@
 #include <G4Ions.hh>
 #include <G4TrackingManager.hh>
 #include <G4Track.hh>
+#include <G4GeometryTolerance.hh>
+#include <G4RunManager.hh>
+#include <G4Timer.hh>
 #include <Randomize.hh>
 #include "TH1.h" 
 
 #include <sstream>
+#include <fstream>
 #include <cmath>
 #include <vector>
+#include <algorithm>
 
 using std::stringstream;
 using std::vector;
 
+#include "DARWINSurfaceSampler.hh"
+#include "DARWINEventFileReader.hh"
+
 #include "DARWINParticleSource.hh"
 
 DARWINParticleSource::DARWINParticleSource()
@@ -38,6 +46,19 @@ DARWINParticleSource::DARWINParticleSource()
 	m_hShape = "NULL";
 	m_dHalfz = 0.;
 	m_dRadius = 0.;
+	m_dFluxTargetRadius = 0.;
+	m_dFluxTargetHalfz = 0.;
+	m_lFluxTried = 0;
+	m_lFluxAccepted = 0;
+	m_hSurfaceDepthType = "None";
+	m_dSurfaceDepth = 0.;
+	m_hSurfaceDirection = "iso";
+	m_pSurfaceSampler = 0;
+	m_pEventFileReader = new DARWINEventFileReader();
+	m_pConfineNavigator = 0;
+	m_dEventWeight = 1.;
+	m_iBatchSize = 0;
+	m_iBatchIndex = 0;
 	m_hCenterCoords = hZero;
 	m_bConfine = false;
 	m_hVolumeNames.clear();
@@ -62,6 +83,9 @@ DARWINParticleSource::DARWINParticleSource()
 
 DARWINParticleSource::~DARWINParticleSource()
 {
+	delete m_pSurfaceSampler;
+	delete m_pEventFileReader;
+	delete m_pConfineNavigator;
 	delete m_pMessenger;
 }
 
@@ -156,6 +180,25 @@ DARWINParticleSource::ReadEnergySpectrum()
 	return true;
 }
 
+void
+DARWINParticleSource::SetEventFile(G4String hEventFile, G4String hFormat)
+{
+	if(m_pEventFileReader->Open(hEventFile, hFormat))
+		m_hSourcePosType = "File";
+}
+
+void
+DARWINParticleSource::SetEventFilePartition(G4int iIndex, G4int iNbPartitions)
+{
+	m_pEventFileReader->SetPartition(iIndex, iNbPartitions);
+}
+
+void
+DARWINParticleSource::SetEventFileOffset(G4ThreeVector hOffset)
+{
+	m_pEventFileReader->SetOffset(hOffset);
+}
+
 void
 DARWINParticleSource::ConfineSourceToVolume(G4String hVolumeList)
 {
@@ -163,6 +206,13 @@ DARWINParticleSource::ConfineSourceToVolume(G4String hVolumeList)
 	hStream.str(hVolumeList);
 	G4String hVolumeName;
 
+	// the surfaces are collected again for the new volumes
+	delete m_pSurfaceSampler;
+	m_pSurfaceSampler = 0;
+
+	delete m_pConfineNavigator;
+	m_pConfineNavigator = 0;
+
 	// store all the volume names
 	while(!hStream.eof())
 	{
@@ -175,6 +225,8 @@ DARWINParticleSource::ConfineSourceToVolume(G4String hVolumeList)
 	G4bool bFoundAll = true;
 
 	set<G4String> hActualVolumeNames;
+	m_hConfineVolumes.Clear();
+
 	for(set<G4String>::iterator pIt = m_hVolumeNames.begin(); pIt != m_hVolumeNames.end(); pIt++)
 	{
 		G4String hRequiredVolumeName = *pIt;
@@ -191,6 +243,7 @@ DARWINParticleSource::ConfineSourceToVolume(G4String hVolumeList)
 			if((bMatch && (hName.substr(0, hRequiredVolumeName.size())) == hRequiredVolumeName) || hName == hRequiredVolumeName)
 			{
 				hActualVolumeNames.insert(hName);
+				m_hConfineVolumes.Insert((*PVStore)[iIndex]);
 				bFoundOne = true;
 			}
 		}
@@ -221,6 +274,7 @@ DARWINParticleSource::ConfineSourceToVolume(G4String hVolumeList)
 		G4cout << " **** Error: One or more volumes do not exist **** " << G4endl;
 		G4cout << " Ignoring confine condition" << G4endl;
 		m_hVolumeNames.clear();
+		m_hConfineVolumes.Clear();
 		m_bConfine = false;
 	}
 }
@@ -339,6 +393,181 @@ DARWINParticleSource::SetRandomSpherePos()
 }
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+G4double
+DARWINParticleSource::GetSurfaceFluxArea()
+{
+	if(m_hShape == "Sphere")
+		return 4.*pi*m_dRadius*m_dRadius;
+	else if(m_hShape == "Cylinder")
+		return 2.*pi*m_dRadius*m_dRadius + 4.*pi*m_dRadius*m_dHalfz;
+	else
+		return 0.;
+}
+
+void
+DARWINParticleSource::GenerateSurfaceFlux()
+{
+	// an isotropic flux crossing a closed surface is a uniform position on the surface
+	// with a cosine-law direction around the inward normal, a flux of 1 per unit area
+	// and time corresponds to an exposure of 4*tried/area
+	if(m_hSourcePosType != "SurfaceFlux" && m_iVerbosityLevel >= 1)
+		G4cout << "Error SourcePosType not SurfaceFlux" << G4endl;
+
+	G4ThreeVector hPosition, hNormal;
+	G4bool bAccepted = false;
+
+	while(!bAccepted)
+	{
+		if(m_hShape == "Sphere")
+		{
+			G4double dCosTheta = 1. - 2.*G4UniformRand();
+			G4double dSinTheta = std::sqrt(1. - dCosTheta*dCosTheta);
+			G4double dPhi = twopi*G4UniformRand();
+
+			hNormal = -G4ThreeVector(dSinTheta*std::cos(dPhi), dSinTheta*std::sin(dPhi), dCosTheta);
+			hPosition = -m_dRadius*hNormal;
+		}
+		else if(m_hShape == "Cylinder")
+		{
+			G4double dCapsArea = 2.*pi*m_dRadius*m_dRadius;
+			G4double dPhi = twopi*G4UniformRand();
+
+			if(G4UniformRand()*GetSurfaceFluxArea() < dCapsArea)
+			{
+				G4double dR = m_dRadius*std::sqrt(G4UniformRand());
+				G4double dSide = (G4UniformRand() < 0.5)?(-1.):(1.);
+
+				hNormal = G4ThreeVector(0., 0., -dSide);
+				hPosition = G4ThreeVector(dR*std::cos(dPhi), dR*std::sin(dPhi), dSide*m_dHalfz);
+			}
+			else
+			{
+				hNormal = -G4ThreeVector(std::cos(dPhi), std::sin(dPhi), 0.);
+				hPosition = G4ThreeVector(m_dRadius*std::cos(dPhi), m_dRadius*std::sin(dPhi), (2.*G4UniformRand()-1.)*m_dHalfz);
+			}
+		}
+		else
+		{
+			G4cout << "Error: SurfaceFlux shape must be Sphere or Cylinder" << G4endl;
+			return;
+		}
+
+		// cosine-law around the inward normal
+		G4double dCosTheta = std::sqrt(G4UniformRand());
+		G4double dSinTheta = std::sqrt(1. - dCosTheta*dCosTheta);
+		G4double dPhi = twopi*G4UniformRand();
+
+		G4ThreeVector hU = hNormal.orthogonal().unit();
+		G4ThreeVector hV = hNormal.cross(hU);
+
+		G4ThreeVector hDirection = dCosTheta*hNormal + dSinTheta*(std::cos(dPhi)*hU + std::sin(dPhi)*hV);
+
+		m_lFluxTried++;
+
+		// bias, only the particles heading towards the target are tracked
+		if(m_dFluxTargetRadius > 0. && !IsAimedAtFluxTarget(hPosition, hDirection))
+			continue;
+
+		m_lFluxAccepted++;
+
+		m_hParticlePosition = m_hCenterCoords + hPosition;
+		m_hParticleMomentumDirection = hDirection;
+		bAccepted = true;
+	}
+}
+
+void
+DARWINParticleSource::GeneratePointsOnSurface()
+{
+	if(m_hSourcePosType != "Surface" && m_iVerbosityLevel >= 1)
+		G4cout << "Error SourcePosType not Surface" << G4endl;
+
+	if(!m_bConfine)
+	{
+		G4cout << "Error: Surface source needs volumes, use /xe/gun/confine" << G4endl;
+		return;
+	}
+
+	if(!m_pSurfaceSampler)
+	{
+		m_pSurfaceSampler = new DARWINSurfaceSampler();
+		m_pSurfaceSampler->Build(m_pNavigator->GetWorldVolume(), m_hVolumeNames);
+	}
+
+	if(!m_pSurfaceSampler->IsBuilt())
+		return;
+
+	G4ThreeVector hPosition, hNormal;
+	m_pSurfaceSampler->GeneratePoint(hPosition, hNormal);
+
+	// implantation depth, always inside the volume by at least the surface tolerance
+	G4double dDepth = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+
+	if(m_hSurfaceDepthType == "Flat")
+		dDepth += G4UniformRand()*m_dSurfaceDepth;
+	else if(m_hSurfaceDepthType == "Exponential")
+		dDepth += CLHEP::RandExponential::shoot(m_dSurfaceDepth);
+
+	m_hParticlePosition = hPosition - dDepth*hNormal;
+
+	// isotropic in the outward or inward hemisphere
+	if(m_hSurfaceDirection != "iso")
+	{
+		G4ThreeVector hAxis = (m_hSurfaceDirection == "outward")?(hNormal):(-hNormal);
+
+		G4double dCosTheta = G4UniformRand();
+		G4double dSinTheta = std::sqrt(1. - dCosTheta*dCosTheta);
+		G4double dPhi = twopi*G4UniformRand();
+
+		G4ThreeVector hU = hAxis.orthogonal().unit();
+		G4ThreeVector hV = hAxis.cross(hU);
+
+		m_hParticleMomentumDirection = dCosTheta*hAxis + dSinTheta*(std::cos(dPhi)*hU + std::sin(dPhi)*hV);
+	}
+}
+
+G4bool
+DARWINParticleSource::IsAimedAtFluxTarget(const G4ThreeVector &hPosition, const G4ThreeVector &hDirection)
+{
+	// target cylinder along z around the source center
+	const G4double dR2 = m_dFluxTargetRadius*m_dFluxTargetRadius;
+
+	G4double dA = hDirection.x()*hDirection.x() + hDirection.y()*hDirection.y();
+	G4double dB = 2.*(hPosition.x()*hDirection.x() + hPosition.y()*hDirection.y());
+	G4double dC = hPosition.x()*hPosition.x() + hPosition.y()*hPosition.y() - dR2;
+
+	// barrel
+	if(dA > 0.)
+	{
+		G4double dDiscriminant = dB*dB - 4.*dA*dC;
+
+		if(dDiscriminant >= 0.)
+		{
+			G4double dSqrt = std::sqrt(dDiscriminant);
+			G4double pT[2] = {(-dB-dSqrt)/(2.*dA), (-dB+dSqrt)/(2.*dA)};
+
+			for(G4int i=0; i<2; i++)
+				if(pT[i] > 0. && std::abs(hPosition.z() + pT[i]*hDirection.z()) <= m_dFluxTargetHalfz)
+					return true;
+		}
+	}
+
+	// end caps
+	if(hDirection.z() != 0.)
+	{
+		for(G4int i=0; i<2; i++)
+		{
+			G4double dT = (((i)?(1.):(-1.))*m_dFluxTargetHalfz - hPosition.z())/hDirection.z();
+			G4double dX = hPosition.x() + dT*hDirection.x();
+			G4double dY = hPosition.y() + dT*hDirection.y();
+
+			if(dT > 0. && dX*dX + dY*dY <= dR2)
+				return true;
+		}
+	}
+
+	return false;
+}
 
 G4bool
 DARWINParticleSource::IsSourceConfined()
@@ -346,22 +575,21 @@ DARWINParticleSource::IsSourceConfined()
 	// Method to check point is within the volume specified
 	if(m_bConfine == false)
 		G4cout << "Error: Confine is false" << G4endl;
-	G4ThreeVector null(0., 0., 0.);
-	G4ThreeVector *ptr;
-
-	ptr = &null;
 
-	// Check m_hParticlePosition is within a volume in our list
-	G4VPhysicalVolume *theVolume;
+	// own navigator, the relative search starts from the previous source point
+	// instead of wherever tracking left the tracking navigator
+	if(!m_pConfineNavigator)
+	{
+		m_pConfineNavigator = new G4Navigator();
+		m_pConfineNavigator->SetWorldVolume(m_pNavigator->GetWorldVolume());
+	}
 
-	theVolume = m_pNavigator->LocateGlobalPointAndSetup(m_hParticlePosition, ptr, true);
-	G4String theVolName = theVolume->GetName();
+	G4VPhysicalVolume *pVolume = m_pConfineNavigator->LocateGlobalPointAndSetup(m_hParticlePosition, 0, true);
 
-	set<G4String>::iterator pIt;
-	if((pIt = m_hVolumeNames.find(theVolName)) != m_hVolumeNames.end())
+	if(m_hConfineVolumes.Contains(pVolume))
 	{
 		if(m_iVerbosityLevel >= 1)
-			G4cout << "Particle is in volume " << *pIt << G4endl;
+			G4cout << "Particle is in volume " << pVolume->GetName() << G4endl;
 		return (true);
 	}
 	else
@@ -418,16 +646,26 @@ DARWINParticleSource::GenerateEnergyFromSpectrum()
 }
 
 void
-DARWINParticleSource::GeneratePrimaryVertex(G4Event * evt)
+DARWINParticleSource::GeneratePrimaryVertexFromFile(G4Event *pEvent)
 {
-
-	if(m_pParticleDefinition == 0)
+	if(!m_pEventFileReader->IsOpen())
 	{
-		G4cout << "No particle has been defined!" << G4endl;
+		G4cout << "Error: no event file, use /xe/gun/eventfile" << G4endl;
 		return;
 	}
 
-	// Position
+	if(!m_pEventFileReader->GeneratePrimaryVertex(pEvent, m_dEventWeight))
+	{
+		G4cout << "----> End of the event file after " << m_pEventFileReader->GetNbRecordsRead()
+			<< " records, aborting the run" << G4endl;
+
+		G4RunManager::GetRunManager()->AbortRun(true);
+	}
+}
+
+G4int
+DARWINParticleSource::GeneratePosition()
+{
 	G4bool srcconf = false;
 	G4int LoopCount = 0;
 
@@ -439,6 +677,10 @@ DARWINParticleSource::GeneratePrimaryVertex(G4Event * evt)
 			GeneratePointsInVolume();
 		else if(m_hSourcePosType == "RandomSphere")
 			SetRandomSpherePos();
+		else if(m_hSourcePosType == "SurfaceFlux")
+			GenerateSurfaceFlux();
+		else if(m_hSourcePosType == "Surface")
+			GeneratePointsOnSurface();
 		else
 		{
 			G4cout << "Error: SourcePosType undefined" << G4endl;
@@ -471,20 +713,313 @@ DARWINParticleSource::GeneratePrimaryVertex(G4Event * evt)
 		}
 	}
 
-	// Angular stuff
+	return LoopCount;
+}
+
+void
+DARWINParticleSource::TimeSampling(G4int iNbPositions)
+{
+	if(m_hSourcePosType == "File")
+	{
+		G4cout << "Error: no position sampling for the File source" << G4endl;
+		return;
+	}
+
+	G4Timer hTimer;
+	G4long lNbTries = 0;
+
+	hTimer.Start();
+	for(G4int i=0; i<iNbPositions; i++)
+		lNbTries += GeneratePosition();
+	hTimer.Stop();
+
+	G4double dTime = hTimer.GetRealElapsed();
+
+	G4cout << "----> Source sampling: " << iNbPositions << " positions in " << dTime << " s ("
+		<< ((dTime > 0.)?(iNbPositions/dTime):(0.)) << " positions/s), "
+		<< ((iNbPositions)?((G4double) lNbTries/iNbPositions):(0.)) << " tries/position" << G4endl;
+
+	// not part of the exposure of the run
+	ResetSurfaceFluxCounters();
+}
+
+// point and volume sources with iso or fixed directions
+G4bool
+DARWINParticleSource::IsBatchable()
+{
+	G4bool bPosition = m_hSourcePosType == "Point"
+		|| (m_hSourcePosType == "Volume" && (m_hShape == "Sphere" || m_hShape == "Cylinder"));
+	G4bool bDirection = m_hAngDistType == "iso" || m_hAngDistType == "direction";
+	G4bool bEnergy = m_hEnergyDisType == "Mono" || m_hEnergyDisType == "Spectrum";
+
+	return bPosition && bDirection && bEnergy;
+}
+
+void
+DARWINParticleSource::ClearBatch()
+{
+	m_hBatchX.clear(); m_hBatchY.clear(); m_hBatchZ.clear();
+	m_hBatchDx.clear(); m_hBatchDy.clear(); m_hBatchDz.clear();
+	m_hBatchEnergies.clear();
+	m_hEnergyCdf.clear();
+	m_iBatchIndex = 0;
+}
+
+G4bool
+DARWINParticleSource::WriteBatch(const G4String &hFilename) const
+{
+	std::ofstream hFile(hFilename.c_str());
+	if(!hFile)
+	{
+		G4cout << "Error: cannot write batch " << hFilename << G4endl;
+		return false;
+	}
+
+	// full precision, the resumed run generates the same primaries
+	hFile.precision(17);
+	hFile << m_hBatchX.size()-m_iBatchIndex << "\n";
+	for(G4int i=m_iBatchIndex; i<(G4int) m_hBatchX.size(); i++)
+		hFile << m_hBatchX[i] << " " << m_hBatchY[i] << " " << m_hBatchZ[i] << " " << m_hBatchDx[i] << " "
+			<< m_hBatchDy[i] << " " << m_hBatchDz[i] << " " << m_hBatchEnergies[i] << "\n";
+	hFile.close();
+
+	return !hFile.fail();
+}
+
+G4bool
+DARWINParticleSource::ReadBatch(const G4String &hFilename)
+{
+	std::ifstream hFile(hFilename.c_str());
+	G4int iNbPrimaries = 0;
+
+	if(!hFile || !(hFile >> iNbPrimaries) || iNbPrimaries < 0)
+	{
+		G4cout << "Error: cannot read batch " << hFilename << G4endl;
+		return false;
+	}
+
+	m_hBatchX.resize(iNbPrimaries); m_hBatchY.resize(iNbPrimaries); m_hBatchZ.resize(iNbPrimaries);
+	m_hBatchDx.resize(iNbPrimaries); m_hBatchDy.resize(iNbPrimaries); m_hBatchDz.resize(iNbPrimaries);
+	m_hBatchEnergies.resize(iNbPrimaries);
+
+	for(G4int i=0; i<iNbPrimaries; i++)
+	{
+		if(!(hFile >> m_hBatchX[i] >> m_hBatchY[i] >> m_hBatchZ[i] >> m_hBatchDx[i] >> m_hBatchDy[i] >> m_hBatchDz[i] >> m_hBatchEnergies[i]))
+		{
+			G4cout << "Error: truncated batch " << hFilename << G4endl;
+			ClearBatch();
+			return false;
+		}
+	}
+
+	m_iBatchIndex = 0;
+
+	return true;
+}
+
+void
+DARWINParticleSource::FillBatch()
+{
+	const G4int iNbPrimaries = m_iBatchSize;
+	CLHEP::HepRandomEngine *pEngine = CLHEP::HepRandom::getTheEngine();
+
+	m_hBatchX.clear(); m_hBatchY.clear(); m_hBatchZ.clear();
+	m_hRandoms.resize(3*iNbPrimaries);
+
+	vector<G4double> hX(iNbPrimaries), hY(iNbPrimaries), hZ(iNbPrimaries);
+	vector<char> hInside(iNbPrimaries);
+
+	// positions, candidates are generated for the whole block with branch free
+	// loops, the shape and confinement are checked afterwards
+	G4long lNbTries = 0;
+
+	while((G4int) m_hBatchX.size() < iNbPrimaries)
+	{
+		pEngine->flatArray(3*iNbPrimaries, &m_hRandoms[0]);
+		const G4double *pU = &m_hRandoms[0];
+
+		if(m_hSourcePosType == "Point")
+		{
+			for(G4int i=0; i<iNbPrimaries; i++)
+			{
+				hX[i] = hY[i] = hZ[i] = 0.;
+				hInside[i] = 1;
+			}
+		}
+		else if(m_hShape == "Sphere")
+		{
+			const G4double dR = m_dRadius, dR2 = m_dRadius*m_dRadius;
+
+			for(G4int i=0; i<iNbPrimaries; i++)
+			{
+				hX[i] = (2.*pU[3*i]-1.)*dR;
+				hY[i] = (2.*pU[3*i+1]-1.)*dR;
+				hZ[i] = (2.*pU[3*i+2]-1.)*dR;
+				hInside[i] = (hX[i]*hX[i] + hY[i]*hY[i] + hZ[i]*hZ[i] <= dR2);
+			}
+		}
+		else
+		{
+			const G4double dR = m_dRadius, dR2 = m_dRadius*m_dRadius, dHalfz = m_dHalfz;
+
+			for(G4int i=0; i<iNbPrimaries; i++)
+			{
+				hX[i] = (2.*pU[3*i]-1.)*dR;
+				hY[i] = (2.*pU[3*i+1]-1.)*dR;
+				hZ[i] = (2.*pU[3*i+2]-1.)*dHalfz;
+				hInside[i] = (hX[i]*hX[i] + hY[i]*hY[i] <= dR2);
+			}
+		}
+
+		for(G4int i=0; i<iNbPrimaries && (G4int) m_hBatchX.size() < iNbPrimaries; i++)
+		{
+			if(!hInside[i])
+				continue;
+
+			m_hParticlePosition = m_hCenterCoords + G4ThreeVector(hX[i], hY[i], hZ[i]);
+			lNbTries++;
+
+			// same safeguard as the single primary loop
+			if(m_bConfine && !IsSourceConfined() && lNbTries < 1000000)
+				continue;
+
+			if(lNbTries >= 1000000)
+				G4cout << "Error: batch source not confined after 1000000 tries, confinement ignored for this primary" << G4endl;
+
+			m_hBatchX.push_back(m_hParticlePosition.x());
+			m_hBatchY.push_back(m_hParticlePosition.y());
+			m_hBatchZ.push_back(m_hParticlePosition.z());
+			lNbTries = 0;
+		}
+	}
+
+	// directions
+	m_hBatchDx.resize(iNbPrimaries); m_hBatchDy.resize(iNbPrimaries); m_hBatchDz.resize(iNbPrimaries);
+
 	if(m_hAngDistType == "iso")
-		GenerateIsotropicFlux();
-	else if(m_hAngDistType == "direction")
-		SetParticleMomentumDirection(m_hParticleMomentumDirection);
+	{
+		pEngine->flatArray(2*iNbPrimaries, &m_hRandoms[0]);
+		const G4double *pU = &m_hRandoms[0];
+
+		const G4double dCosMin = std::cos(m_dMinTheta), dCosMax = std::cos(m_dMaxTheta);
+		const G4double dPhiRange = m_dMaxPhi - m_dMinPhi;
+
+		for(G4int i=0; i<iNbPrimaries; i++)
+		{
+			G4double dCosTheta = dCosMin - pU[2*i]*(dCosMin - dCosMax);
+			G4double dSinTheta = std::sqrt(1. - dCosTheta*dCosTheta);
+			G4double dPhi = m_dMinPhi + dPhiRange*pU[2*i+1];
+
+			m_hBatchDx[i] = -dSinTheta*std::cos(dPhi);
+			m_hBatchDy[i] = -dSinTheta*std::sin(dPhi);
+			m_hBatchDz[i] = -dCosTheta;
+		}
+	}
 	else
-		G4cout << "Error: AngDistType has unusual value" << G4endl;
-	// Energy stuff
+	{
+		for(G4int i=0; i<iNbPrimaries; i++)
+		{
+			m_hBatchDx[i] = m_hParticleMomentumDirection.x();
+			m_hBatchDy[i] = m_hParticleMomentumDirection.y();
+			m_hBatchDz[i] = m_hParticleMomentumDirection.z();
+		}
+	}
+
+	// energies, the spectrum is sampled by inverting its cumulative distribution
+	// with a linear interpolation in the bin, as TH1::GetRandom does
+	m_hBatchEnergies.resize(iNbPrimaries);
+
 	if(m_hEnergyDisType == "Mono")
-		GenerateMonoEnergetic();
-	else if(m_hEnergyDisType == "Spectrum")
-		GenerateEnergyFromSpectrum();
+	{
+		for(G4int i=0; i<iNbPrimaries; i++)
+			m_hBatchEnergies[i] = m_dMonoEnergy;
+	}
 	else
-		G4cout << "Error: EnergyDisType has unusual value" << G4endl;
+	{
+		const G4int iNbBins = m_hEnergySpectrum.GetNbinsX();
+
+		if(m_hEnergyCdf.empty())
+		{
+			m_hEnergyCdf.assign(iNbBins+1, 0.);
+			for(G4int i=0; i<iNbBins; i++)
+				m_hEnergyCdf[i+1] = m_hEnergyCdf[i] + m_hEnergySpectrum.GetBinContent(i+1);
+			for(G4int i=0; i<=iNbBins; i++)
+				m_hEnergyCdf[i] /= m_hEnergyCdf[iNbBins];
+		}
+
+		pEngine->flatArray(iNbPrimaries, &m_hRandoms[0]);
+
+		for(G4int i=0; i<iNbPrimaries; i++)
+		{
+			G4double dU = m_hRandoms[i];
+			G4int iBin = std::upper_bound(m_hEnergyCdf.begin(), m_hEnergyCdf.end(), dU) - m_hEnergyCdf.begin() - 1;
+			iBin = std::max(0, std::min(iBin, iNbBins-1));
+
+			G4double dBinProbability = m_hEnergyCdf[iBin+1] - m_hEnergyCdf[iBin];
+			G4double dFraction = (dBinProbability > 0.)?((dU - m_hEnergyCdf[iBin])/dBinProbability):(0.5);
+
+			m_hBatchEnergies[i] = (m_hEnergySpectrum.GetBinLowEdge(iBin+1) + dFraction*m_hEnergySpectrum.GetBinWidth(iBin+1))*MeV;
+		}
+	}
+
+	m_iBatchIndex = 0;
+}
+
+void
+DARWINParticleSource::GenerateFromBatch()
+{
+	if(m_iBatchIndex >= (G4int) m_hBatchX.size())
+		FillBatch();
+
+	const G4int i = m_iBatchIndex++;
+
+	m_hParticlePosition.set(m_hBatchX[i], m_hBatchY[i], m_hBatchZ[i]);
+	m_hParticleMomentumDirection.set(m_hBatchDx[i], m_hBatchDy[i], m_hBatchDz[i]);
+	m_dParticleEnergy = m_hBatchEnergies[i];
+}
+
+void
+DARWINParticleSource::GeneratePrimaryVertex(G4Event * evt)
+{
+	m_dEventWeight = 1.;
+
+	// externally generated events
+	if(m_hSourcePosType == "File")
+	{
+		GeneratePrimaryVertexFromFile(evt);
+		return;
+	}
+
+	if(m_pParticleDefinition == 0)
+	{
+		G4cout << "No particle has been defined!" << G4endl;
+		return;
+	}
+
+	if(m_iBatchSize > 0 && IsBatchable())
+		GenerateFromBatch();
+	else
+	{
+		// Position
+		GeneratePosition();
+
+		// Angular stuff, the surface flux and hemispheres come with their direction
+		if(m_hSourcePosType == "SurfaceFlux" || (m_hSourcePosType == "Surface" && m_hSurfaceDirection != "iso"))
+			;
+		else if(m_hAngDistType == "iso")
+			GenerateIsotropicFlux();
+		else if(m_hAngDistType == "direction")
+			SetParticleMomentumDirection(m_hParticleMomentumDirection);
+		else
+			G4cout << "Error: AngDistType has unusual value" << G4endl;
+		// Energy stuff
+		if(m_hEnergyDisType == "Mono")
+			GenerateMonoEnergetic();
+		else if(m_hEnergyDisType == "Spectrum")
+			GenerateEnergyFromSpectrum();
+		else
+			G4cout << "Error: EnergyDisType has unusual value" << G4endl;
+	}
 
 	// create a new vertex
 	G4PrimaryVertex *vertex = new G4PrimaryVertex(m_hParticlePosition, m_dParticleTime);
@@ -539,3 +1074,18 @@ DARWINParticleSource::GeneratePrimaryVertexFromTrack(G4Track *pTrack, G4Event *p
 	pEvent->AddPrimaryVertex(pVertex);
 }
 
+void
+DARWINParticleSource::GeneratePrimaryVertexFromDecay(G4ParticleDefinition *pDefinition, const G4ThreeVector &hPosition,
+	const G4ThreeVector &hMomentum, G4double dTime, G4Event *pEvent)
+{
+	G4PrimaryVertex *pVertex = new G4PrimaryVertex(hPosition, m_dParticleTime+dTime);
+
+	G4PrimaryParticle *pPrimary = new G4PrimaryParticle(pDefinition, hMomentum.x(), hMomentum.y(), hMomentum.z());
+	pPrimary->SetMass(pDefinition->GetPDGMass());
+	pPrimary->SetCharge(pDefinition->GetPDGCharge());
+
+	pVertex->SetPrimary(pPrimary);
+
+	pEvent->AddPrimaryVertex(pVertex);
+}
+
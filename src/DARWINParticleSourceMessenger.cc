@@ -96,10 +96,13 @@ DARWINParticleSourceMessenger::DARWINParticleSourceMessenger(DARWINParticleSourc
 	// source distribution type
 	m_pTypeCmd = new G4UIcmdWithAString("/xe/gun/type", this);
 	m_pTypeCmd->SetGuidance("Sets source distribution type.");
-	m_pTypeCmd->SetGuidance("Either Point or Volume");
+	m_pTypeCmd->SetGuidance("Either Point, Volume, RandomSphere, SurfaceFlux, Surface or File");
+	m_pTypeCmd->SetGuidance("SurfaceFlux: isotropic flux entering a Sphere or Cylinder shape (see /xe/gun/fluxtarget)");
+	m_pTypeCmd->SetGuidance("Surface: on the surfaces of the confine volumes (see /xe/gun/surfacedepth and surfacedirection)");
+	m_pTypeCmd->SetGuidance("File: events read from /xe/gun/eventfile");
 	m_pTypeCmd->SetParameterName("DisType", true, true);
 	m_pTypeCmd->SetDefaultValue("Point");
-	m_pTypeCmd->SetCandidates("Point Volume RandomSphere");
+	m_pTypeCmd->SetCandidates("Point Volume RandomSphere SurfaceFlux Surface File");
 
 	// source shape
 	m_pShapeCmd = new G4UIcmdWithAString("/xe/gun/shape", this);
@@ -129,6 +132,85 @@ DARWINParticleSourceMessenger::DARWINParticleSourceMessenger(DARWINParticleSourc
 	m_pRadiusCmd->SetDefaultUnit("cm");
 	m_pRadiusCmd->SetUnitCandidates("nm mum mm cm m km");
 
+	// target of the surface flux
+	m_pFluxTargetCmd = new G4UIcommand("/xe/gun/fluxtarget", this);
+	m_pFluxTargetCmd->SetGuidance("Only generate the surface flux particles heading towards a cylinder");
+	m_pFluxTargetCmd->SetGuidance("around the source center (radius 0 to unset).");
+	m_pFluxTargetCmd->SetGuidance("[usage] /xe/gun/fluxtarget Radius Halfz Unit");
+
+	G4UIparameter *pFluxTargetParameter;
+
+	pFluxTargetParameter = new G4UIparameter("Radius", 'd', false);
+	pFluxTargetParameter->SetParameterRange("Radius >= 0.");
+	m_pFluxTargetCmd->SetParameter(pFluxTargetParameter);
+	pFluxTargetParameter = new G4UIparameter("Halfz", 'd', false);
+	pFluxTargetParameter->SetParameterRange("Halfz >= 0.");
+	m_pFluxTargetCmd->SetParameter(pFluxTargetParameter);
+	pFluxTargetParameter = new G4UIparameter("Unit", 's', true);
+	pFluxTargetParameter->SetDefaultValue("cm");
+	m_pFluxTargetCmd->SetParameter(pFluxTargetParameter);
+
+	// implantation depth of the surface source
+	m_pSurfaceDepthCmd = new G4UIcommand("/xe/gun/surfacedepth", this);
+	m_pSurfaceDepthCmd->SetGuidance("Set the depth profile below the surface for the Surface source.");
+	m_pSurfaceDepthCmd->SetGuidance("[usage] /xe/gun/surfacedepth Profile Depth Unit");
+	m_pSurfaceDepthCmd->SetGuidance("        None: on the surface (default)");
+	m_pSurfaceDepthCmd->SetGuidance("        Flat: uniform down to Depth");
+	m_pSurfaceDepthCmd->SetGuidance("        Exponential: mean Depth");
+
+	G4UIparameter *pSurfaceDepthParameter;
+
+	pSurfaceDepthParameter = new G4UIparameter("Profile", 's', false);
+	pSurfaceDepthParameter->SetParameterCandidates("None Flat Exponential");
+	m_pSurfaceDepthCmd->SetParameter(pSurfaceDepthParameter);
+	pSurfaceDepthParameter = new G4UIparameter("Depth", 'd', true);
+	pSurfaceDepthParameter->SetDefaultValue("0.");
+	pSurfaceDepthParameter->SetParameterRange("Depth >= 0.");
+	m_pSurfaceDepthCmd->SetParameter(pSurfaceDepthParameter);
+	pSurfaceDepthParameter = new G4UIparameter("Unit", 's', true);
+	pSurfaceDepthParameter->SetDefaultValue("nm");
+	m_pSurfaceDepthCmd->SetParameter(pSurfaceDepthParameter);
+
+	// direction of the surface source
+	m_pSurfaceDirectionCmd = new G4UIcmdWithAString("/xe/gun/surfacedirection", this);
+	m_pSurfaceDirectionCmd->SetGuidance("Direction of the Surface source particles.");
+	m_pSurfaceDirectionCmd->SetGuidance("iso: from /xe/gun/angtype, outward/inward: isotropic in the hemisphere");
+	m_pSurfaceDirectionCmd->SetParameterName("SurfaceDirection", true, true);
+	m_pSurfaceDirectionCmd->SetDefaultValue("iso");
+	m_pSurfaceDirectionCmd->SetCandidates("iso outward inward");
+
+	// externally generated events
+	m_pEventFileCmd = new G4UIcommand("/xe/gun/eventfile", this);
+	m_pEventFileCmd->SetGuidance("Read the primary vertices from an event file, sets the source type to File.");
+	m_pEventFileCmd->SetGuidance("[usage] /xe/gun/eventfile FileName Format");
+	m_pEventFileCmd->SetGuidance("        Format: auto (default), text or binary (see readme/eventfile_format.txt)");
+
+	G4UIparameter *pEventFileParameter;
+
+	pEventFileParameter = new G4UIparameter("FileName", 's', false);
+	m_pEventFileCmd->SetParameter(pEventFileParameter);
+	pEventFileParameter = new G4UIparameter("Format", 's', true);
+	pEventFileParameter->SetDefaultValue("auto");
+	pEventFileParameter->SetParameterCandidates("auto text binary");
+	m_pEventFileCmd->SetParameter(pEventFileParameter);
+
+	m_pEventFilePartitionCmd = new G4UIcommand("/xe/gun/eventfilepartition", this);
+	m_pEventFilePartitionCmd->SetGuidance("Only read the records of one part of the event file, for parallel jobs.");
+	m_pEventFilePartitionCmd->SetGuidance("[usage] /xe/gun/eventfilepartition Index NbPartitions");
+
+	pEventFileParameter = new G4UIparameter("Index", 'i', false);
+	pEventFileParameter->SetParameterRange("Index >= 0");
+	m_pEventFilePartitionCmd->SetParameter(pEventFileParameter);
+	pEventFileParameter = new G4UIparameter("NbPartitions", 'i', false);
+	pEventFileParameter->SetParameterRange("NbPartitions >= 1");
+	m_pEventFilePartitionCmd->SetParameter(pEventFileParameter);
+
+	m_pEventFileOffsetCmd = new G4UIcmdWith3VectorAndUnit("/xe/gun/eventfileoffset", this);
+	m_pEventFileOffsetCmd->SetGuidance("Shift the vertices of the event file to the DARWIN coordinates.");
+	m_pEventFileOffsetCmd->SetParameterName("X", "Y", "Z", true, true);
+	m_pEventFileOffsetCmd->SetDefaultUnit("cm");
+	m_pEventFileOffsetCmd->SetUnitCandidates("nm mum mm cm m km");
+
 	// confine to volume(s)
 	m_pConfineCmd = new G4UIcmdWithAString("/xe/gun/confine", this);
 	m_pConfineCmd->SetGuidance("Confine source to volume(s) (NULL to unset).");
@@ -165,6 +247,20 @@ DARWINParticleSourceMessenger::DARWINParticleSourceMessenger(DARWINParticleSourc
 	m_pVerbosityCmd->SetGuidance(" 2 : Detailed information");
 	m_pVerbosityCmd->SetParameterName("level", false);
 	m_pVerbosityCmd->SetRange("level>=0 && level <=2");
+
+	// sampling throughput
+	m_pTimeSamplingCmd = new G4UIcmdWithAnInteger("/xe/gun/timesampling", this);
+	m_pTimeSamplingCmd->SetGuidance("Generate source positions (with the confinement) and print the rate.");
+	m_pTimeSamplingCmd->SetParameterName("NbPositions", false);
+	m_pTimeSamplingCmd->SetRange("NbPositions > 0");
+	m_pTimeSamplingCmd->AvailableForStates(G4State_Idle);
+
+	// batch generation
+	m_pBatchSizeCmd = new G4UIcmdWithAnInteger("/xe/gun/batchsize", this);
+	m_pBatchSizeCmd->SetGuidance("Generate the primaries in blocks (0 to generate them one by one, default).");
+	m_pBatchSizeCmd->SetGuidance("Only for Point and Volume sources with iso or fixed directions.");
+	m_pBatchSizeCmd->SetParameterName("BatchSize", false);
+	m_pBatchSizeCmd->SetRange("BatchSize >= 0");
 }
 
 DARWINParticleSourceMessenger::~DARWINParticleSourceMessenger()
@@ -174,10 +270,18 @@ DARWINParticleSourceMessenger::~DARWINParticleSourceMessenger()
 	delete m_pCenterCmd;
 	delete m_pHalfzCmd;
 	delete m_pRadiusCmd;
+	delete m_pFluxTargetCmd;
+	delete m_pSurfaceDepthCmd;
+	delete m_pSurfaceDirectionCmd;
+	delete m_pEventFileCmd;
+	delete m_pEventFilePartitionCmd;
+	delete m_pEventFileOffsetCmd;
 	delete m_pConfineCmd;
 	delete m_pAngTypeCmd;
 	delete m_pEnergyTypeCmd;
 	delete m_pVerbosityCmd;
+	delete m_pTimeSamplingCmd;
+	delete m_pBatchSizeCmd;
 	delete m_pIonCmd;
 	delete m_pParticleCmd;
 	delete m_pPositionCmd;
@@ -191,6 +295,9 @@ DARWINParticleSourceMessenger::~DARWINParticleSourceMessenger()
 void
 DARWINParticleSourceMessenger::SetNewValue(G4UIcommand * command, G4String newValues)
 {
+	// primaries generated in advance do not follow the new settings
+	m_pParticleSource->ClearBatch();
+
 	if(command == m_pTypeCmd)
 		m_pParticleSource->SetPosDisType(newValues);
 
@@ -206,6 +313,54 @@ DARWINParticleSourceMessenger::SetNewValue(G4UIcommand * command, G4String newVa
 	else if(command == m_pRadiusCmd)
 		m_pParticleSource->SetRadius(m_pRadiusCmd->GetNewDoubleValue(newValues));
 
+	else if(command == m_pFluxTargetCmd)
+	{
+		G4Tokenizer next(newValues);
+
+		G4double dRadius = StoD(next());
+		G4double dHalfz = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pParticleSource->SetFluxTarget(dRadius*dUnit, dHalfz*dUnit);
+	}
+
+	else if(command == m_pSurfaceDepthCmd)
+	{
+		G4Tokenizer next(newValues);
+
+		G4String hProfile = next();
+		G4double dDepth = StoD(next());
+		G4double dUnit = G4UIcommand::ValueOf(next());
+
+		m_pParticleSource->SetSurfaceDepth(hProfile, dDepth*dUnit);
+	}
+
+	else if(command == m_pSurfaceDirectionCmd)
+		m_pParticleSource->SetSurfaceDirection(newValues);
+
+	else if(command == m_pEventFileCmd)
+	{
+		G4Tokenizer next(newValues);
+
+		G4String hFileName = next();
+		G4String hFormat = next();
+
+		m_pParticleSource->SetEventFile(hFileName, hFormat);
+	}
+
+	else if(command == m_pEventFilePartitionCmd)
+	{
+		G4Tokenizer next(newValues);
+
+		G4int iIndex = StoI(next());
+		G4int iNbPartitions = StoI(next());
+
+		m_pParticleSource->SetEventFilePartition(iIndex, iNbPartitions);
+	}
+
+	else if(command == m_pEventFileOffsetCmd)
+		m_pParticleSource->SetEventFileOffset(m_pEventFileOffsetCmd->GetNew3VectorValue(newValues));
+
 	else if(command == m_pAngTypeCmd)
 		m_pParticleSource->SetAngDistType(newValues);
 
@@ -289,6 +444,12 @@ DARWINParticleSourceMessenger::SetNewValue(G4UIcommand * command, G4String newVa
 		}
 	}
 
+	else if(command == m_pBatchSizeCmd)
+		m_pParticleSource->SetBatchSize(m_pBatchSizeCmd->GetNewIntValue(newValues));
+
+	else if(command == m_pTimeSamplingCmd)
+		m_pParticleSource->TimeSampling(m_pTimeSamplingCmd->GetNewIntValue(newValues));
+
 	else if(command == m_pListCmd)
 		m_pParticleTable->DumpTable();
 
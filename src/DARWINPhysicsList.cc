@@ -0,0 +1,122 @@
+#include <G4EmLivermorePhysics.hh>
+#include <G4EmStandardPhysics.hh>
+#include <G4EmExtraPhysics.hh>
+#include <G4DecayPhysics.hh>
+#include <G4RadioactiveDecayPhysics.hh>
+#include <G4HadronElasticPhysicsHP.hh>
+#include <G4HadronPhysicsQGSP_BERT_HP.hh>
+#include <G4HadronPhysicsShielding.hh>
+#include <G4StoppingPhysics.hh>
+#include <G4IonPhysics.hh>
+#include <G4IonQMDPhysics.hh>
+#include <G4NeutronTrackingCut.hh>
+#include <G4OpticalPhysics.hh>
+#include <G4StepLimiterPhysics.hh>
+#include <G4ios.hh>
+
+#include "DARWINPhysicsListMessenger.hh"
+
+#include "DARWINPhysicsList.hh"
+
+DARWINPhysicsList::DARWINPhysicsList(const G4String &hList)
+{
+	m_hList = "QGSP_BERT_HP";
+	m_bOpticalPhysics = false;
+	m_bRadioactiveDecay = true;
+	m_bBuilt = false;
+
+	SetVerboseLevel(0);
+
+	SetList(hList);
+
+	m_pMessenger = new DARWINPhysicsListMessenger(this);
+}
+
+DARWINPhysicsList::~DARWINPhysicsList()
+{
+	delete m_pMessenger;
+}
+
+void
+DARWINPhysicsList::ConstructParticle()
+{
+	// the run manager asks for the particles as soon as the physics list is
+	// registered, the constructors are only created at that point so that
+	// the /Xe/physics/ commands of the preinit macro are taken into account
+	if(!m_bBuilt)
+		RegisterConstructors();
+
+	G4VModularPhysicsList::ConstructParticle();
+}
+
+G4bool
+DARWINPhysicsList::SetList(const G4String &hList)
+{
+	if(m_bBuilt)
+	{
+		G4cout << "Error: physics list already built, cannot switch to " << hList << "!" << G4endl;
+		return false;
+	}
+
+	if(hList != "EM" && hList != "QGSP_BERT_HP" && hList != "Shielding")
+	{
+		G4cout << "Error: unknown physics list " << hList << ", available lists are: " << GetAvailableLists() << G4endl;
+		return false;
+	}
+
+	m_hList = hList;
+
+	return true;
+}
+
+void
+DARWINPhysicsList::RegisterConstructors()
+{
+	G4int iVerbose = 0;
+
+	G4cout << "----> Physics list: " << m_hList
+		<< ", radioactive decay " << ((m_bRadioactiveDecay)?("on"):("off"))
+		<< ", optical physics " << ((m_bOpticalPhysics)?("on"):("off")) << G4endl;
+
+	if(m_hList == "EM")
+	{
+		// electromagnetic interactions and decays only, no hadronic tables and no
+		// neutron data are loaded which keeps the startup short for gamma sources
+		RegisterPhysics(new G4EmLivermorePhysics(iVerbose));
+		RegisterPhysics(new G4DecayPhysics(iVerbose));
+	}
+	else if(m_hList == "QGSP_BERT_HP")
+	{
+		RegisterPhysics(new G4EmStandardPhysics(iVerbose));
+		RegisterPhysics(new G4EmExtraPhysics(iVerbose));
+		RegisterPhysics(new G4DecayPhysics(iVerbose));
+		RegisterPhysics(new G4HadronElasticPhysicsHP(iVerbose));
+		RegisterPhysics(new G4HadronPhysicsQGSP_BERT_HP(iVerbose));
+		RegisterPhysics(new G4StoppingPhysics(iVerbose));
+		RegisterPhysics(new G4IonPhysics(iVerbose));
+		RegisterPhysics(new G4NeutronTrackingCut(iVerbose));
+	}
+	else if(m_hList == "Shielding")
+	{
+		RegisterPhysics(new G4EmStandardPhysics(iVerbose));
+		RegisterPhysics(new G4EmExtraPhysics(iVerbose));
+		RegisterPhysics(new G4DecayPhysics(iVerbose));
+		RegisterPhysics(new G4HadronElasticPhysicsHP(iVerbose));
+		RegisterPhysics(new G4HadronPhysicsShielding(iVerbose));
+		RegisterPhysics(new G4StoppingPhysics(iVerbose));
+		RegisterPhysics(new G4IonQMDPhysics(iVerbose));
+		RegisterPhysics(new G4NeutronTrackingCut(iVerbose));
+	}
+
+	if(m_bRadioactiveDecay)
+		RegisterPhysics(new G4RadioactiveDecayPhysics(iVerbose));
+
+	if(m_bOpticalPhysics)
+		RegisterPhysics(new G4OpticalPhysics(iVerbose));
+
+	// honours the maximum step of the regions (/Xe/cuts/setMaxStep)
+	RegisterPhysics(new G4StepLimiterPhysics());
+
+	m_bBuilt = true;
+}
+
@@ -0,0 +1,65 @@
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4ios.hh>
+
+#include "DARWINPhysicsList.hh"
+
+#include "DARWINPhysicsListMessenger.hh"
+
+DARWINPhysicsListMessenger::DARWINPhysicsListMessenger(DARWINPhysicsList *pPhysicsList)
+:m_pPhysicsList(pPhysicsList)
+{
+	m_pPhysicsDir = new G4UIdirectory("/Xe/physics/");
+	m_pPhysicsDir->SetGuidance("physics list control.");
+	m_pPhysicsDir->SetGuidance("All commands must be issued before the physics list is handed to the run manager (preinit macro, -c).");
+
+	m_pListCmd = new G4UIcmdWithAString("/Xe/physics/setList", this);
+	m_pListCmd->SetGuidance("Select the physics list.");
+	m_pListCmd->SetGuidance("  EM           : Livermore low energy EM + decay, no hadronic physics (gamma/beta sources)");
+	m_pListCmd->SetGuidance("  QGSP_BERT_HP : reference list with high precision neutron transport");
+	m_pListCmd->SetGuidance("  Shielding    : reference list for shielding and activation studies");
+	m_pListCmd->SetParameterName("List", false);
+	m_pListCmd->SetCandidates(DARWINPhysicsList::GetAvailableLists());
+	m_pListCmd->AvailableForStates(G4State_PreInit);
+
+	m_pOpticalPhysicsCmd = new G4UIcmdWithABool("/Xe/physics/setOpticalPhysics", this);
+	m_pOpticalPhysicsCmd->SetGuidance("Switch on/off optical physics (scintillation, absorption, Rayleigh, boundary).");
+	m_pOpticalPhysicsCmd->SetGuidance("Only needed when LXe scintillation is switched on with /Xe/detector/setLXeScintillation.");
+	m_pOpticalPhysicsCmd->SetParameterName("Optical", false);
+	m_pOpticalPhysicsCmd->AvailableForStates(G4State_PreInit);
+
+	m_pRadioactiveDecayCmd = new G4UIcmdWithABool("/Xe/physics/setRadioactiveDecay", this);
+	m_pRadioactiveDecayCmd->SetGuidance("Switch on/off the radioactive decay module (needed for ion sources).");
+	m_pRadioactiveDecayCmd->SetParameterName("RDM", false);
+	m_pRadioactiveDecayCmd->AvailableForStates(G4State_PreInit);
+}
+
+DARWINPhysicsListMessenger::~DARWINPhysicsListMessenger()
+{
+	delete m_pListCmd;
+	delete m_pOpticalPhysicsCmd;
+	delete m_pRadioactiveDecayCmd;
+
+	delete m_pPhysicsDir;
+}
+
+void
+DARWINPhysicsListMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValue)
+{
+	if(m_pPhysicsList->IsBuilt())
+	{
+		G4cout << "Error: the physics list has already been built, " << pUIcommand->GetCommandPath() << " ignored!" << G4endl;
+		return;
+	}
+
+	if(pUIcommand == m_pListCmd)
+		m_pPhysicsList->SetList(hNewValue);
+
+	if(pUIcommand == m_pOpticalPhysicsCmd)
+		m_pPhysicsList->SetOpticalPhysics(m_pOpticalPhysicsCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pRadioactiveDecayCmd)
+		m_pPhysicsList->SetRadioactiveDecay(m_pRadioactiveDecayCmd->GetNewBoolValue(hNewValue));
+}
+
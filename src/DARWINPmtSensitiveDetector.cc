@@ -6,6 +6,9 @@
 #include <G4ios.hh>
 
 #include <map>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
 
 using namespace std;
 
@@ -14,6 +17,14 @@ using namespace std;
 DARWINPmtSensitiveDetector::DARWINPmtSensitiveDetector(G4String hName): G4VSensitiveDetector(hName)
 {
 	collectionName.insert("PmtHitsCollection");
+
+	m_iTimingMode = kNoTiming;
+	m_iNbFirstTimes = 0;
+	m_dResolution = 1.*ns;
+	m_dBinWidth = 1.*ns;
+	m_iNbBins = 0;
+
+	m_dFirstPhotonTime = DBL_MAX;
 }
 
 DARWINPmtSensitiveDetector::~DARWINPmtSensitiveDetector()
@@ -30,6 +41,19 @@ void DARWINPmtSensitiveDetector::Initialize(G4HCofThisEvent* pHitsCollectionOfTh
 		iHitsCollectionID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
 	
 	pHitsCollectionOfThisEvent->AddHitsCollection(iHitsCollectionID, m_pPmtHitsCollection); 
+
+	// reset only the timing buffers of the pmts hit in the previous event
+	for(vector<G4int>::iterator pIt = m_hTimedPmts.begin(); pIt != m_hTimedPmts.end(); pIt++)
+	{
+		m_hNbTimes[*pIt] = 0;
+		if(m_iTimingMode == kTimeHistogram)
+			fill(m_hTimeBins.begin()+(*pIt)*m_iNbBins, m_hTimeBins.begin()+(*pIt+1)*m_iNbBins, 0);
+	}
+	m_hTimedPmts.clear();
+
+	m_dFirstPhotonTime = DBL_MAX;
+	m_hPhotonPmts.clear();
+	m_hPhotonTimes.clear();
 }
 
 G4bool DARWINPmtSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory *pHistory)
@@ -46,6 +70,9 @@ G4bool DARWINPmtSensitiveDetector::ProcessHits(G4Step* pStep, G4TouchableHistory
 
 		m_pPmtHitsCollection->insert(pHit);
 
+		if(m_iTimingMode != kNoTiming)
+			AddPhotonTime(pHit->GetPmtNb(), pHit->GetTime());
+
 		//		pHit->Print();
 //		pHit->Draw();
 
@@ -67,3 +94,101 @@ void DARWINPmtSensitiveDetector::EndOfEvent(G4HCofThisEvent *pHitsCollectionOfTh
 //    } 
 }
 
+void
+DARWINPmtSensitiveDetector::SetTiming(TimingMode iMode, G4int iNbPmts, G4int iNbFirstTimes, G4double dResolution, G4double dBinWidth, G4int iNbBins)
+{
+	m_iTimingMode = iMode;
+	m_iNbFirstTimes = iNbFirstTimes;
+	m_dResolution = dResolution;
+	m_dBinWidth = dBinWidth;
+	m_iNbBins = iNbBins;
+
+	m_hTimedPmts.clear();
+	m_hNbTimes.assign((iMode != kNoTiming)?(iNbPmts):(0), 0);
+	m_hFirstTimes.assign((iMode == kFirstTimes)?(iNbPmts*iNbFirstTimes):(0), 0.);
+	m_hTimeBins.assign((iMode == kTimeHistogram)?(iNbPmts*iNbBins):(0), 0);
+}
+
+void
+DARWINPmtSensitiveDetector::AddPhotonTime(G4int iPmtNb, G4double dTime)
+{
+	if(iPmtNb < 0 || iPmtNb >= (G4int) m_hNbTimes.size())
+		return;
+
+	G4int &iNbTimes = m_hNbTimes[iPmtNb];
+
+	if(!iNbTimes)
+		m_hTimedPmts.push_back(iPmtNb);
+
+	if(dTime < m_dFirstPhotonTime)
+		m_dFirstPhotonTime = dTime;
+
+	if(m_iTimingMode == kFirstTimes)
+	{
+		// keep the earliest times sorted, photons do not arrive in time order
+		G4double *pTimes = &m_hFirstTimes[iPmtNb*m_iNbFirstTimes];
+
+		if(iNbTimes == m_iNbFirstTimes && dTime >= pTimes[iNbTimes-1])
+			return;
+
+		G4int iPos = (iNbTimes < m_iNbFirstTimes)?(iNbTimes++):(m_iNbFirstTimes-1);
+		for(; iPos > 0 && pTimes[iPos-1] > dTime; iPos--)
+			pTimes[iPos] = pTimes[iPos-1];
+		pTimes[iPos] = dTime;
+	}
+	else
+	{
+		// binned once the first photon of the event is known
+		iNbTimes++;
+		m_hPhotonPmts.push_back(iPmtNb);
+		m_hPhotonTimes.push_back(dTime);
+	}
+}
+
+void
+DARWINPmtSensitiveDetector::GetPackedTiming(vector<int> *pPmtIds, vector<unsigned short> *pNbValues, vector<unsigned short> *pValues)
+{
+	if(m_iTimingMode == kNoTiming)
+		return;
+
+	sort(m_hTimedPmts.begin(), m_hTimedPmts.end());
+
+	// the bins of the timed pmts are reset with the next event
+	for(size_t i = 0; i < m_hPhotonTimes.size(); i++)
+	{
+		G4int iBin = (G4int) floor((m_hPhotonTimes[i]-m_dFirstPhotonTime)/m_dBinWidth);
+		if(iBin >= 0 && iBin < m_iNbBins)
+		{
+			unsigned short &iContent = m_hTimeBins[m_hPhotonPmts[i]*m_iNbBins+iBin];
+			if(iContent < 65535)
+				iContent++;
+		}
+	}
+	m_hPhotonPmts.clear();
+	m_hPhotonTimes.clear();
+
+	for(vector<G4int>::iterator pIt = m_hTimedPmts.begin(); pIt != m_hTimedPmts.end(); pIt++)
+	{
+		G4int iPmtNb = *pIt;
+
+		pPmtIds->push_back(iPmtNb);
+
+		if(m_iTimingMode == kFirstTimes)
+		{
+			pNbValues->push_back(m_hNbTimes[iPmtNb]);
+
+			// times since the first photon in units of the resolution, saturated at 65535
+			for(G4int i = 0; i < m_hNbTimes[iPmtNb]; i++)
+			{
+				G4double dTicks = floor((m_hFirstTimes[iPmtNb*m_iNbFirstTimes+i]-m_dFirstPhotonTime)/m_dResolution);
+				pValues->push_back((dTicks < 65535.)?((unsigned short) dTicks):(65535));
+			}
+		}
+		else
+		{
+			pNbValues->push_back(m_iNbBins);
+			pValues->insert(pValues->end(), m_hTimeBins.begin()+iPmtNb*m_iNbBins, m_hTimeBins.begin()+(iPmtNb+1)*m_iNbBins);
+		}
+	}
+}
+
@@ -4,16 +4,22 @@
 #include <Randomize.hh>
 
 #include "DARWINParticleSource.hh"
+#include "DARWINStackingAction.hh"
 
 #include "DARWINPrimaryGeneratorAction.hh"
 
 DARWINPrimaryGeneratorAction::DARWINPrimaryGeneratorAction()
 {
 	m_pParticleSource = new DARWINParticleSource();
+	m_pStackingAction = 0;
 
 	m_hParticleTypeOfPrimary = "";
 	m_dEnergyOfPrimary = 0.;
 	m_hPositionOfPrimary = G4ThreeVector(0., 0., 0.);
+	m_dEventWeight = 1.;
+
+	m_iChainId = -1;
+	m_dChainTime = 0.;
 
 	m_lSeeds[0] = -1;
 	m_lSeeds[1] = -1;
@@ -24,6 +30,14 @@ DARWINPrimaryGeneratorAction::~DARWINPrimaryGeneratorAction()
 	delete m_pParticleSource;
 }
 
+G4bool
+DARWINPrimaryGeneratorAction::IsInChain()
+{
+	G4StackManager *pStackManager = (G4RunManagerKernel::GetRunManagerKernel())->GetStackManager();
+
+	return (m_pStackingAction && m_pStackingAction->HasPendingTracks()) || pStackManager->GetNPostponedTrack();
+}
+
 void
 DARWINPrimaryGeneratorAction::GeneratePrimaries(G4Event *pEvent)
 {
@@ -38,9 +52,22 @@ DARWINPrimaryGeneratorAction::GeneratePrimaries(G4Event *pEvent)
 //        << pStackManager->GetNPostponedTrack() << " postponed"
 //        << G4endl;
 
-	if(!pStackManager->GetNPostponedTrack())
+	if(m_pStackingAction && m_pStackingAction->HasPendingTracks())
+	{
+		// pileup mode, decay products that were outside the time window of the previous event
+		vector<DARWINStackingAction::PendingTrack> hTracks;
+		m_dChainTime += m_pStackingAction->PopPendingTracks(hTracks);
+
+		for(G4int i=0; i<(G4int) hTracks.size(); i++)
+			m_pParticleSource->GeneratePrimaryVertexFromDecay(hTracks[i].pDefinition,
+				hTracks[i].hPosition, hTracks[i].hMomentum, hTracks[i].dTime, pEvent);
+	}
+	else if(!pStackManager->GetNPostponedTrack())
 	{
 		m_pParticleSource->GeneratePrimaryVertex(pEvent);
+
+		m_iChainId++;
+		m_dChainTime = 0.;
 	}
 	else
 	{
@@ -50,9 +77,24 @@ DARWINPrimaryGeneratorAction::GeneratePrimaries(G4Event *pEvent)
 
 		m_pParticleSource->GeneratePrimaryVertexFromTrack(pTrack, pEvent);
 
+		// the daughter was created at the decay of its parent
+		m_dChainTime += pTrack->GetGlobalTime();
+
 		delete pTrack;
 	}
+	// decay products of a chain keep the weight of the event that started it
+	m_dEventWeight = m_pParticleSource->GetEventWeight();
+
+	// records of an event file can have no particle to track
 	G4PrimaryVertex *pVertex = pEvent->GetPrimaryVertex();
+	if(!pVertex || !pVertex->GetPrimary())
+	{
+		m_hParticleTypeOfPrimary = "";
+		m_dEnergyOfPrimary = 0.;
+		m_hPositionOfPrimary = (pVertex)?(pVertex->GetPosition()):(G4ThreeVector(0., 0., 0.));
+		return;
+	}
+
 	G4PrimaryParticle *pPrimaryParticle = pVertex->GetPrimary();
 
 	m_hParticleTypeOfPrimary = pPrimaryParticle->GetG4code()->GetParticleName();
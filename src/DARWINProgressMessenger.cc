@@ -0,0 +1,47 @@
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+
+#include "DARWINProgressReporter.hh"
+
+#include "DARWINProgressMessenger.hh"
+
+DARWINProgressMessenger::DARWINProgressMessenger(DARWINProgressReporter *pProgressReporter)
+:m_pProgressReporter(pProgressReporter)
+{
+	m_pProgressDir = new G4UIdirectory("/Xe/progress/");
+	m_pProgressDir->SetGuidance("progress report control.");
+
+	m_pIntervalCmd = new G4UIcmdWithADoubleAndUnit("/Xe/progress/setInterval", this);
+	m_pIntervalCmd->SetGuidance("Wall time between two progress reports, 0 switches the reports off.");
+	m_pIntervalCmd->SetParameterName("Interval", false);
+	m_pIntervalCmd->SetRange("Interval >= 0.");
+	m_pIntervalCmd->SetUnitCategory("Time");
+	m_pIntervalCmd->SetDefaultUnit("s");
+	m_pIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pStatusFileCmd = new G4UIcmdWithAString("/Xe/progress/setStatusFile", this);
+	m_pStatusFileCmd->SetGuidance("Also write every report to this file (key value pairs, replaced atomically).");
+	m_pStatusFileCmd->SetParameterName("Filename", false);
+	m_pStatusFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+DARWINProgressMessenger::~DARWINProgressMessenger()
+{
+	delete m_pIntervalCmd;
+	delete m_pStatusFileCmd;
+
+	delete m_pProgressDir;
+}
+
+void
+DARWINProgressMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValue)
+{
+	// the wall time is measured in seconds, not in G4 time units
+	if(pUIcommand == m_pIntervalCmd)
+		m_pProgressReporter->SetInterval(m_pIntervalCmd->GetNewDoubleValue(hNewValue)/s);
+
+	if(pUIcommand == m_pStatusFileCmd)
+		m_pProgressReporter->SetStatusFilename(hNewValue);
+}
+
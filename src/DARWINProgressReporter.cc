@@ -0,0 +1,187 @@
+#include <G4Event.hh>
+
+#include <cstdio>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <time.h>
+#include <unistd.h>
+
+using std::stringstream;
+using std::ofstream;
+
+#include "DARWINAnalysisManager.hh"
+#include "DARWINProgressMessenger.hh"
+
+#include "DARWINProgressReporter.hh"
+
+DARWINProgressReporter::DARWINProgressReporter(DARWINAnalysisManager *pAnalysisManager)
+{
+	m_pAnalysisManager = pAnalysisManager;
+
+	m_dInterval = 60.;
+
+	m_iNbEventsToProcess = 0;
+	m_iNbEventsDone = 0;
+
+	m_dStartTime = GetWallTime();
+	m_dNextReportTime = m_dStartTime;
+	m_dLastReportTime = m_dStartTime;
+	m_iLastReportEvents = 0;
+
+	m_pMessenger = new DARWINProgressMessenger(this);
+}
+
+DARWINProgressReporter::~DARWINProgressReporter()
+{
+	delete m_pMessenger;
+}
+
+void
+DARWINProgressReporter::BeginOfRun(G4int iNbEventsToProcess)
+{
+	m_iNbEventsToProcess = iNbEventsToProcess;
+	m_iNbEventsDone = 0;
+
+	m_dStartTime = GetWallTime();
+	m_dNextReportTime = m_dStartTime + m_dInterval;
+	m_dLastReportTime = m_dStartTime;
+	m_iLastReportEvents = 0;
+}
+
+void
+DARWINProgressReporter::EndOfEvent(const G4Event *)
+{
+	m_iNbEventsDone++;
+
+	// one clock read per event, everything else only when a report is due
+	if(m_dInterval > 0.)
+	{
+		G4double dTime = GetWallTime();
+
+		if(dTime >= m_dNextReportTime)
+			Report(dTime, false);
+	}
+}
+
+void
+DARWINProgressReporter::EndOfRun()
+{
+	if(m_dInterval > 0.)
+		Report(GetWallTime(), true);
+}
+
+void
+DARWINProgressReporter::Report(G4double dTime, G4bool bFinal)
+{
+	G4double dElapsed = dTime - m_dStartTime;
+	G4double dSinceLast = dTime - m_dLastReportTime;
+
+	G4double dAverageRate = (dElapsed > 0.)?(m_iNbEventsDone/dElapsed):(0.);
+	G4double dInstantRate = (dSinceLast > 0.)?((m_iNbEventsDone-m_iLastReportEvents)/dSinceLast):(0.);
+
+	// the ETA uses the average rate, the instantaneous one fluctuates too much for neutrons
+	G4double dEta = -1.;
+	if(m_iNbEventsToProcess > 0 && dAverageRate > 0.)
+		dEta = (m_iNbEventsToProcess-m_iNbEventsDone)/dAverageRate;
+
+	G4double dRss = GetResidentMemory();
+
+	G4int iNbEventsWritten = (m_pAnalysisManager)?(m_pAnalysisManager->GetNbEventsWritten()):(0);
+
+	stringstream hLine;
+	hLine << std::fixed;
+	hLine << "----> " << ((bFinal)?("Done"):("Progress")) << ": " << m_iNbEventsDone;
+	if(m_iNbEventsToProcess > 0)
+		hLine << "/" << m_iNbEventsToProcess << " events (" << std::setprecision(1) << 100.*m_iNbEventsDone/m_iNbEventsToProcess << "%)";
+	else
+		hLine << " events";
+	hLine << std::setprecision(2)
+		<< ", " << dInstantRate << " ev/s now, " << dAverageRate << " ev/s avg, "
+		<< iNbEventsWritten << " written, elapsed " << FormatDuration(dElapsed);
+	if(!bFinal)
+		hLine << ", ETA " << ((dEta >= 0.)?(FormatDuration(dEta)):(G4String("unknown")));
+	hLine << ", RSS " << std::setprecision(1) << dRss << " MB";
+
+	G4cout << hLine.str() << G4endl;
+
+	if(!m_hStatusFilename.empty())
+		WriteStatusFile(dTime, dInstantRate, dAverageRate, dEta, dRss, bFinal);
+
+	m_dLastReportTime = dTime;
+	m_iLastReportEvents = m_iNbEventsDone;
+
+	// stay on the interval grid even if an event took longer than the interval
+	while(m_dNextReportTime <= dTime)
+		m_dNextReportTime += m_dInterval;
+}
+
+void
+DARWINProgressReporter::WriteStatusFile(G4double dTime, G4double dInstantRate, G4double dAverageRate, G4double dEta, G4double dRss, G4bool bFinal)
+{
+	// write to a temporary file and rename it so that a monitor never reads a partial file
+	G4String hTemporaryFilename = m_hStatusFilename + ".tmp";
+
+	ofstream hStatusFile(hTemporaryFilename.c_str());
+	if(!hStatusFile)
+	{
+		G4cout << "Error: cannot write status file " << hTemporaryFilename << G4endl;
+		return;
+	}
+
+	hStatusFile << std::fixed << std::setprecision(3);
+	hStatusFile << "state " << ((bFinal)?("done"):("running")) << "\n";
+	hStatusFile << "pid " << getpid() << "\n";
+	hStatusFile << "time " << (long) time(0) << "\n";
+	hStatusFile << "events_done " << m_iNbEventsDone << "\n";
+	hStatusFile << "events_total " << m_iNbEventsToProcess << "\n";
+	hStatusFile << "events_written " << ((m_pAnalysisManager)?(m_pAnalysisManager->GetNbEventsWritten()):(0)) << "\n";
+	hStatusFile << "rate_instant " << dInstantRate << "\n";
+	hStatusFile << "rate_average " << dAverageRate << "\n";
+	hStatusFile << "elapsed_s " << dTime - m_dStartTime << "\n";
+	hStatusFile << "eta_s " << dEta << "\n";
+	hStatusFile << "rss_mb " << dRss << "\n";
+	hStatusFile.close();
+
+	if(rename(hTemporaryFilename.c_str(), m_hStatusFilename.c_str()) != 0)
+		G4cout << "Error: cannot rename status file " << hTemporaryFilename << G4endl;
+}
+
+G4double
+DARWINProgressReporter::GetWallTime()
+{
+	struct timespec hTime;
+	clock_gettime(CLOCK_MONOTONIC, &hTime);
+
+	return hTime.tv_sec + 1.e-9*hTime.tv_nsec;
+}
+
+G4double
+DARWINProgressReporter::GetResidentMemory()
+{
+	// resident set size in MB, second field of /proc/self/statm in pages
+	long lSize = 0, lResident = 0;
+
+	FILE *pStatm = fopen("/proc/self/statm", "r");
+	if(pStatm)
+	{
+		if(fscanf(pStatm, "%ld %ld", &lSize, &lResident) != 2)
+			lResident = 0;
+		fclose(pStatm);
+	}
+
+	return lResident*(sysconf(_SC_PAGESIZE)/1024.)/1024.;
+}
+
+G4String
+DARWINProgressReporter::FormatDuration(G4double dSeconds)
+{
+	long lSeconds = (long) (dSeconds+0.5);
+
+	char szDuration[32];
+	snprintf(szDuration, sizeof(szDuration), "%ldd %02ld:%02ld:%02ld",
+		lSeconds/86400, (lSeconds/3600)%24, (lSeconds/60)%60, lSeconds%60);
+
+	return G4String(szDuration);
+}
+
@@ -0,0 +1,43 @@
+#include <G4ios.hh>
+
+#include <cmath>
+
+#include "DARWINQuenchingModel.hh"
+
+DARWINQuenchingModel::DARWINQuenchingModel()
+{
+	m_hModel = "Lindhard";
+	m_dLindhardK = 0.166;
+}
+
+DARWINQuenchingModel::~DARWINQuenchingModel()
+{
+}
+
+G4bool
+DARWINQuenchingModel::SetModel(const G4String &hModel)
+{
+	if(hModel != "Lindhard" && hModel != "None")
+	{
+		G4cout << "Error: unknown quenching model " << hModel << G4endl;
+		return false;
+	}
+
+	m_hModel = hModel;
+
+	return true;
+}
+
+G4double
+DARWINQuenchingModel::GetQuenchingFactor(G4double dRecoilEnergy) const
+{
+	if(m_hModel == "None" || dRecoilEnergy <= 0.)
+		return 1.;
+
+	// reduced energy for Z = 54, eps = 11.5 E[keV] Z^(-7/3)
+	const G4double dZ = 54.;
+	G4double dEpsilon = 11.5*(dRecoilEnergy/keV)*std::pow(dZ, -7./3.);
+	G4double dG = 3.*std::pow(dEpsilon, 0.15)+0.7*std::pow(dEpsilon, 0.6)+dEpsilon;
+
+	return m_dLindhardK*dG/(1.+m_dLindhardK*dG);
+}
@@ -0,0 +1,153 @@
+#include <TFile.h>
+#include <TTree.h>
+
+#include "DARWINEventData.hh"
+#include "DARWINOutputSettings.hh"
+
+#include "DARWINRootOutput.hh"
+
+DARWINRootOutput::DARWINRootOutput(TFile *pFile, DARWINEventData *pEventData, const DARWINOutputSettings *pOutputSettings, const DARWINOutputColumns &hColumns)
+{
+	m_pFile = pFile;
+	m_pTree = 0;
+
+	m_pEventData = pEventData;
+	m_pOutputSettings = pOutputSettings;
+	m_hColumns = hColumns;
+}
+
+DARWINRootOutput::~DARWINRootOutput()
+{
+	Close();
+}
+
+G4bool
+DARWINRootOutput::Open(const G4String &hFilename)
+{
+	if(!m_pFile || hFilename != m_pFile->GetName())
+	{
+		G4cout << "Error: the t1 tree of " << hFilename << " needs its open file!" << G4endl;
+		return false;
+	}
+
+	m_pFile->cd();
+	BookTree();
+
+	return true;
+}
+
+void
+DARWINRootOutput::Close()
+{
+	m_pTree = 0;
+}
+
+void
+DARWINRootOutput::WriteEvent(const DARWINEventData *pEventData)
+{
+	m_pTree->Fill();
+}
+
+void
+DARWINRootOutput::Flush()
+{
+	m_pTree->AutoSave("SaveSelf");
+}
+
+G4long
+DARWINRootOutput::GetBytesWritten() const
+{
+	// the baskets already written
+	return m_pFile->GetEND();
+}
+
+void
+DARWINRootOutput::BookTree()
+{
+	m_pTree = new TTree("t1", "Tree containing event data for DARWIN");
+
+	m_pTree->Branch("eventid", &m_pEventData->m_iEventId, "eventid/I");
+	m_pTree->Branch("chainid", &m_pEventData->m_iChainId, "chainid/I");
+	m_pTree->Branch("chaintime", &m_pEventData->m_dChainTime, "chaintime/D");
+	m_pTree->Branch("weight", &m_pEventData->m_fWeight, "weight/F");
+	m_pTree->Branch("ntpmthits", &m_pEventData->m_iNbTopPmtHits, "ntpmthits/I");
+	m_pTree->Branch("nbpmthits", &m_pEventData->m_iNbBottomPmtHits, "nbpmthits/I");
+	if(m_hColumns.bSparsePmtHits)
+	{
+		m_pTree->Branch("pmthitid", "vector<int>", &m_pEventData->m_pPmtHitId);
+		m_pTree->Branch("pmthitcount", "vector<int>", &m_pEventData->m_pPmtHitCount);
+		if(m_hColumns.bPmtHitTimes)
+			m_pTree->Branch("pmthittime", "vector<float>", &m_pEventData->m_pPmtHitTime);
+	}
+	else
+		m_pTree->Branch("pmthits", "vector<int>", &m_pEventData->m_pPmtHits);
+	if(m_hColumns.bPmtTiming)
+	{
+		m_pTree->Branch("pmttimeid", "vector<int>", &m_pEventData->m_pPmtTimeId);
+		m_pTree->Branch("pmttimen", "vector<unsigned short>", &m_pEventData->m_pPmtTimeN);
+		m_pTree->Branch("pmttimes", "vector<unsigned short>", &m_pEventData->m_pPmtTimes);
+		m_pTree->Branch("pmttime0", &m_pEventData->m_dPmtTime0, "pmttime0/D");
+	}
+	m_pTree->Branch("etot", &m_pEventData->m_fTotalEnergyDeposited, "etot/F");
+	m_pTree->Branch("nsteps", &m_pEventData->m_iNbSteps, "nsteps/I");
+
+	if(m_hColumns.bTrackTable)
+	{
+		m_pTree->Branch("trk_id", "vector<int>", &m_pEventData->m_pTrackTableId);
+		m_pTree->Branch("trk_parentid", "vector<int>", &m_pEventData->m_pTrackTableParentId);
+		m_pTree->Branch("trk_pdg", "vector<int>", &m_pEventData->m_pTrackTablePdg);
+		m_pTree->Branch("trk_creaproc", "vector<string>", &m_pEventData->m_pTrackTableCreatorProcess);
+		m_pTree->Branch("trk_xp", "vector<float>", &m_pEventData->m_pTrackTableX);
+		m_pTree->Branch("trk_yp", "vector<float>", &m_pEventData->m_pTrackTableY);
+		m_pTree->Branch("trk_zp", "vector<float>", &m_pEventData->m_pTrackTableZ);
+		m_pTree->Branch("trk_e", "vector<float>", &m_pEventData->m_pTrackTableEnergy);
+
+		m_pTree->Branch("trkindex", "vector<int>", &m_pEventData->m_pStepTrackIndex);
+	}
+	else
+	{
+		m_pTree->Branch("trackid", "vector<int>", &m_pEventData->m_pTrackId);
+		m_pTree->Branch("type", "vector<string>", &m_pEventData->m_pParticleType);
+		m_pTree->Branch("parentid", "vector<int>", &m_pEventData->m_pParentId);
+		m_pTree->Branch("parenttype", "vector<string>", &m_pEventData->m_pParentType);
+		m_pTree->Branch("creaproc", "vector<string>", &m_pEventData->m_pCreatorProcess);
+	}
+	m_pTree->Branch("edproc", "vector<string>", &m_pEventData->m_pDepositingProcess);
+	m_pTree->Branch("xp", "vector<float>", &m_pEventData->m_pX);
+	m_pTree->Branch("yp", "vector<float>", &m_pEventData->m_pY);
+	m_pTree->Branch("zp", "vector<float>", &m_pEventData->m_pZ);
+	m_pTree->Branch("ed", "vector<float>", &m_pEventData->m_pEnergyDeposited);
+	m_pTree->Branch("time", "vector<float>", &m_pEventData->m_pTime);
+
+	if(m_hColumns.bRecoilClusters)
+	{
+		m_pTree->Branch("nr", "vector<int>", &m_pEventData->m_pNr);
+		m_pTree->Branch("cl_xp", "vector<float>", &m_pEventData->m_pClusterX);
+		m_pTree->Branch("cl_yp", "vector<float>", &m_pEventData->m_pClusterY);
+		m_pTree->Branch("cl_zp", "vector<float>", &m_pEventData->m_pClusterZ);
+		m_pTree->Branch("cl_enr", "vector<float>", &m_pEventData->m_pClusterNrEnergy);
+		m_pTree->Branch("cl_eer", "vector<float>", &m_pEventData->m_pClusterErEnergy);
+		m_pTree->Branch("cl_eee", "vector<float>", &m_pEventData->m_pClusterEeEnergy);
+	}
+
+	if(m_hColumns.bFastS2)
+	{
+		m_pTree->Branch("s2pmthits", "vector<int>", &m_pEventData->m_pS2PmtHits);
+		m_pTree->Branch("s2ne", "vector<int>", &m_pEventData->m_pS2Electrons);
+		m_pTree->Branch("s2time", "vector<float>", &m_pEventData->m_pS2Time);
+		m_pTree->Branch("s2width", "vector<float>", &m_pEventData->m_pS2Width);
+	}
+
+	m_pTree->Branch("type_pri", "vector<string>", &m_pEventData->m_pPrimaryParticleType);
+	m_pTree->Branch("xp_pri", &m_pEventData->m_fPrimaryX, 	"xp_pri/F");
+	m_pTree->Branch("yp_pri", &m_pEventData->m_fPrimaryY, 	"yp_pri/F");
+	m_pTree->Branch("zp_pri", &m_pEventData->m_fPrimaryZ, 	"zp_pri/F");
+	m_pTree->Branch("e_pri",  &m_pEventData->m_fPrimaryE,	"e_pri/F");
+
+	// write everything to one file, do not switch: ROOT would replace the file under
+	// the analysis manager, files are only split by the rotation (setMaxFileSize)
+	m_pTree->SetMaxTreeSize(1000000000000000LL); // 1P bytes, don't split file automatically
+
+	m_pOutputSettings->Apply(m_pTree);
+}
+
@@ -1,19 +1,27 @@
 #include <Randomize.hh>
 
 #include <sys/time.h>
+#include <cstring>
 
 #include "DARWINAnalysisManager.hh"
+#include "DARWINProgressReporter.hh"
 
 #include "DARWINRunAction.hh"
 
+volatile sig_atomic_t DARWINRunAction::m_iPendingSignal = 0;
+
 DARWINRunAction::DARWINRunAction(DARWINAnalysisManager *pAnalysisManager)
 {
 	m_pAnalysisManager = pAnalysisManager;
+	m_pProgressReporter = new DARWINProgressReporter(pAnalysisManager);
+
+	m_bFixedSeed = false;
+	m_lSeed = 0;
 }
 
 DARWINRunAction::~DARWINRunAction()
 {
-
+	delete m_pProgressReporter;
 }
 
 void
@@ -26,13 +34,49 @@ DARWINRunAction::BeginOfRunAction(const G4Run *pRun)
 	gettimeofday(&hTimeValue, NULL);
 
 	CLHEP::HepRandom::setTheEngine(new CLHEP::DRand48Engine);
-	CLHEP::HepRandom::setTheSeed(hTimeValue.tv_usec);
+	// fixed seed (-s) for reproducible jobs, otherwise seed from the clock
+	CLHEP::HepRandom::setTheSeed((m_bFixedSeed)?(m_lSeed):(hTimeValue.tv_usec));
+
+	// a resumed run continues with the engine state of its checkpoint
+	if(m_pAnalysisManager)
+		m_pAnalysisManager->RestoreEngineStatus();
+
+	// signals only end the run gracefully while it is running
+	struct sigaction hAction;
+	memset(&hAction, 0, sizeof(hAction));
+	hAction.sa_handler = HandleSignal;
+	sigemptyset(&hAction.sa_mask);
+
+	sigaction(SIGTERM, &hAction, &m_hPreviousTermAction);
+	sigaction(SIGINT, &hAction, &m_hPreviousIntAction);
+
+	// the progress clock starts with the event loop
+	m_pProgressReporter->BeginOfRun(pRun->GetNumberOfEventToBeProcessed());
 }
 
 void
 DARWINRunAction::EndOfRunAction(const G4Run *pRun)
 {
+	// also after an abort or a run without events
+	m_pProgressReporter->EndOfRun();
+
 	if(m_pAnalysisManager)
 		m_pAnalysisManager->EndOfRun(pRun);
+
+	sigaction(SIGTERM, &m_hPreviousTermAction, 0);
+	sigaction(SIGINT, &m_hPreviousIntAction, 0);
+}
+
+void
+DARWINRunAction::HandleSignal(G4int iSignal)
+{
+	// only a flag is set here, the run manager is not async-signal-safe
+	if(m_iPendingSignal)
+	{
+		signal(iSignal, SIG_DFL);
+		raise(iSignal);
+	}
+
+	m_iPendingSignal = iSignal;
 }
 
@@ -1,22 +1,46 @@
 #include <G4ios.hh>
 #include <G4ParticleDefinition.hh>
 #include <G4ParticleTypes.hh>
+#include <G4ParticleTable.hh>
 #include <G4Track.hh>
 #include <G4Event.hh>
 #include <G4VProcess.hh>
 #include <G4StackManager.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
+#include <G4Ions.hh>
+
+#include <algorithm>
 
 #include "DARWINAnalysisManager.hh"
+#include "DARWINDetectorConstruction.hh"
+#include "DARWINDistanceMap.hh"
+#include "DARWINStackingActionMessenger.hh"
 
 #include "DARWINStackingAction.hh"
 
 DARWINStackingAction::DARWINStackingAction(DARWINAnalysisManager *pAnalysisManager)
 {
 	m_pAnalysisManager = pAnalysisManager;
+
+	m_bKillPolicy = false;
+	m_hDistanceMapTarget = "GXePhysicalVolume";
+	m_dDistanceMapVoxelSize = 10.*cm;
+	m_pDistanceMap = 0;
+
+	m_iChainStopZ = 0;
+	m_iChainStopA = 0;
+	m_dPileupWindow = 0.;
+	m_dEventDecayTime = -1.;
+	m_dNextEventDecayTime = -1.;
+
+	m_pMessenger = new DARWINStackingActionMessenger(this);
 }
 
 DARWINStackingAction::~DARWINStackingAction()
 {
+	delete m_pDistanceMap;
+	delete m_pMessenger;
 }
 
 G4ClassificationOfNewTrack
@@ -24,12 +48,51 @@ DARWINStackingAction::ClassifyNewTrack(const G4Track *pTrack)
 {
 	G4ClassificationOfNewTrack hTrackClassification = fUrgent;
 
-	if(pTrack->GetDefinition()->GetParticleType() == "nucleus" && !pTrack->GetDefinition()->GetPDGStable())
+	const G4ParticleDefinition *pDefinition = pTrack->GetDefinition();
+
+	G4bool bFromDecay = pTrack->GetParentID() > 0 && pTrack->GetCreatorProcess()
+		&& pTrack->GetCreatorProcess()->GetProcessName() == "RadioactiveDecay";
+
+	// end of the chain, the nuclide is not decayed
+	if(bFromDecay && m_iChainStopZ > 0 && IsChainStop(pDefinition))
+		return fKill;
+
+	if(bFromDecay && m_dPileupWindow > 0.)
 	{
-		if(pTrack->GetParentID() > 0 && pTrack->GetCreatorProcess()->GetProcessName() == "RadioactiveDecay")
+		// pileup mode: everything within the window of the first decay of the event
+		// is tracked, later decay products are kept for the next event
+		const G4double dTime = pTrack->GetGlobalTime();
+
+		if(m_dEventDecayTime < 0.)
+			m_dEventDecayTime = dTime;
+
+		if(dTime - m_dEventDecayTime > m_dPileupWindow)
+		{
+			PendingTrack hPendingTrack;
+			hPendingTrack.pDefinition = pTrack->GetDefinition();
+			hPendingTrack.hPosition = pTrack->GetPosition();
+			hPendingTrack.hMomentum = pTrack->GetMomentum();
+			hPendingTrack.dTime = dTime;
+
+			m_hPendingTracks.push_back(hPendingTrack);
+
+			return fKill;
+		}
+	}
+	else if(pDefinition->GetParticleType() == "nucleus" && !pDefinition->GetPDGStable())
+	{
+		if(bFromDecay)
 			hTrackClassification = fPostpone;
 	}
 
+	if(hTrackClassification == fUrgent && m_bKillPolicy && pTrack->GetParentID() > 0 && IsKilled(pTrack))
+	{
+		hTrackClassification = fKill;
+
+		if(m_pAnalysisManager)
+			m_pAnalysisManager->TrackKilled(pTrack);
+	}
+
 	return hTrackClassification;
 }
 
@@ -41,12 +104,161 @@ DARWINStackingAction::NewStage()
 void
 DARWINStackingAction::PrepareNewEvent()
 { 
+	// called after the primaries have been generated, events made of pending decay
+	// products start with their decay
+	m_dEventDecayTime = m_dNextEventDecayTime;
+	m_dNextEventDecayTime = -1.;
+}
+
+G4double
+DARWINStackingAction::PopPendingTracks(vector<PendingTrack> &hTracks)
+{
+	hTracks.clear();
+
+	if(m_hPendingTracks.empty())
+		return 0.;
+
+	G4double dEarliestTime = m_hPendingTracks[0].dTime;
+	for(G4int i=1; i<(G4int) m_hPendingTracks.size(); i++)
+		dEarliestTime = std::min(dEarliestTime, m_hPendingTracks[i].dTime);
+
+	// take the tracks within the window of the earliest decay, the other ones are
+	// shifted to the time frame of the new event which starts at the earliest decay
+	vector<PendingTrack> hRemainingTracks;
+
+	for(G4int i=0; i<(G4int) m_hPendingTracks.size(); i++)
+	{
+		PendingTrack hTrack = m_hPendingTracks[i];
+		hTrack.dTime -= dEarliestTime;
+
+		if(hTrack.dTime <= m_dPileupWindow)
+			hTracks.push_back(hTrack);
+		else
+			hRemainingTracks.push_back(hTrack);
+	}
+
+	m_hPendingTracks.swap(hRemainingTracks);
+
+	m_dNextEventDecayTime = 0.;
+
+	return dEarliestTime;
+}
+
+G4bool
+DARWINStackingAction::IsChainStop(const G4ParticleDefinition *pDefinition) const
+{
+	if(pDefinition->GetParticleType() != "nucleus")
+		return false;
+
+	if(pDefinition->GetAtomicNumber() != m_iChainStopZ || pDefinition->GetAtomicMass() != m_iChainStopA)
+		return false;
+
+	// excited states still de-excite
+	const G4Ions *pIon = dynamic_cast<const G4Ions *>(pDefinition);
+
+	return !pIon || pIon->GetExcitationEnergy() < 1.*keV;
+}
+
+void
+DARWINStackingAction::AddKillThreshold(const G4String &hParticleName, G4double dDistance, G4double dEnergy)
+{
+	G4ParticleDefinition *pParticleDefinition = G4ParticleTable::GetParticleTable()->FindParticle(hParticleName);
+
+	if(!pParticleDefinition)
+	{
+		G4cout << "Error: particle " << hParticleName << " not found, kill threshold ignored!" << G4endl;
+		return;
+	}
+
+	vector<pair<G4double, G4double> > &hThresholds = m_hKillThresholds[pParticleDefinition];
+
+	hThresholds.push_back(pair<G4double, G4double>(dDistance, dEnergy));
+	sort(hThresholds.begin(), hThresholds.end());
+
+	// store the running maximum so that the lookup can stop at the first larger distance
+	for(G4int i=1; i<(G4int) hThresholds.size(); i++)
+		hThresholds[i].second = std::max(hThresholds[i].second, hThresholds[i-1].second);
 }
 
+void
+DARWINStackingAction::SetDistanceMapTarget(const G4String &hTargetName)
+{
+	m_hDistanceMapTarget = hTargetName;
 
+	// rebuilt at the next classification
+	delete m_pDistanceMap;
+	m_pDistanceMap = 0;
+}
 
+void
+DARWINStackingAction::SetDistanceMapVoxelSize(G4double dVoxelSize)
+{
+	m_dDistanceMapVoxelSize = dVoxelSize;
 
+	delete m_pDistanceMap;
+	m_pDistanceMap = 0;
+}
 
+void
+DARWINStackingAction::ListKillThresholds()
+{
+	G4cout << "----> Kill policy " << ((m_bKillPolicy)?("on"):("off")) << ", distance to " << m_hDistanceMapTarget
+		<< " in voxels of " << m_dDistanceMapVoxelSize/cm << " cm" << G4endl;
 
+	map<const G4ParticleDefinition *, vector<pair<G4double, G4double> > >::iterator pIt;
+	for(pIt = m_hKillThresholds.begin(); pIt != m_hKillThresholds.end(); pIt++)
+		for(G4int i=0; i<(G4int) pIt->second.size(); i++)
+			G4cout << "      " << pIt->first->GetParticleName() << ": distance > " << pIt->second[i].first/cm
+				<< " cm, energy < " << pIt->second[i].second/keV << " keV" << G4endl;
+}
 
+G4bool
+DARWINStackingAction::IsKilled(const G4Track *pTrack)
+{
+	map<const G4ParticleDefinition *, vector<pair<G4double, G4double> > >::const_iterator pIt =
+		m_hKillThresholds.find(pTrack->GetDefinition());
+
+	if(pIt == m_hKillThresholds.end())
+		return false;
+
+	const vector<pair<G4double, G4double> > &hThresholds = pIt->second;
+
+	// nothing to kill above the highest threshold of this particle
+	const G4double dEnergy = pTrack->GetKineticEnergy();
+	if(dEnergy >= hThresholds.back().second)
+		return false;
+
+	if(!m_pDistanceMap)
+		BuildDistanceMap();
+
+	if(!m_pDistanceMap->IsBuilt())
+		return false;
+
+	const G4double dDistance = m_pDistanceMap->GetDistance(pTrack->GetPosition());
+
+	G4double dEnergyThreshold = 0.;
+	for(G4int i=0; i<(G4int) hThresholds.size() && hThresholds[i].first <= dDistance; i++)
+		dEnergyThreshold = hThresholds[i].second;
+
+	return dEnergy < dEnergyThreshold;
+}
+
+void
+DARWINStackingAction::BuildDistanceMap()
+{
+	// the map covers the laboratory, outside of it nothing can reach the xenon anyway
+	const G4double dLabRadius = DARWINDetectorConstruction::GetGeometryParameter("LabRadius");
+	const G4double dLabHalfZ = 0.5*DARWINDetectorConstruction::GetGeometryParameter("LabHeight");
+
+	G4VPhysicalVolume *pWorld = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+
+	m_pDistanceMap = new DARWINDistanceMap();
+
+	if(!m_pDistanceMap->Build(pWorld, m_hDistanceMapTarget, m_dDistanceMapVoxelSize,
+		G4ThreeVector(-dLabRadius, -dLabRadius, -dLabHalfZ), G4ThreeVector(dLabRadius, dLabRadius, dLabHalfZ)))
+	{
+		G4cout << "Error: kill policy switched off!" << G4endl;
+		m_bKillPolicy = false;
+	}
+}
 
@@ -0,0 +1,154 @@
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4Tokenizer.hh>
+
+#include "DARWINStackingAction.hh"
+
+#include "DARWINStackingActionMessenger.hh"
+
+DARWINStackingActionMessenger::DARWINStackingActionMessenger(DARWINStackingAction *pStackingAction)
+:m_pStackingAction(pStackingAction)
+{
+	m_pStackDir = new G4UIdirectory("/Xe/stack/");
+	m_pStackDir->SetGuidance("stacking action control.");
+
+	m_pKillPolicyCmd = new G4UIcmdWithABool("/Xe/stack/setKillPolicy", this);
+	m_pKillPolicyCmd->SetGuidance("Kill new secondaries that are too far from the xenon for their energy.");
+	m_pKillPolicyCmd->SetParameterName("Kill", false);
+	m_pKillPolicyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pKillThresholdCmd = new G4UIcommand("/Xe/stack/addKillThreshold", this);
+	m_pKillThresholdCmd->SetGuidance("Kill secondaries of a particle type born further than a distance from the target");
+	m_pKillThresholdCmd->SetGuidance("with a kinetic energy below a threshold, several distances can be given per particle.");
+	m_pKillThresholdCmd->SetGuidance("  usage: /Xe/stack/addKillThreshold Particle Distance DistanceUnit Energy EnergyUnit");
+	m_pKillThresholdCmd->SetGuidance("  e.g.   /Xe/stack/addKillThreshold gamma 50 cm 100 keV");
+
+	G4UIparameter *pParticleParameter = new G4UIparameter("Particle", 's', false);
+	m_pKillThresholdCmd->SetParameter(pParticleParameter);
+
+	G4UIparameter *pDistanceParameter = new G4UIparameter("Distance", 'd', false);
+	pDistanceParameter->SetParameterRange("Distance >= 0.");
+	m_pKillThresholdCmd->SetParameter(pDistanceParameter);
+
+	G4UIparameter *pDistanceUnitParameter = new G4UIparameter("DistanceUnit", 's', false);
+	m_pKillThresholdCmd->SetParameter(pDistanceUnitParameter);
+
+	G4UIparameter *pEnergyParameter = new G4UIparameter("Energy", 'd', false);
+	pEnergyParameter->SetParameterRange("Energy >= 0.");
+	m_pKillThresholdCmd->SetParameter(pEnergyParameter);
+
+	G4UIparameter *pEnergyUnitParameter = new G4UIparameter("EnergyUnit", 's', false);
+	m_pKillThresholdCmd->SetParameter(pEnergyUnitParameter);
+
+	m_pKillThresholdCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pClearKillThresholdsCmd = new G4UIcmdWithoutParameter("/Xe/stack/clearKillThresholds", this);
+	m_pClearKillThresholdsCmd->SetGuidance("Remove all kill thresholds.");
+	m_pClearKillThresholdsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pListKillThresholdsCmd = new G4UIcmdWithoutParameter("/Xe/stack/listKillThresholds", this);
+	m_pListKillThresholdsCmd->SetGuidance("Print the kill policy.");
+	m_pListKillThresholdsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pDistanceMapTargetCmd = new G4UIcmdWithAString("/Xe/stack/setTargetVolume", this);
+	m_pDistanceMapTargetCmd->SetGuidance("Physical volume the distances are computed to (default GXePhysicalVolume, the whole xenon).");
+	m_pDistanceMapTargetCmd->SetParameterName("Volume", false);
+	m_pDistanceMapTargetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pDistanceMapVoxelSizeCmd = new G4UIcmdWithADoubleAndUnit("/Xe/stack/setMapVoxelSize", this);
+	m_pDistanceMapVoxelSizeCmd->SetGuidance("Voxel size of the distance map (default 10 cm).");
+	m_pDistanceMapVoxelSizeCmd->SetParameterName("VoxelSize", false);
+	m_pDistanceMapVoxelSizeCmd->SetRange("VoxelSize > 0.");
+	m_pDistanceMapVoxelSizeCmd->SetUnitCategory("Length");
+	m_pDistanceMapVoxelSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pChainStopCmd = new G4UIcommand("/Xe/stack/setChainStop", this);
+	m_pChainStopCmd->SetGuidance("Stop decay chains at a nuclide (ground state), it is killed instead of decayed.");
+	m_pChainStopCmd->SetGuidance("  usage: /Xe/stack/setChainStop Z A");
+	m_pChainStopCmd->SetGuidance("  e.g.   /Xe/stack/setChainStop 90 230 (U238 down to Th230)");
+	m_pChainStopCmd->SetGuidance("  Z = 0 follows the full chain (default).");
+
+	G4UIparameter *pZParameter = new G4UIparameter("Z", 'i', false);
+	pZParameter->SetParameterRange("Z >= 0");
+	m_pChainStopCmd->SetParameter(pZParameter);
+
+	G4UIparameter *pAParameter = new G4UIparameter("A", 'i', true);
+	pAParameter->SetDefaultValue(0);
+	pAParameter->SetParameterRange("A >= 0");
+	m_pChainStopCmd->SetParameter(pAParameter);
+
+	m_pChainStopCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+	m_pPileupWindowCmd = new G4UIcmdWithADoubleAndUnit("/Xe/stack/setPileupWindow", this);
+	m_pPileupWindowCmd->SetGuidance("Decays within this time of the first decay of an event are kept in the event,");
+	m_pPileupWindowCmd->SetGuidance("later decay products start a new event. 0 puts each decay in its own event (default).");
+	m_pPileupWindowCmd->SetParameterName("Window", false);
+	m_pPileupWindowCmd->SetRange("Window >= 0.");
+	m_pPileupWindowCmd->SetUnitCategory("Time");
+	m_pPileupWindowCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+DARWINStackingActionMessenger::~DARWINStackingActionMessenger()
+{
+	delete m_pKillPolicyCmd;
+	delete m_pKillThresholdCmd;
+	delete m_pClearKillThresholdsCmd;
+	delete m_pListKillThresholdsCmd;
+	delete m_pDistanceMapTargetCmd;
+	delete m_pDistanceMapVoxelSizeCmd;
+	delete m_pChainStopCmd;
+	delete m_pPileupWindowCmd;
+
+	delete m_pStackDir;
+}
+
+void
+DARWINStackingActionMessenger::SetNewValue(G4UIcommand *pUIcommand, G4String hNewValue)
+{
+	if(pUIcommand == m_pKillPolicyCmd)
+		m_pStackingAction->SetKillPolicy(m_pKillPolicyCmd->GetNewBoolValue(hNewValue));
+
+	if(pUIcommand == m_pKillThresholdCmd)
+	{
+		G4Tokenizer hNextToken(hNewValue);
+
+		G4String hParticleName = hNextToken();
+		G4double dDistance = StoD(hNextToken());
+		dDistance *= G4UIcommand::ValueOf(hNextToken());
+		G4double dEnergy = StoD(hNextToken());
+		dEnergy *= G4UIcommand::ValueOf(hNextToken());
+
+		m_pStackingAction->AddKillThreshold(hParticleName, dDistance, dEnergy);
+	}
+
+	if(pUIcommand == m_pClearKillThresholdsCmd)
+		m_pStackingAction->ClearKillThresholds();
+
+	if(pUIcommand == m_pListKillThresholdsCmd)
+		m_pStackingAction->ListKillThresholds();
+
+	if(pUIcommand == m_pDistanceMapTargetCmd)
+		m_pStackingAction->SetDistanceMapTarget(hNewValue);
+
+	if(pUIcommand == m_pDistanceMapVoxelSizeCmd)
+		m_pStackingAction->SetDistanceMapVoxelSize(m_pDistanceMapVoxelSizeCmd->GetNewDoubleValue(hNewValue));
+
+	if(pUIcommand == m_pChainStopCmd)
+	{
+		G4Tokenizer hNextToken(hNewValue);
+
+		G4int iZ = StoI(hNextToken());
+		G4int iA = StoI(hNextToken());
+
+		m_pStackingAction->SetChainStop(iZ, iA);
+	}
+
+	if(pUIcommand == m_pPileupWindowCmd)
+		m_pStackingAction->SetPileupWindow(m_pPileupWindowCmd->GetNewDoubleValue(hNewValue));
+}
+
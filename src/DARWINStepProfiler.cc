@@ -0,0 +1,189 @@
+#include <G4Step.hh>
+#include <G4StepPoint.hh>
+#include <G4Track.hh>
+#include <G4VProcess.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4ParticleDefinition.hh>
+
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <cstring>
+#include <time.h>
+
+#include <TDirectory.h>
+#include <TTree.h>
+
+using std::vector;
+using std::sort;
+
+#include "DARWINStepProfiler.hh"
+
+DARWINStepProfiler::DARWINStepProfiler()
+{
+	Reset();
+}
+
+DARWINStepProfiler::~DARWINStepProfiler()
+{
+}
+
+void
+DARWINStepProfiler::Reset()
+{
+	m_hCounters.clear();
+
+	m_hLastKey.pVolume = 0;
+	m_hLastKey.pParticle = 0;
+	m_hLastKey.pProcess = 0;
+	m_pLastCounters = 0;
+
+	m_dLastTime = GetWallTime();
+	m_dTotalTime = 0.;
+	m_lTotalSteps = 0;
+}
+
+void
+DARWINStepProfiler::BeginOfEvent()
+{
+	// do not charge the time spent between events to the first step
+	m_dLastTime = GetWallTime();
+}
+
+void
+DARWINStepProfiler::Step(const G4Step *pStep)
+{
+	const G4double dTime = GetWallTime();
+	const G4double dElapsed = dTime - m_dLastTime;
+	m_dLastTime = dTime;
+
+	Key hKey;
+	hKey.pVolume = pStep->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+	hKey.pParticle = pStep->GetTrack()->GetDefinition();
+	hKey.pProcess = pStep->GetPostStepPoint()->GetProcessDefinedStep();
+
+	if(!m_pLastCounters || hKey.pVolume != m_hLastKey.pVolume
+		|| hKey.pParticle != m_hLastKey.pParticle || hKey.pProcess != m_hLastKey.pProcess)
+	{
+		m_hLastKey = hKey;
+		m_pLastCounters = &m_hCounters[hKey];
+	}
+
+	m_pLastCounters->lSteps++;
+	m_pLastCounters->dLength += pStep->GetStepLength();
+	m_pLastCounters->dTime += dElapsed;
+
+	m_lTotalSteps++;
+	m_dTotalTime += dElapsed;
+}
+
+void
+DARWINStepProfiler::PrintReport(G4int iNbEvents, G4int iNbEntries) const
+{
+	typedef std::pair<G4double, const Key *> Entry;
+
+	vector<Entry> hEntries;
+	hEntries.reserve(m_hCounters.size());
+
+	map<Key, Counters>::const_iterator pIt;
+	for(pIt = m_hCounters.begin(); pIt != m_hCounters.end(); pIt++)
+		hEntries.push_back(Entry(-pIt->second.dTime, &pIt->first));
+
+	sort(hEntries.begin(), hEntries.end());
+
+	G4int iPrecision = G4cout.precision();
+
+	G4cout << G4endl << "----> Step profile (" << iNbEvents << " events, " << m_lTotalSteps << " steps, "
+		<< m_dTotalTime << " s in stepping)" << G4endl;
+	G4cout << std::setw(34) << std::left << "volume" << std::setw(16) << "particle" << std::setw(20) << "process" << std::right
+		<< std::setw(14) << "steps" << std::setw(14) << "length [m]" << std::setw(12) << "time [s]"
+		<< std::setw(8) << "%" << std::setw(12) << "us/step" << G4endl;
+
+	for(G4int i=0; i<(G4int) hEntries.size() && i<iNbEntries; i++)
+	{
+		const Key &hKey = *hEntries[i].second;
+		const Counters &hCounters = m_hCounters.find(hKey)->second;
+
+		G4cout << std::setw(34) << std::left << GetVolumeName(hKey)
+			<< std::setw(16) << GetParticleName(hKey)
+			<< std::setw(20) << GetProcessName(hKey) << std::right
+			<< std::setw(14) << hCounters.lSteps
+			<< std::setw(14) << std::setprecision(4) << hCounters.dLength/m
+			<< std::setw(12) << std::setprecision(4) << hCounters.dTime
+			<< std::setw(8) << std::setprecision(3) << ((m_dTotalTime > 0.)?(100.*hCounters.dTime/m_dTotalTime):(0.))
+			<< std::setw(12) << std::setprecision(3) << 1.e6*hCounters.dTime/hCounters.lSteps << G4endl;
+	}
+
+	if((G4int) hEntries.size() > iNbEntries)
+		G4cout << "... " << hEntries.size()-iNbEntries << " more entries in the profile tree" << G4endl;
+
+	G4cout << G4endl;
+
+	G4cout.precision(iPrecision);
+}
+
+void
+DARWINStepProfiler::FillTree(TDirectory *pDirectory) const
+{
+	// the tree is created in the directory and written out with it
+	pDirectory->cd();
+
+	TTree *pTree = new TTree("profile", "Steps, track length and wall time per volume, particle and process");
+
+	char szVolume[256], szParticle[64], szProcess[64];
+	Long64_t lSteps = 0;
+	Double_t dLength = 0., dTime = 0.;
+
+	pTree->Branch("volume", szVolume, "volume/C");
+	pTree->Branch("particle", szParticle, "particle/C");
+	pTree->Branch("process", szProcess, "process/C");
+	pTree->Branch("steps", &lSteps, "steps/L");
+	pTree->Branch("length", &dLength, "length/D");
+	pTree->Branch("time", &dTime, "time/D");
+
+	map<Key, Counters>::const_iterator pIt;
+	for(pIt = m_hCounters.begin(); pIt != m_hCounters.end(); pIt++)
+	{
+		strncpy(szVolume, GetVolumeName(pIt->first).c_str(), sizeof(szVolume)-1);
+		szVolume[sizeof(szVolume)-1] = '\0';
+		strncpy(szParticle, GetParticleName(pIt->first).c_str(), sizeof(szParticle)-1);
+		szParticle[sizeof(szParticle)-1] = '\0';
+		strncpy(szProcess, GetProcessName(pIt->first).c_str(), sizeof(szProcess)-1);
+		szProcess[sizeof(szProcess)-1] = '\0';
+
+		lSteps = pIt->second.lSteps;
+		dLength = pIt->second.dLength/mm;
+		dTime = pIt->second.dTime;
+
+		pTree->Fill();
+	}
+}
+
+G4double
+DARWINStepProfiler::GetWallTime()
+{
+	struct timespec hTime;
+	clock_gettime(CLOCK_MONOTONIC, &hTime);
+
+	return hTime.tv_sec + 1.e-9*hTime.tv_nsec;
+}
+
+G4String
+DARWINStepProfiler::GetVolumeName(const Key &hKey)
+{
+	return (hKey.pVolume)?(hKey.pVolume->GetName()):(G4String("none"));
+}
+
+G4String
+DARWINStepProfiler::GetParticleName(const Key &hKey)
+{
+	return (hKey.pParticle)?(hKey.pParticle->GetParticleName()):(G4String("none"));
+}
+
+G4String
+DARWINStepProfiler::GetProcessName(const Key &hKey)
+{
+	return (hKey.pProcess)?(hKey.pProcess->GetProcessName()):(G4String("none"));
+}
+
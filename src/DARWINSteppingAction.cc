@@ -0,0 +1,22 @@
+#include <G4Step.hh>
+
+#include "DARWINAnalysisManager.hh"
+
+#include "DARWINSteppingAction.hh"
+
+DARWINSteppingAction::DARWINSteppingAction(DARWINAnalysisManager *pAnalysisManager)
+{
+	m_pAnalysisManager = pAnalysisManager;
+}
+
+DARWINSteppingAction::~DARWINSteppingAction()
+{
+}
+
+void
+DARWINSteppingAction::UserSteppingAction(const G4Step *pStep)
+{
+	if(m_pAnalysisManager)
+		m_pAnalysisManager->Step(pStep);
+}
+
@@ -0,0 +1,200 @@
+#include <TDirectory.h>
+#include <TH1D.h>
+#include <TH2D.h>
+
+#include "DARWINSummaryHistograms.hh"
+
+DARWINSummaryHistograms::DARWINSummaryHistograms()
+{
+	m_dFiducialRadius = 0.;
+	m_dFiducialZMin = 0.;
+	m_dFiducialZMax = 0.;
+
+	m_iNbEnergyBins = 1000;
+	m_dEnergyMin = 0.;
+	m_dEnergyMax = 1000.*keV;
+
+	m_dThreshold = 1.*keV;
+
+	m_pEnergySS = 0;
+	m_pEnergyMS = 0;
+	m_pEnergyMultiplicity = 0;
+	m_pR2ZClusters = 0;
+	m_pR2ZSS = 0;
+}
+
+DARWINSummaryHistograms::~DARWINSummaryHistograms()
+{
+	Delete();
+}
+
+void
+DARWINSummaryHistograms::SetFiducialVolume(G4double dRadius, G4double dZMin, G4double dZMax)
+{
+	m_dFiducialRadius = dRadius;
+	m_dFiducialZMin = dZMin;
+	m_dFiducialZMax = dZMax;
+}
+
+void
+DARWINSummaryHistograms::SetEnergyBinning(G4int iNbBins, G4double dEnergyMin, G4double dEnergyMax)
+{
+	m_iNbEnergyBins = iNbBins;
+	m_dEnergyMin = dEnergyMin;
+	m_dEnergyMax = dEnergyMax;
+}
+
+void
+DARWINSummaryHistograms::Book(G4double dMapRadius, G4double dMapZMin, G4double dMapZMax)
+{
+	Delete();
+
+	// the histograms are not attached to the output file, Write() saves them
+	const G4bool bAddDirectory = TH1::AddDirectoryStatus();
+	TH1::AddDirectory(false);
+
+	m_pEnergySS = new TH1D("energy_ss", "Single scatters in the fiducial volume;Energy [keV];Events",
+		m_iNbEnergyBins, m_dEnergyMin/keV, m_dEnergyMax/keV);
+	m_pEnergyMS = new TH1D("energy_ms", "Multiple scatters in the fiducial volume;Energy [keV];Events",
+		m_iNbEnergyBins, m_dEnergyMin/keV, m_dEnergyMax/keV);
+	m_pEnergyMultiplicity = new TH2D("energy_multiplicity", "Events in the fiducial volume;Energy [keV];Number of clusters",
+		m_iNbEnergyBins, m_dEnergyMin/keV, m_dEnergyMax/keV, 10, 0.5, 10.5);
+	m_pR2ZClusters = new TH2D("r2z_clusters", "Clusters;r^{2} [cm^{2}];z [cm]",
+		100, 0., dMapRadius*dMapRadius/cm2, 100, dMapZMin/cm, dMapZMax/cm);
+	m_pR2ZSS = new TH2D("r2z_ss", "Single scatters;r^{2} [cm^{2}];z [cm]",
+		100, 0., dMapRadius*dMapRadius/cm2, 100, dMapZMin/cm, dMapZMax/cm);
+
+	m_pEnergySS->Sumw2();
+	m_pEnergyMS->Sumw2();
+	m_pEnergyMultiplicity->Sumw2();
+	m_pR2ZClusters->Sumw2();
+	m_pR2ZSS->Sumw2();
+
+	TH1::AddDirectory(bAddDirectory);
+}
+
+void
+DARWINSummaryHistograms::Fill(const vector<DARWINClusterer::Cluster> &hClusters, const G4String &hSourceVolume, G4double dWeight)
+{
+	G4int iMultiplicity = 0;
+	G4double dEnergy = 0.;
+	G4bool bInFiducialVolume = false;
+	const DARWINClusterer::Cluster *pLastCluster = 0;
+
+	for(vector<DARWINClusterer::Cluster>::const_iterator pIt = hClusters.begin(); pIt != hClusters.end(); pIt++)
+	{
+		if(pIt->dEnergy < m_dThreshold)
+			continue;
+
+		iMultiplicity++;
+		dEnergy += pIt->dEnergy;
+		bInFiducialVolume = bInFiducialVolume || IsInFiducialVolume(pIt->hPosition);
+		pLastCluster = &(*pIt);
+
+		m_pR2ZClusters->Fill(pIt->hPosition.perp2()/cm2, pIt->hPosition.z()/cm, dWeight);
+	}
+
+	if(!iMultiplicity)
+		return;
+
+	if(iMultiplicity == 1)
+		m_pR2ZSS->Fill(pLastCluster->hPosition.perp2()/cm2, pLastCluster->hPosition.z()/cm, dWeight);
+
+	if(!bInFiducialVolume)
+		return;
+
+	m_pEnergyMultiplicity->Fill(dEnergy/keV, iMultiplicity, dWeight);
+
+	if(iMultiplicity > 1)
+	{
+		m_pEnergyMS->Fill(dEnergy/keV, dWeight);
+		return;
+	}
+
+	m_pEnergySS->Fill(dEnergy/keV, dWeight);
+
+	TH1D *&pSpectrum = m_hSourceVolumeSpectra[hSourceVolume];
+	if(!pSpectrum)
+	{
+		const G4bool bAddDirectory = TH1::AddDirectoryStatus();
+		TH1::AddDirectory(false);
+
+		pSpectrum = new TH1D(("energy_ss_"+hSourceVolume).c_str(), ("Single scatters in the fiducial volume, source "+hSourceVolume+";Energy [keV];Events").c_str(),
+			m_iNbEnergyBins, m_dEnergyMin/keV, m_dEnergyMax/keV);
+		pSpectrum->Sumw2();
+
+		TH1::AddDirectory(bAddDirectory);
+	}
+	pSpectrum->Fill(dEnergy/keV, dWeight);
+}
+
+void
+DARWINSummaryHistograms::Write(TDirectory *pDirectory) const
+{
+	if(!m_pEnergySS)
+		return;
+
+	// written again at every checkpoint, replacing the previous histograms
+	TDirectory *pSummaryDirectory = pDirectory->GetDirectory("summary");
+	if(!pSummaryDirectory)
+		pSummaryDirectory = pDirectory->mkdir("summary");
+	pSummaryDirectory->cd();
+
+	m_pEnergySS->Write(0, TObject::kOverwrite);
+	m_pEnergyMS->Write(0, TObject::kOverwrite);
+	m_pEnergyMultiplicity->Write(0, TObject::kOverwrite);
+	m_pR2ZClusters->Write(0, TObject::kOverwrite);
+	m_pR2ZSS->Write(0, TObject::kOverwrite);
+
+	map<G4String, TH1D *>::const_iterator pIt;
+	for(pIt = m_hSourceVolumeSpectra.begin(); pIt != m_hSourceVolumeSpectra.end(); pIt++)
+		pIt->second->Write(0, TObject::kOverwrite);
+
+	pDirectory->cd();
+}
+
+void
+DARWINSummaryHistograms::Reset()
+{
+	if(!m_pEnergySS)
+		return;
+
+	m_pEnergySS->Reset();
+	m_pEnergyMS->Reset();
+	m_pEnergyMultiplicity->Reset();
+	m_pR2ZClusters->Reset();
+	m_pR2ZSS->Reset();
+
+	map<G4String, TH1D *>::iterator pIt;
+	for(pIt = m_hSourceVolumeSpectra.begin(); pIt != m_hSourceVolumeSpectra.end(); pIt++)
+		pIt->second->Reset();
+}
+
+void
+DARWINSummaryHistograms::Delete()
+{
+	delete m_pEnergySS;
+	delete m_pEnergyMS;
+	delete m_pEnergyMultiplicity;
+	delete m_pR2ZClusters;
+	delete m_pR2ZSS;
+
+	m_pEnergySS = 0;
+	m_pEnergyMS = 0;
+	m_pEnergyMultiplicity = 0;
+	m_pR2ZClusters = 0;
+	m_pR2ZSS = 0;
+
+	map<G4String, TH1D *>::iterator pIt;
+	for(pIt = m_hSourceVolumeSpectra.begin(); pIt != m_hSourceVolumeSpectra.end(); pIt++)
+		delete pIt->second;
+	m_hSourceVolumeSpectra.clear();
+}
+
+G4bool
+DARWINSummaryHistograms::IsInFiducialVolume(const G4ThreeVector &hPosition) const
+{
+	return hPosition.perp2() < m_dFiducialRadius*m_dFiducialRadius
+		&& hPosition.z() > m_dFiducialZMin && hPosition.z() < m_dFiducialZMax;
+}
+
@@ -0,0 +1,379 @@
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VSolid.hh>
+#include <G4Tubs.hh>
+#include <G4Sphere.hh>
+#include <G4Ellipsoid.hh>
+#include <Randomize.hh>
+
+#include <cmath>
+#include <algorithm>
+
+#include "DARWINSurfaceSampler.hh"
+
+DARWINSurfaceSampler::DARWINSurfaceSampler()
+{
+}
+
+DARWINSurfaceSampler::~DARWINSurfaceSampler()
+{
+}
+
+G4bool
+DARWINSurfaceSampler::Build(G4VPhysicalVolume *pWorld, const set<G4String> &hVolumeNames)
+{
+	m_hSurfaces.clear();
+	m_hCumulativeAreas.clear();
+
+	if(pWorld)
+		Collect(pWorld, hVolumeNames, G4AffineTransform());
+
+	if(m_hSurfaces.empty())
+	{
+		G4cout << "Error: no volume to generate surface points on!" << G4endl;
+		return false;
+	}
+
+	G4double dTotalArea = 0.;
+	G4int iNbApproximate = 0;
+
+	for(G4int i=0; i<(G4int) m_hSurfaces.size(); i++)
+	{
+		const vector<G4double> &hAreas = m_hSurfaces[i].hPieceAreas;
+
+		for(G4int j=0; j<(G4int) hAreas.size(); j++)
+			dTotalArea += hAreas[j];
+
+		m_hCumulativeAreas.push_back(dTotalArea);
+
+		if(m_hSurfaces[i].iType == kOther)
+			iNbApproximate++;
+	}
+
+	G4cout << "----> Surface source: " << m_hSurfaces.size() << " volumes, " << dTotalArea/cm2 << " cm2";
+	if(iNbApproximate)
+		G4cout << " (" << iNbApproximate << " sampled with G4VSolid::GetPointOnSurface)";
+	G4cout << G4endl;
+
+	return true;
+}
+
+void
+DARWINSurfaceSampler::GeneratePoint(G4ThreeVector &hPosition, G4ThreeVector &hNormal) const
+{
+	G4double dArea = G4UniformRand()*m_hCumulativeAreas.back();
+	G4int iSurface = std::upper_bound(m_hCumulativeAreas.begin(), m_hCumulativeAreas.end(), dArea) - m_hCumulativeAreas.begin();
+	iSurface = std::min(iSurface, (G4int) m_hSurfaces.size()-1);
+
+	const Surface &hSurface = m_hSurfaces[iSurface];
+	G4int iPiece = SelectPiece(hSurface.hPieceAreas);
+
+	G4ThreeVector hLocalPosition, hLocalNormal;
+
+	switch(hSurface.iType)
+	{
+		case kTubs:
+			GeneratePointOnTubs((const G4Tubs *) hSurface.pSolid, iPiece, hLocalPosition, hLocalNormal);
+			break;
+
+		case kSphere:
+			GeneratePointOnSphere((const G4Sphere *) hSurface.pSolid, iPiece, hLocalPosition, hLocalNormal);
+			break;
+
+		case kEllipsoid:
+			GeneratePointOnEllipsoid((const G4Ellipsoid *) hSurface.pSolid, iPiece, hLocalPosition, hLocalNormal);
+			break;
+
+		default:
+			hLocalPosition = hSurface.pSolid->GetPointOnSurface();
+			hLocalNormal = hSurface.pSolid->SurfaceNormal(hLocalPosition);
+			break;
+	}
+
+	hPosition = hSurface.hTransform.TransformPoint(hLocalPosition);
+	hNormal = hSurface.hTransform.TransformAxis(hLocalNormal);
+}
+
+void
+DARWINSurfaceSampler::Collect(G4VPhysicalVolume *pVolume, const set<G4String> &hVolumeNames, const G4AffineTransform &hTransform)
+{
+	if(hVolumeNames.count(pVolume->GetName()))
+	{
+		Surface hSurface;
+		hSurface.pSolid = pVolume->GetLogicalVolume()->GetSolid();
+		hSurface.hTransform = hTransform;
+
+		const G4String hEntityType = hSurface.pSolid->GetEntityType();
+
+		if(hEntityType == "G4Tubs")
+		{
+			hSurface.iType = kTubs;
+			GetTubsPieceAreas((const G4Tubs *) hSurface.pSolid, hSurface.hPieceAreas);
+		}
+		else if(hEntityType == "G4Sphere")
+		{
+			hSurface.iType = kSphere;
+			GetSpherePieceAreas((const G4Sphere *) hSurface.pSolid, hSurface.hPieceAreas);
+		}
+		else if(hEntityType == "G4Ellipsoid")
+		{
+			hSurface.iType = kEllipsoid;
+			GetEllipsoidPieceAreas((const G4Ellipsoid *) hSurface.pSolid, hSurface.hPieceAreas);
+		}
+		else
+		{
+			hSurface.iType = kOther;
+			hSurface.hPieceAreas.push_back(hSurface.pSolid->GetSurfaceArea());
+		}
+
+		m_hSurfaces.push_back(hSurface);
+	}
+
+	G4LogicalVolume *pLogicalVolume = pVolume->GetLogicalVolume();
+
+	for(G4int i=0; i<(G4int) pLogicalVolume->GetNoDaughters(); i++)
+	{
+		G4VPhysicalVolume *pDaughter = pLogicalVolume->GetDaughter(i);
+
+		// daughter to mother frame, then mother to world frame
+		G4AffineTransform hDaughterTransform(pDaughter->GetRotation(), pDaughter->GetTranslation());
+
+		Collect(pDaughter, hVolumeNames, hDaughterTransform*hTransform);
+	}
+}
+
+// pieces: outer and inner barrel, -z and +z caps, start and end phi planes
+void
+DARWINSurfaceSampler::GetTubsPieceAreas(const G4Tubs *pTubs, vector<G4double> &hAreas)
+{
+	const G4double dRMin = pTubs->GetInnerRadius();
+	const G4double dRMax = pTubs->GetOuterRadius();
+	const G4double dHalfZ = pTubs->GetZHalfLength();
+	const G4double dDPhi = pTubs->GetDeltaPhiAngle();
+	const G4double dPhiPlane = (dDPhi < twopi)?((dRMax-dRMin)*2.*dHalfZ):(0.);
+
+	hAreas.clear();
+	hAreas.push_back(dDPhi*dRMax*2.*dHalfZ);
+	hAreas.push_back(dDPhi*dRMin*2.*dHalfZ);
+	hAreas.push_back(0.5*dDPhi*(dRMax*dRMax-dRMin*dRMin));
+	hAreas.push_back(0.5*dDPhi*(dRMax*dRMax-dRMin*dRMin));
+	hAreas.push_back(dPhiPlane);
+	hAreas.push_back(dPhiPlane);
+}
+
+// pieces: outer and inner sphere, start and end theta cones, start and end phi planes
+void
+DARWINSurfaceSampler::GetSpherePieceAreas(const G4Sphere *pSphere, vector<G4double> &hAreas)
+{
+	const G4double dRMin = pSphere->GetInnerRadius();
+	const G4double dRMax = pSphere->GetOuterRadius();
+	const G4double dDPhi = pSphere->GetDeltaPhiAngle();
+	const G4double dTheta0 = pSphere->GetStartThetaAngle();
+	const G4double dTheta1 = dTheta0 + pSphere->GetDeltaThetaAngle();
+	const G4double dRing = 0.5*(dRMax*dRMax-dRMin*dRMin);
+	const G4double dPhiPlane = (dDPhi < twopi)?((dTheta1-dTheta0)*dRing):(0.);
+
+	hAreas.clear();
+	hAreas.push_back(dRMax*dRMax*dDPhi*(std::cos(dTheta0)-std::cos(dTheta1)));
+	hAreas.push_back(dRMin*dRMin*dDPhi*(std::cos(dTheta0)-std::cos(dTheta1)));
+	hAreas.push_back((dTheta0 > 0.)?(dDPhi*std::sin(dTheta0)*dRing):(0.));
+	hAreas.push_back((dTheta1 < pi)?(dDPhi*std::sin(dTheta1)*dRing):(0.));
+	hAreas.push_back(dPhiPlane);
+	hAreas.push_back(dPhiPlane);
+}
+
+// pieces: curved surface between the cuts, bottom and top cut planes
+void
+DARWINSurfaceSampler::GetEllipsoidPieceAreas(const G4Ellipsoid *pEllipsoid, vector<G4double> &hAreas)
+{
+	const G4double dA = pEllipsoid->GetSemiAxisMax(0);
+	const G4double dB = pEllipsoid->GetSemiAxisMax(1);
+	const G4double dC = pEllipsoid->GetSemiAxisMax(2);
+	const G4double dZBottom = std::max(pEllipsoid->GetZBottomCut(), -dC);
+	const G4double dZTop = std::min(pEllipsoid->GetZTopCut(), dC);
+
+	// the ellipsoid is the image of the unit sphere, its area element is
+	// abc*|(nx/a, ny/b, nz/c)| times the one of the sphere, integrated numerically
+	const G4int iNbU = 1000, iNbPhi = 720;
+	const G4double dUMin = dZBottom/dC, dUMax = dZTop/dC;
+	const G4double dDU = (dUMax-dUMin)/iNbU, dDPhi = twopi/iNbPhi;
+
+	G4double dCurvedArea = 0.;
+	for(G4int i=0; i<iNbU; i++)
+	{
+		G4double dU = dUMin + (i+0.5)*dDU;
+		G4double dSin2 = 1. - dU*dU;
+
+		for(G4int j=0; j<iNbPhi; j++)
+		{
+			G4double dPhi = (j+0.5)*dDPhi;
+			G4double dCosPhi = std::cos(dPhi), dSinPhi = std::sin(dPhi);
+
+			dCurvedArea += std::sqrt(dSin2*dCosPhi*dCosPhi/(dA*dA) + dSin2*dSinPhi*dSinPhi/(dB*dB) + dU*dU/(dC*dC));
+		}
+	}
+	dCurvedArea *= dA*dB*dC*dDU*dDPhi;
+
+	hAreas.clear();
+	hAreas.push_back(dCurvedArea);
+	hAreas.push_back((dZBottom > -dC)?(pi*dA*dB*(1.-dZBottom*dZBottom/(dC*dC))):(0.));
+	hAreas.push_back((dZTop < dC)?(pi*dA*dB*(1.-dZTop*dZTop/(dC*dC))):(0.));
+}
+
+void
+DARWINSurfaceSampler::GeneratePointOnTubs(const G4Tubs *pTubs, G4int iPiece, G4ThreeVector &hPosition, G4ThreeVector &hNormal)
+{
+	const G4double dRMin = pTubs->GetInnerRadius();
+	const G4double dRMax = pTubs->GetOuterRadius();
+	const G4double dHalfZ = pTubs->GetZHalfLength();
+	const G4double dSPhi = pTubs->GetStartPhiAngle();
+	const G4double dDPhi = pTubs->GetDeltaPhiAngle();
+
+	G4double dPhi = dSPhi + G4UniformRand()*dDPhi;
+	G4double dZ = (2.*G4UniformRand()-1.)*dHalfZ;
+	G4double dR;
+
+	switch(iPiece)
+	{
+		case 0:
+		case 1:
+			dR = (iPiece == 0)?(dRMax):(dRMin);
+			hPosition = G4ThreeVector(dR*std::cos(dPhi), dR*std::sin(dPhi), dZ);
+			hNormal = G4ThreeVector(std::cos(dPhi), std::sin(dPhi), 0.)*((iPiece == 0)?(1.):(-1.));
+			break;
+
+		case 2:
+		case 3:
+			dR = GenerateRadius(dRMin, dRMax);
+			dZ = (iPiece == 2)?(-dHalfZ):(dHalfZ);
+			hPosition = G4ThreeVector(dR*std::cos(dPhi), dR*std::sin(dPhi), dZ);
+			hNormal = G4ThreeVector(0., 0., (iPiece == 2)?(-1.):(1.));
+			break;
+
+		default:
+			dR = dRMin + G4UniformRand()*(dRMax-dRMin);
+			dPhi = (iPiece == 4)?(dSPhi):(dSPhi+dDPhi);
+			hPosition = G4ThreeVector(dR*std::cos(dPhi), dR*std::sin(dPhi), dZ);
+			hNormal = G4ThreeVector(std::sin(dPhi), -std::cos(dPhi), 0.)*((iPiece == 4)?(1.):(-1.));
+			break;
+	}
+}
+
+void
+DARWINSurfaceSampler::GeneratePointOnSphere(const G4Sphere *pSphere, G4int iPiece, G4ThreeVector &hPosition, G4ThreeVector &hNormal)
+{
+	const G4double dRMin = pSphere->GetInnerRadius();
+	const G4double dRMax = pSphere->GetOuterRadius();
+	const G4double dSPhi = pSphere->GetStartPhiAngle();
+	const G4double dDPhi = pSphere->GetDeltaPhiAngle();
+	const G4double dTheta0 = pSphere->GetStartThetaAngle();
+	const G4double dTheta1 = dTheta0 + pSphere->GetDeltaThetaAngle();
+
+	G4double dPhi = dSPhi + G4UniformRand()*dDPhi;
+	G4double dTheta, dR;
+
+	switch(iPiece)
+	{
+		case 0:
+		case 1:
+			dTheta = std::acos(std::cos(dTheta1) + G4UniformRand()*(std::cos(dTheta0)-std::cos(dTheta1)));
+			dR = (iPiece == 0)?(dRMax):(dRMin);
+			break;
+
+		case 2:
+		case 3:
+			dTheta = (iPiece == 2)?(dTheta0):(dTheta1);
+			dR = GenerateRadius(dRMin, dRMax);
+			break;
+
+		default:
+			dTheta = dTheta0 + G4UniformRand()*(dTheta1-dTheta0);
+			dR = GenerateRadius(dRMin, dRMax);
+			dPhi = (iPiece == 4)?(dSPhi):(dSPhi+dDPhi);
+			break;
+	}
+
+	G4ThreeVector hRadial(std::sin(dTheta)*std::cos(dPhi), std::sin(dTheta)*std::sin(dPhi), std::cos(dTheta));
+	G4ThreeVector hThetaAxis(std::cos(dTheta)*std::cos(dPhi), std::cos(dTheta)*std::sin(dPhi), -std::sin(dTheta));
+	G4ThreeVector hPhiAxis(-std::sin(dPhi), std::cos(dPhi), 0.);
+
+	hPosition = dR*hRadial;
+
+	switch(iPiece)
+	{
+		case 0: hNormal = hRadial; break;
+		case 1: hNormal = -hRadial; break;
+		case 2: hNormal = -hThetaAxis; break;
+		case 3: hNormal = hThetaAxis; break;
+		case 4: hNormal = -hPhiAxis; break;
+		default: hNormal = hPhiAxis; break;
+	}
+}
+
+void
+DARWINSurfaceSampler::GeneratePointOnEllipsoid(const G4Ellipsoid *pEllipsoid, G4int iPiece, G4ThreeVector &hPosition, G4ThreeVector &hNormal)
+{
+	const G4double dA = pEllipsoid->GetSemiAxisMax(0);
+	const G4double dB = pEllipsoid->GetSemiAxisMax(1);
+	const G4double dC = pEllipsoid->GetSemiAxisMax(2);
+	const G4double dZBottom = std::max(pEllipsoid->GetZBottomCut(), -dC);
+	const G4double dZTop = std::min(pEllipsoid->GetZTopCut(), dC);
+
+	G4double dPhi = twopi*G4UniformRand();
+
+	if(iPiece == 0)
+	{
+		// uniform on the unit sphere, accepted with the ratio of the area elements
+		const G4double dMax = 1./std::min(dA, std::min(dB, dC));
+		G4double dU, dSin, dWeight;
+
+		do
+		{
+			dU = dZBottom/dC + G4UniformRand()*(dZTop-dZBottom)/dC;
+			dSin = std::sqrt(std::max(0., 1.-dU*dU));
+			dPhi = twopi*G4UniformRand();
+
+			G4double dNX = dSin*std::cos(dPhi), dNY = dSin*std::sin(dPhi);
+			dWeight = std::sqrt(dNX*dNX/(dA*dA) + dNY*dNY/(dB*dB) + dU*dU/(dC*dC));
+		}
+		while(G4UniformRand()*dMax > dWeight);
+
+		hPosition = G4ThreeVector(dA*dSin*std::cos(dPhi), dB*dSin*std::sin(dPhi), dC*dU);
+		hNormal = G4ThreeVector(hPosition.x()/(dA*dA), hPosition.y()/(dB*dB), hPosition.z()/(dC*dC)).unit();
+	}
+	else
+	{
+		G4double dZ = (iPiece == 1)?(dZBottom):(dZTop);
+		G4double dScale = std::sqrt(std::max(0., 1.-dZ*dZ/(dC*dC)))*std::sqrt(G4UniformRand());
+
+		hPosition = G4ThreeVector(dA*dScale*std::cos(dPhi), dB*dScale*std::sin(dPhi), dZ);
+		hNormal = G4ThreeVector(0., 0., (iPiece == 1)?(-1.):(1.));
+	}
+}
+
+G4int
+DARWINSurfaceSampler::SelectPiece(const vector<G4double> &hAreas)
+{
+	G4double dTotal = 0.;
+	for(G4int i=0; i<(G4int) hAreas.size(); i++)
+		dTotal += hAreas[i];
+
+	G4double dArea = G4UniformRand()*dTotal;
+
+	for(G4int i=0; i<(G4int) hAreas.size(); i++)
+	{
+		if(dArea < hAreas[i])
+			return i;
+		dArea -= hAreas[i];
+	}
+
+	return 0;
+}
+
+// radius with a density proportional to r, flat annulus
+G4double
+DARWINSurfaceSampler::GenerateRadius(G4double dRMin, G4double dRMax)
+{
+	return std::sqrt(dRMin*dRMin + G4UniformRand()*(dRMax*dRMax-dRMin*dRMin));
+}
+
@@ -0,0 +1,59 @@
+#include "DARWINVolumeSet.hh"
+
+DARWINVolumeSet::DARWINVolumeSet()
+{
+	m_lMask = 0;
+	m_iSize = 0;
+}
+
+DARWINVolumeSet::~DARWINVolumeSet()
+{
+}
+
+void
+DARWINVolumeSet::Clear()
+{
+	m_hSlots.clear();
+	m_lMask = 0;
+	m_iSize = 0;
+}
+
+void
+DARWINVolumeSet::Insert(const G4VPhysicalVolume *pVolume)
+{
+	if(!pVolume || Contains(pVolume))
+		return;
+
+	// keep the load factor below 1/2, probe sequences stay short
+	if(2*(m_iSize+1) > (G4int) m_hSlots.size())
+		Resize((m_hSlots.empty())?(16):(2*m_hSlots.size()));
+
+	size_t lSlot = Hash(pVolume) & m_lMask;
+	while(m_hSlots[lSlot])
+		lSlot = (lSlot+1) & m_lMask;
+
+	m_hSlots[lSlot] = pVolume;
+	m_iSize++;
+}
+
+void
+DARWINVolumeSet::Resize(size_t lNbSlots)
+{
+	vector<const G4VPhysicalVolume *> hOldSlots(lNbSlots, (const G4VPhysicalVolume *) 0);
+	hOldSlots.swap(m_hSlots);
+
+	m_lMask = lNbSlots-1;
+
+	for(size_t i=0; i<hOldSlots.size(); i++)
+	{
+		if(!hOldSlots[i])
+			continue;
+
+		size_t lSlot = Hash(hOldSlots[i]) & m_lMask;
+		while(m_hSlots[lSlot])
+			lSlot = (lSlot+1) & m_lMask;
+
+		m_hSlots[lSlot] = hOldSlots[i];
+	}
+}
+
@@ -0,0 +1,106 @@
+#ifndef __DARWINPMTHITSREADER_H__
+#define __DARWINPMTHITSREADER_H__
+
+// rebuilds the dense pmthits vector of the t1 tree, whether the file was
+// written with the full pmthits branch or with /Xe/analysis/setSparsePmtHits
+//
+//	TFile hFile("events.root");
+//	TTree *pTree = (TTree *) hFile.Get("t1");
+//	DARWINPmtHitsReader hReader(&hFile, pTree);
+//	for(Long64_t i = 0; i < pTree->GetEntries(); i++)
+//	{
+//		pTree->GetEntry(i);
+//		const vector<int> &hPmtHits = hReader.GetPmtHits();
+//	}
+
+#include <vector>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TParameter.h>
+
+using std::vector;
+
+class DARWINPmtHitsReader
+{
+public:
+	DARWINPmtHitsReader(TFile *pFile, TTree *pTree)
+	{
+		m_pPmtHits = 0;
+		m_pPmtHitId = 0;
+		m_pPmtHitCount = 0;
+		m_pPmtHitTime = 0;
+
+		m_bSparse = (pTree->GetBranch("pmthitid") != 0);
+
+		if(m_bSparse)
+		{
+			m_hPmtHits.assign(GetParameter(pFile, "nbtoppmts")+GetParameter(pFile, "nbbottompmts")
+				+GetParameter(pFile, "nblspmts")+GetParameter(pFile, "nbwaterpmts"), 0);
+
+			pTree->SetBranchAddress("pmthitid", &m_pPmtHitId);
+			pTree->SetBranchAddress("pmthitcount", &m_pPmtHitCount);
+			if(pTree->GetBranch("pmthittime"))
+				pTree->SetBranchAddress("pmthittime", &m_pPmtHitTime);
+		}
+		else
+			pTree->SetBranchAddress("pmthits", &m_pPmtHits);
+	}
+
+	~DARWINPmtHitsReader()
+	{
+		delete m_pPmtHits;
+		delete m_pPmtHitId;
+		delete m_pPmtHitCount;
+		delete m_pPmtHitTime;
+	}
+
+public:
+	bool IsSparse() const { return m_bSparse; }
+
+	// number of photon hits per pmt of the current entry
+	const vector<int> &GetPmtHits()
+	{
+		if(!m_bSparse)
+			return *m_pPmtHits;
+
+		m_hPmtHits.assign(m_hPmtHits.size(), 0);
+		for(size_t i = 0; i < m_pPmtHitId->size(); i++)
+			m_hPmtHits[(*m_pPmtHitId)[i]] = (*m_pPmtHitCount)[i];
+
+		return m_hPmtHits;
+	}
+
+	// time of the first photon hit per pmt of the current entry (ns), -1 without hits
+	const vector<float> &GetPmtHitTimes()
+	{
+		m_hPmtHitTimes.assign(m_hPmtHits.size(), -1.);
+		if(m_bSparse && m_pPmtHitTime)
+			for(size_t i = 0; i < m_pPmtHitId->size(); i++)
+				m_hPmtHitTimes[(*m_pPmtHitId)[i]] = (*m_pPmtHitTime)[i];
+
+		return m_hPmtHitTimes;
+	}
+
+private:
+	static int GetParameter(TFile *pFile, const char *szName)
+	{
+		TParameter<int> *pParameter = (TParameter<int> *) pFile->Get(szName);
+
+		return (pParameter)?(pParameter->GetVal()):(0);
+	}
+
+private:
+	bool m_bSparse;
+
+	vector<int> *m_pPmtHits;
+	vector<int> *m_pPmtHitId;
+	vector<int> *m_pPmtHitCount;
+	vector<float> *m_pPmtHitTime;
+
+	vector<int> m_hPmtHits;
+	vector<float> m_hPmtHitTimes;
+};
+
+#endif // __DARWINPMTHITSREADER_H__
+
@@ -0,0 +1,305 @@
+// converts between the t1 tree of a DARWIN output file and the columnar format
+//
+//	darwin_convert events.root events.dcol
+//	darwin_convert events.dcol events.root
+//
+// scalar branches of int, float and double and vector branches of int, float,
+// string (and unsigned short, stored as int) are converted, other branches and
+// the run-level objects of the ROOT file are skipped
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+
+#include "DARWINColumnarFormat.hh"
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+struct ConvertedColumn
+{
+	string hName;
+	DARWINColumnType iType;
+	bool bVector;
+	bool bUnsignedShort;
+	int iColumn;
+
+	int iInt;
+	float fFloat;
+	double dDouble;
+	vector<int> *pInts;
+	vector<float> *pFloats;
+	vector<string> *pStrings;
+	vector<unsigned short> *pUnsignedShorts;
+};
+
+static bool
+EndsWith(const string &hString, const string &hSuffix)
+{
+	return hString.size() >= hSuffix.size() && hString.compare(hString.size()-hSuffix.size(), hSuffix.size(), hSuffix) == 0;
+}
+
+static int
+ConvertRootToColumnar(const string &hInput, const string &hOutput)
+{
+	TFile *pFile = TFile::Open(hInput.c_str());
+	TTree *pTree = (pFile)?((TTree *) pFile->Get("t1")):(0);
+
+	if(!pTree)
+	{
+		cerr << "Error: no t1 tree in " << hInput << "!" << endl;
+		return 1;
+	}
+
+	DARWINColumnarWriter hWriter;
+	if(!hWriter.Open(hOutput))
+		return 1;
+
+	vector<ConvertedColumn> hColumns;
+	TObjArray *pBranches = pTree->GetListOfBranches();
+
+	for(int i = 0; i < pBranches->GetEntriesFast(); i++)
+	{
+		TBranch *pBranch = (TBranch *) pBranches->At(i);
+		string hClassName = pBranch->GetClassName();
+
+		ConvertedColumn hColumn;
+		hColumn.hName = pBranch->GetName();
+		hColumn.bUnsignedShort = false;
+		hColumn.pInts = 0;
+		hColumn.pFloats = 0;
+		hColumn.pStrings = 0;
+		hColumn.pUnsignedShorts = 0;
+
+		if(hClassName.empty())
+		{
+			string hTypeName = ((TLeaf *) pBranch->GetListOfLeaves()->At(0))->GetTypeName();
+
+			hColumn.bVector = false;
+			if(hTypeName == "Int_t")
+				hColumn.iType = kColumnInt;
+			else if(hTypeName == "Float_t")
+				hColumn.iType = kColumnFloat;
+			else if(hTypeName == "Double_t")
+				hColumn.iType = kColumnDouble;
+			else
+			{
+				cout << "skipping branch " << hColumn.hName << " (" << hTypeName << ")" << endl;
+				continue;
+			}
+		}
+		else
+		{
+			hColumn.bVector = true;
+			if(hClassName == "vector<int>")
+				hColumn.iType = kColumnInt;
+			else if(hClassName == "vector<float>")
+				hColumn.iType = kColumnFloat;
+			else if(hClassName == "vector<string>")
+				hColumn.iType = kColumnString;
+			else if(hClassName == "vector<unsigned short>")
+			{
+				hColumn.iType = kColumnInt;
+				hColumn.bUnsignedShort = true;
+			}
+			else
+			{
+				cout << "skipping branch " << hColumn.hName << " (" << hClassName << ")" << endl;
+				continue;
+			}
+		}
+
+		hColumn.iColumn = hWriter.AddColumn(hColumn.hName, hColumn.iType, hColumn.bVector);
+		hColumns.push_back(hColumn);
+	}
+
+	// addresses once the vector is final
+	for(vector<ConvertedColumn>::iterator pIt = hColumns.begin(); pIt != hColumns.end(); pIt++)
+	{
+		const char *szName = pIt->hName.c_str();
+
+		if(!pIt->bVector && pIt->iType == kColumnInt)
+			pTree->SetBranchAddress(szName, &pIt->iInt);
+		else if(!pIt->bVector && pIt->iType == kColumnFloat)
+			pTree->SetBranchAddress(szName, &pIt->fFloat);
+		else if(!pIt->bVector)
+			pTree->SetBranchAddress(szName, &pIt->dDouble);
+		else if(pIt->bUnsignedShort)
+			pTree->SetBranchAddress(szName, &pIt->pUnsignedShorts);
+		else if(pIt->iType == kColumnInt)
+			pTree->SetBranchAddress(szName, &pIt->pInts);
+		else if(pIt->iType == kColumnFloat)
+			pTree->SetBranchAddress(szName, &pIt->pFloats);
+		else
+			pTree->SetBranchAddress(szName, &pIt->pStrings);
+	}
+
+	vector<int> hConverted;
+	Long64_t lNbEntries = pTree->GetEntries();
+
+	for(Long64_t lEntry = 0; lEntry < lNbEntries; lEntry++)
+	{
+		pTree->GetEntry(lEntry);
+
+		for(vector<ConvertedColumn>::iterator pIt = hColumns.begin(); pIt != hColumns.end(); pIt++)
+		{
+			if(!pIt->bVector && pIt->iType == kColumnInt)
+				hWriter.SetInt(pIt->iColumn, pIt->iInt);
+			else if(!pIt->bVector && pIt->iType == kColumnFloat)
+				hWriter.SetFloat(pIt->iColumn, pIt->fFloat);
+			else if(!pIt->bVector)
+				hWriter.SetDouble(pIt->iColumn, pIt->dDouble);
+			else if(pIt->bUnsignedShort)
+			{
+				hConverted.assign(pIt->pUnsignedShorts->begin(), pIt->pUnsignedShorts->end());
+				hWriter.AppendInts(pIt->iColumn, hConverted);
+			}
+			else if(pIt->iType == kColumnInt)
+				hWriter.AppendInts(pIt->iColumn, *pIt->pInts);
+			else if(pIt->iType == kColumnFloat)
+				hWriter.AppendFloats(pIt->iColumn, *pIt->pFloats);
+			else
+				hWriter.AppendStrings(pIt->iColumn, *pIt->pStrings);
+		}
+
+		hWriter.EndEvent();
+	}
+
+	bool bOk = hWriter.Close();
+	pFile->Close();
+
+	cout << lNbEntries << " events, " << hColumns.size() << " columns written to " << hOutput << endl;
+
+	return (bOk)?(0):(1);
+}
+
+static int
+ConvertColumnarToRoot(const string &hInput, const string &hOutput)
+{
+	DARWINColumnarReader hReader;
+	if(!hReader.Open(hInput))
+		return 1;
+
+	TFile *pFile = new TFile(hOutput.c_str(), "RECREATE", "File containing event data for DARWIN");
+	TTree *pTree = new TTree("t1", "Tree containing event data for DARWIN");
+
+	int iNbColumns = hReader.GetNbColumns();
+	vector<ConvertedColumn> hColumns(iNbColumns);
+
+	for(int i = 0; i < iNbColumns; i++)
+	{
+		ConvertedColumn &hColumn = hColumns[i];
+
+		hColumn.hName = hReader.GetColumnName(i);
+		hColumn.iType = hReader.GetColumnType(i);
+		hColumn.bVector = hReader.IsVector(i);
+		hColumn.iColumn = i;
+		hColumn.pInts = new vector<int>;
+		hColumn.pFloats = new vector<float>;
+		hColumn.pStrings = new vector<string>;
+		hColumn.pUnsignedShorts = 0;
+
+		const char *szName = hColumn.hName.c_str();
+
+		if(!hColumn.bVector && hColumn.iType == kColumnInt)
+			pTree->Branch(szName, &hColumn.iInt, (hColumn.hName+"/I").c_str());
+		else if(!hColumn.bVector && hColumn.iType == kColumnFloat)
+			pTree->Branch(szName, &hColumn.fFloat, (hColumn.hName+"/F").c_str());
+		else if(!hColumn.bVector && hColumn.iType == kColumnDouble)
+			pTree->Branch(szName, &hColumn.dDouble, (hColumn.hName+"/D").c_str());
+		else if(hColumn.iType == kColumnInt)
+			pTree->Branch(szName, "vector<int>", &hColumn.pInts);
+		else if(hColumn.iType == kColumnFloat)
+			pTree->Branch(szName, "vector<float>", &hColumn.pFloats);
+		else if(hColumn.iType == kColumnString)
+			pTree->Branch(szName, "vector<string>", &hColumn.pStrings);
+	}
+
+	for(int iChunk = 0; iChunk < hReader.GetNbChunks(); iChunk++)
+	{
+		for(uint64_t lEvent = 0; lEvent < hReader.GetNbChunkEvents(iChunk); lEvent++)
+		{
+			for(int i = 0; i < iNbColumns; i++)
+			{
+				ConvertedColumn &hColumn = hColumns[i];
+
+				uint64_t lNbElements;
+				const void *pData = hReader.GetData(i, iChunk, lNbElements);
+				const uint32_t *pOffsets = hReader.GetOffsets(i, iChunk);
+
+				if(!hColumn.bVector)
+				{
+					if(hColumn.iType == kColumnInt)
+						hColumn.iInt = static_cast<const int32_t *>(pData)[lEvent];
+					else if(hColumn.iType == kColumnFloat)
+						hColumn.fFloat = static_cast<const float *>(pData)[lEvent];
+					else if(hColumn.iType == kColumnDouble)
+						hColumn.dDouble = static_cast<const double *>(pData)[lEvent];
+					continue;
+				}
+
+				uint32_t iBegin = pOffsets[lEvent], iEnd = pOffsets[lEvent+1];
+
+				if(hColumn.iType == kColumnInt)
+					hColumn.pInts->assign(static_cast<const int32_t *>(pData)+iBegin, static_cast<const int32_t *>(pData)+iEnd);
+				else if(hColumn.iType == kColumnFloat)
+					hColumn.pFloats->assign(static_cast<const float *>(pData)+iBegin, static_cast<const float *>(pData)+iEnd);
+				else if(hColumn.iType == kColumnString)
+				{
+					const vector<string> &hDictionary = hReader.GetDictionary(i);
+
+					hColumn.pStrings->clear();
+					for(uint32_t j = iBegin; j < iEnd; j++)
+						hColumn.pStrings->push_back(hDictionary[static_cast<const int32_t *>(pData)[j]]);
+				}
+			}
+
+			pTree->Fill();
+		}
+	}
+
+	pFile->Write();
+	pFile->Close();
+
+	for(int i = 0; i < iNbColumns; i++)
+	{
+		delete hColumns[i].pInts;
+		delete hColumns[i].pFloats;
+		delete hColumns[i].pStrings;
+	}
+
+	cout << hReader.GetNbEvents() << " events, " << iNbColumns << " columns written to " << hOutput << endl;
+
+	return 0;
+}
+
+int
+main(int iArgc, char **pArgv)
+{
+	if(iArgc != 3)
+	{
+		cerr << "usage: " << pArgv[0] << " input.root output.dcol | input.dcol output.root" << endl;
+		return 1;
+	}
+
+	string hInput = pArgv[1], hOutput = pArgv[2];
+
+	if(EndsWith(hInput, ".root") && EndsWith(hOutput, ".dcol"))
+		return ConvertRootToColumnar(hInput, hOutput);
+	else if(EndsWith(hInput, ".dcol") && EndsWith(hOutput, ".root"))
+		return ConvertColumnarToRoot(hInput, hOutput);
+
+	cerr << "Error: convert .root to .dcol or .dcol to .root!" << endl;
+
+	return 1;
+}
+
@@ -0,0 +1,630 @@
+// overlays the events of several DARWIN outputs into one continuous data stream
+//
+//	darwin_overlay -o mixed.root -w 1000 -t 3600 -j 8 rn222.root:2e-3 gammas_*.root:15 neutrons.root:1e-4
+//
+// every source is source:rate, the rate of the simulated primaries of the source
+// in Hz, source a file or a pattern of chunks of the same run, see readme/overlay.txt
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+
+#include <TROOT.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <TChain.h>
+#include <TObjArray.h>
+#include <TParameter.h>
+#include <TNamed.h>
+
+#include "DARWINPmtHitsReader.h"
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+struct OverlaySource
+{
+	string hPattern;
+	double dRate;			// simulated primaries [Hz]
+	double dEventRate;		// events stored in the files [Hz]
+	Long64_t lNbEntries;
+	bool bStrings;
+};
+
+struct OverlaySlice
+{
+	double dBegin, dEnd;		// [ns]
+	double dStart;			// first window starts at or after this, past the last window of the slice before
+	double dLastEnd;		// end of the last window of the slice
+	Long64_t lNbEvents;
+	Long64_t lFirstEventId;
+	vector<Long64_t> hFirstEntries;	// arrivals of each source overlaid in the slices before
+};
+
+// Poisson arrivals of all sources in [dBegin, dEnd), the same for every pass over
+// a slice since each source has its own engine seeded from the slice
+class ArrivalStream
+{
+public:
+	ArrivalStream(const vector<OverlaySource> &hSources, unsigned long lSeed, int iSlice, double dBegin, double dEnd)
+	{
+		m_dEnd = dEnd;
+
+		for(size_t i = 0; i < hSources.size(); i++)
+		{
+			std::seed_seq hSeed{(unsigned long) lSeed, (unsigned long) iSlice, (unsigned long) i};
+			m_hEngines.push_back(std::mt19937_64(hSeed));
+			m_hGaps.push_back(std::exponential_distribution<double>(hSources[i].dEventRate*1e-9));
+			m_hNext.push_back(dBegin+m_hGaps[i](m_hEngines[i]));
+		}
+	}
+
+	bool Next(double &dTime, int &iSource)
+	{
+		if(m_hNext.empty())
+			return false;
+
+		size_t iMin = std::min_element(m_hNext.begin(), m_hNext.end())-m_hNext.begin();
+		if(m_hNext[iMin] >= m_dEnd)
+			return false;
+
+		dTime = m_hNext[iMin];
+		iSource = iMin;
+		m_hNext[iMin] += m_hGaps[iMin](m_hEngines[iMin]);
+
+		return true;
+	}
+
+private:
+	double m_dEnd;
+	vector<std::mt19937_64> m_hEngines;
+	vector<std::exponential_distribution<double> > m_hGaps;
+	vector<double> m_hNext;
+};
+
+// arrivals of a slice, continued into the next slice for the last window
+class SliceArrivals
+{
+public:
+	SliceArrivals(const vector<OverlaySource> &hSources, unsigned long lSeed, const vector<OverlaySlice> &hSlices, int iSlice):
+		m_hCurrent(hSources, lSeed, iSlice, hSlices[iSlice].dBegin, hSlices[iSlice].dEnd),
+		m_hFollowing(hSources, lSeed, iSlice+1, hSlices[iSlice].dEnd,
+			(iSlice+1 < (int) hSlices.size())?(hSlices[iSlice+1].dEnd):(hSlices[iSlice].dEnd))
+	{
+		m_bCurrent = true;
+		m_bPending = false;
+	}
+
+	bool Peek(double &dTime, int &iSource)
+	{
+		if(!m_bPending)
+		{
+			m_bPending = m_bCurrent && m_hCurrent.Next(m_dTime, m_iSource);
+			if(!m_bPending)
+			{
+				m_bCurrent = false;
+				m_bPending = m_hFollowing.Next(m_dTime, m_iSource);
+			}
+		}
+
+		dTime = m_dTime;
+		iSource = m_iSource;
+
+		return m_bPending;
+	}
+
+	void Pop() { m_bPending = false; }
+
+private:
+	ArrivalStream m_hCurrent;
+	ArrivalStream m_hFollowing;
+	bool m_bCurrent;
+	bool m_bPending;
+	double m_dTime;
+	int m_iSource;
+};
+
+// one open source per worker, read sequentially from the entry of the slice
+struct SourceReader
+{
+	TChain *pChain;
+	DARWINPmtHitsReader *pPmtHitsReader;
+
+	int iEventId;
+	float fEtot;
+	int iNbSteps;
+	vector<float> *pXp, *pYp, *pZp, *pEd, *pTime;
+	vector<string> *pType, *pEdProc;
+
+	Long64_t lEntry;		// counts on past the last entry, read modulo the entries
+};
+
+// combined event
+struct OverlayEvent
+{
+	int iEventId;
+	double dEventTime;
+	float fEtot;
+	int iNbSteps;
+	int iNbSources;
+	vector<int> *pSource, *pSourceEventId;
+	vector<float> *pSourceTime;
+	vector<int> *pPmtHits;
+	vector<float> *pXp, *pYp, *pZp, *pEd, *pTime;
+	vector<int> *pStepSource;
+	vector<string> *pType, *pEdProc;
+};
+
+static vector<OverlaySource> g_hSources;
+static vector<OverlaySlice> g_hSlices;
+static unsigned long g_lSeed = 1;
+static double g_dWindow = 1000.;
+static string g_hStem;
+static bool g_bStrings = true;
+static int g_iNbPmts = 0;
+
+static std::atomic<int> g_iNextSlice(0);
+static std::atomic<Long64_t> g_lNbReused(0);
+static std::mutex g_hOutputMutex;
+
+static string
+GetChunkFilename(int iSlice)
+{
+	std::ostringstream hStream;
+	hStream << g_hStem << "_" << std::setw(4) << std::setfill('0') << iSlice << ".root";
+
+	return hStream.str();
+}
+
+static int
+GetParameter(TFile *pFile, const char *szName)
+{
+	TParameter<int> *pParameter = (TParameter<int> *) pFile->Get(szName);
+
+	return (pParameter)?(pParameter->GetVal()):(0);
+}
+
+// number of entries and of simulated events of all files of a source
+static bool
+InspectSource(OverlaySource &hSource)
+{
+	TChain hChain("t1");
+	if(!hChain.Add(hSource.hPattern.c_str()) || (hSource.lNbEntries = hChain.GetEntries()) <= 0)
+	{
+		cerr << "Error: no events in " << hSource.hPattern << "!" << endl;
+		return false;
+	}
+
+	Long64_t lNbSimulated = 0;
+	TObjArray *pFiles = hChain.GetListOfFiles();
+
+	for(int i = 0; i < pFiles->GetEntriesFast(); i++)
+	{
+		TFile *pFile = TFile::Open(pFiles->At(i)->GetTitle());
+		int iNbEvents = (pFile)?(GetParameter(pFile, "nbevents")):(0);
+		int iNbPmts = (pFile)?(GetParameter(pFile, "nbtoppmts")+GetParameter(pFile, "nbbottompmts")
+			+GetParameter(pFile, "nblspmts")+GetParameter(pFile, "nbwaterpmts")):(0);
+
+		if(iNbPmts && g_iNbPmts && iNbPmts != g_iNbPmts)
+		{
+			cerr << "Error: " << pFiles->At(i)->GetTitle() << " has " << iNbPmts << " pmts, not " << g_iNbPmts << "!" << endl;
+			delete pFile;
+			return false;
+		}
+		g_iNbPmts = std::max(g_iNbPmts, iNbPmts);
+
+		lNbSimulated += iNbEvents;
+		delete pFile;
+	}
+
+	// only events with deposits are stored, the rate of primaries is scaled down to them
+	if(lNbSimulated > 0)
+		hSource.dEventRate = hSource.dRate*hSource.lNbEntries/lNbSimulated;
+	else
+	{
+		cout << "no nbevents in " << hSource.hPattern << ", " << hSource.dRate << " Hz taken as the rate of stored events" << endl;
+		hSource.dEventRate = hSource.dRate;
+	}
+
+	hSource.bStrings = (hChain.GetBranch("type") != 0 && hChain.GetBranch("edproc") != 0);
+	g_bStrings = g_bStrings && hSource.bStrings;
+
+	return true;
+}
+
+// where the windows of each slice start, how many there are and the first entry of
+// each source, sequential since a window may reach into the next slice, only the
+// arrival times are generated here
+static void
+PlanSlices()
+{
+	double dPreviousEnd = 0.;
+	Long64_t lFirstEventId = 0;
+	vector<Long64_t> hNbArrivals(g_hSources.size(), 0);
+
+	for(int iSlice = 0; iSlice < (int) g_hSlices.size(); iSlice++)
+	{
+		OverlaySlice &hSlice = g_hSlices[iSlice];
+		SliceArrivals hArrivals(g_hSources, g_lSeed, g_hSlices, iSlice);
+
+		hSlice.dStart = std::max(hSlice.dBegin, dPreviousEnd);
+		hSlice.dLastEnd = hSlice.dStart;
+		hSlice.lNbEvents = 0;
+		hSlice.lFirstEventId = lFirstEventId;
+		hSlice.hFirstEntries = hNbArrivals;
+
+		double dTime;
+		int iSource;
+
+		while(hArrivals.Peek(dTime, iSource))
+		{
+			if(dTime < hSlice.dStart)
+			{
+				hArrivals.Pop();
+				continue;
+			}
+
+			if(dTime >= hSlice.dEnd)
+				break;
+
+			hSlice.dLastEnd = dTime+g_dWindow;
+			hSlice.lNbEvents++;
+
+			while(hArrivals.Peek(dTime, iSource) && dTime < hSlice.dLastEnd)
+			{
+				hNbArrivals[iSource]++;
+				hArrivals.Pop();
+			}
+		}
+
+		dPreviousEnd = hSlice.dLastEnd;
+		lFirstEventId += hSlice.lNbEvents;
+	}
+}
+
+static void
+OpenSource(const OverlaySource &hSource, SourceReader &hReader)
+{
+	hReader.pChain = new TChain("t1");
+	hReader.pChain->Add(hSource.hPattern.c_str());
+	hReader.pChain->LoadTree(0);
+
+	hReader.pXp = hReader.pYp = hReader.pZp = hReader.pEd = hReader.pTime = 0;
+	hReader.pType = hReader.pEdProc = 0;
+
+	hReader.pChain->SetBranchStatus("*", 0);
+	const char *szBranches[] = {"eventid", "etot", "nsteps", "pmthits", "pmthitid", "pmthitcount", "xp", "yp", "zp", "ed", "time", "type", "edproc"};
+	for(size_t i = 0; i < sizeof(szBranches)/sizeof(szBranches[0]); i++)
+		if(hReader.pChain->GetBranch(szBranches[i]))
+			hReader.pChain->SetBranchStatus(szBranches[i], 1);
+
+	hReader.pPmtHitsReader = new DARWINPmtHitsReader(hReader.pChain->GetFile(), hReader.pChain);
+	hReader.pChain->SetBranchAddress("eventid", &hReader.iEventId);
+	hReader.pChain->SetBranchAddress("etot", &hReader.fEtot);
+	hReader.pChain->SetBranchAddress("nsteps", &hReader.iNbSteps);
+	hReader.pChain->SetBranchAddress("xp", &hReader.pXp);
+	hReader.pChain->SetBranchAddress("yp", &hReader.pYp);
+	hReader.pChain->SetBranchAddress("zp", &hReader.pZp);
+	hReader.pChain->SetBranchAddress("ed", &hReader.pEd);
+	hReader.pChain->SetBranchAddress("time", &hReader.pTime);
+	if(g_bStrings)
+	{
+		hReader.pChain->SetBranchAddress("type", &hReader.pType);
+		hReader.pChain->SetBranchAddress("edproc", &hReader.pEdProc);
+	}
+}
+
+static void
+CloseSource(SourceReader &hReader)
+{
+	delete hReader.pPmtHitsReader;
+	delete hReader.pChain;
+	delete hReader.pXp;
+	delete hReader.pYp;
+	delete hReader.pZp;
+	delete hReader.pEd;
+	delete hReader.pTime;
+	delete hReader.pType;
+	delete hReader.pEdProc;
+}
+
+static void
+ClearEvent(OverlayEvent &hEvent)
+{
+	hEvent.fEtot = 0.;
+	hEvent.iNbSteps = 0;
+	hEvent.iNbSources = 0;
+	hEvent.pSource->clear();
+	hEvent.pSourceEventId->clear();
+	hEvent.pSourceTime->clear();
+	hEvent.pPmtHits->assign(g_iNbPmts, 0);
+	hEvent.pXp->clear();
+	hEvent.pYp->clear();
+	hEvent.pZp->clear();
+	hEvent.pEd->clear();
+	hEvent.pTime->clear();
+	hEvent.pStepSource->clear();
+	hEvent.pType->clear();
+	hEvent.pEdProc->clear();
+}
+
+// next event of a source added to the combined event, dOffset after its start
+static void
+AddSourceEvent(SourceReader &hReader, int iSource, double dOffset, OverlayEvent &hEvent)
+{
+	if(hReader.lEntry >= g_hSources[iSource].lNbEntries)
+		g_lNbReused++;
+	hReader.pChain->GetEntry(hReader.lEntry++ % g_hSources[iSource].lNbEntries);
+
+	int iContribution = hEvent.iNbSources++;
+	hEvent.pSource->push_back(iSource);
+	hEvent.pSourceEventId->push_back(hReader.iEventId);
+	hEvent.pSourceTime->push_back(dOffset);
+
+	hEvent.fEtot += hReader.fEtot;
+	hEvent.iNbSteps += hReader.iNbSteps;
+
+	const vector<int> &hPmtHits = hReader.pPmtHitsReader->GetPmtHits();
+	if(hPmtHits.size() > hEvent.pPmtHits->size())
+		hEvent.pPmtHits->resize(hPmtHits.size(), 0);
+	for(size_t i = 0; i < hPmtHits.size(); i++)
+		(*hEvent.pPmtHits)[i] += hPmtHits[i];
+
+	hEvent.pXp->insert(hEvent.pXp->end(), hReader.pXp->begin(), hReader.pXp->end());
+	hEvent.pYp->insert(hEvent.pYp->end(), hReader.pYp->begin(), hReader.pYp->end());
+	hEvent.pZp->insert(hEvent.pZp->end(), hReader.pZp->begin(), hReader.pZp->end());
+	hEvent.pEd->insert(hEvent.pEd->end(), hReader.pEd->begin(), hReader.pEd->end());
+	for(size_t i = 0; i < hReader.pTime->size(); i++)
+		hEvent.pTime->push_back((*hReader.pTime)[i]+dOffset);
+	hEvent.pStepSource->insert(hEvent.pStepSource->end(), hReader.pXp->size(), iContribution);
+
+	if(g_bStrings)
+	{
+		hEvent.pType->insert(hEvent.pType->end(), hReader.pType->begin(), hReader.pType->end());
+		hEvent.pEdProc->insert(hEvent.pEdProc->end(), hReader.pEdProc->begin(), hReader.pEdProc->end());
+	}
+}
+
+static void
+OverlaySliceEvents(int iSlice, vector<SourceReader> &hReaders)
+{
+	const OverlaySlice &hSlice = g_hSlices[iSlice];
+
+	// each slice continues after the entries of the slices before
+	for(size_t i = 0; i < hReaders.size(); i++)
+		hReaders[i].lEntry = hSlice.hFirstEntries[i];
+
+	string hFilename = GetChunkFilename(iSlice);
+	TFile *pFile = new TFile(hFilename.c_str(), "RECREATE", "File containing overlaid event data for DARWIN");
+	TTree *pTree = new TTree("t1", "Tree containing overlaid event data for DARWIN");
+
+	OverlayEvent hEvent;
+	hEvent.pSource = new vector<int>;
+	hEvent.pSourceEventId = new vector<int>;
+	hEvent.pSourceTime = new vector<float>;
+	hEvent.pPmtHits = new vector<int>;
+	hEvent.pXp = new vector<float>;
+	hEvent.pYp = new vector<float>;
+	hEvent.pZp = new vector<float>;
+	hEvent.pEd = new vector<float>;
+	hEvent.pTime = new vector<float>;
+	hEvent.pStepSource = new vector<int>;
+	hEvent.pType = new vector<string>;
+	hEvent.pEdProc = new vector<string>;
+
+	pTree->Branch("eventid", &hEvent.iEventId, "eventid/I");
+	pTree->Branch("evttime", &hEvent.dEventTime, "evttime/D");
+	pTree->Branch("etot", &hEvent.fEtot, "etot/F");
+	pTree->Branch("nsteps", &hEvent.iNbSteps, "nsteps/I");
+	pTree->Branch("nsrc", &hEvent.iNbSources, "nsrc/I");
+	pTree->Branch("src", "vector<int>", &hEvent.pSource);
+	pTree->Branch("src_eventid", "vector<int>", &hEvent.pSourceEventId);
+	pTree->Branch("src_time", "vector<float>", &hEvent.pSourceTime);
+	pTree->Branch("pmthits", "vector<int>", &hEvent.pPmtHits);
+	pTree->Branch("stepsrc", "vector<int>", &hEvent.pStepSource);
+	if(g_bStrings)
+	{
+		pTree->Branch("type", "vector<string>", &hEvent.pType);
+		pTree->Branch("edproc", "vector<string>", &hEvent.pEdProc);
+	}
+	pTree->Branch("xp", "vector<float>", &hEvent.pXp);
+	pTree->Branch("yp", "vector<float>", &hEvent.pYp);
+	pTree->Branch("zp", "vector<float>", &hEvent.pZp);
+	pTree->Branch("ed", "vector<float>", &hEvent.pEd);
+	pTree->Branch("time", "vector<float>", &hEvent.pTime);
+
+	SliceArrivals hArrivals(g_hSources, g_lSeed, g_hSlices, iSlice);
+	hEvent.iEventId = (int) hSlice.lFirstEventId;
+
+	double dTime;
+	int iSource;
+
+	while(hArrivals.Peek(dTime, iSource))
+	{
+		if(dTime < hSlice.dStart)
+		{
+			hArrivals.Pop();
+			continue;
+		}
+
+		if(dTime >= hSlice.dEnd)
+			break;
+
+		ClearEvent(hEvent);
+		hEvent.dEventTime = dTime;
+
+		while(hArrivals.Peek(dTime, iSource) && dTime < hEvent.dEventTime+g_dWindow)
+		{
+			AddSourceEvent(hReaders[iSource], iSource, dTime-hEvent.dEventTime, hEvent);
+			hArrivals.Pop();
+		}
+
+		pTree->Fill();
+		hEvent.iEventId++;
+	}
+
+	pFile->cd();
+	TParameter<int>("nbevents", (int) hSlice.lNbEvents).Write();
+	TParameter<double>("livetime", (hSlice.dEnd-hSlice.dBegin)*1e-9).Write();
+	TParameter<double>("window", g_dWindow).Write();
+
+	std::ostringstream hSources;
+	for(size_t i = 0; i < g_hSources.size(); i++)
+		hSources << i << "\t" << g_hSources[i].hPattern << "\t" << g_hSources[i].dRate << "\t" << g_hSources[i].dEventRate << "\n";
+	TNamed("overlay_sources", hSources.str().c_str()).Write();
+
+	pFile->Write();
+	pFile->Close();
+	delete pFile;
+
+	delete hEvent.pSource;
+	delete hEvent.pSourceEventId;
+	delete hEvent.pSourceTime;
+	delete hEvent.pPmtHits;
+	delete hEvent.pXp;
+	delete hEvent.pYp;
+	delete hEvent.pZp;
+	delete hEvent.pEd;
+	delete hEvent.pTime;
+	delete hEvent.pStepSource;
+	delete hEvent.pType;
+	delete hEvent.pEdProc;
+
+	std::lock_guard<std::mutex> hLock(g_hOutputMutex);
+	cout << hFilename << ": " << hSlice.lNbEvents << " events" << endl;
+}
+
+static void
+Worker()
+{
+	vector<SourceReader> hReaders(g_hSources.size());
+	for(size_t i = 0; i < g_hSources.size(); i++)
+		OpenSource(g_hSources[i], hReaders[i]);
+
+	int iSlice;
+	while((iSlice = g_iNextSlice++) < (int) g_hSlices.size())
+		OverlaySliceEvents(iSlice, hReaders);
+
+	for(size_t i = 0; i < hReaders.size(); i++)
+		CloseSource(hReaders[i]);
+}
+
+static void
+Usage(const char *szName)
+{
+	cerr << "usage: " << szName << " -o output.root -t livetime_s [-w window_ns] [-j threads] [-n slices] [-s seed] source.root:rate_Hz ..." << endl;
+}
+
+int
+main(int iArgc, char **pArgv)
+{
+	string hOutput;
+	double dLivetime = 0.;
+	int iNbThreads = 1, iNbSlices = 0;
+	int iOption;
+
+	ROOT::EnableThreadSafety();
+
+	while((iOption = getopt(iArgc, pArgv, "o:t:w:j:n:s:")) != -1)
+	{
+		switch(iOption)
+		{
+			case 'o': hOutput = optarg; break;
+			case 't': dLivetime = atof(optarg); break;
+			case 'w': g_dWindow = atof(optarg); break;
+			case 'j': iNbThreads = atoi(optarg); break;
+			case 'n': iNbSlices = atoi(optarg); break;
+			case 's': g_lSeed = strtoul(optarg, 0, 10); break;
+			default: Usage(pArgv[0]); return 1;
+		}
+	}
+
+	if(hOutput.empty() || dLivetime <= 0. || g_dWindow <= 0. || iNbThreads < 1 || optind == iArgc)
+	{
+		Usage(pArgv[0]);
+		return 1;
+	}
+
+	g_hStem = (hOutput.size() > 5 && hOutput.compare(hOutput.size()-5, 5, ".root") == 0)?(hOutput.substr(0, hOutput.size()-5)):(hOutput);
+
+	for(int i = optind; i < iArgc; i++)
+	{
+		string hArgument = pArgv[i];
+		size_t iColon = hArgument.rfind(':');
+
+		OverlaySource hSource;
+		hSource.hPattern = hArgument.substr(0, iColon);
+		hSource.dRate = (iColon != string::npos)?(atof(hArgument.substr(iColon+1).c_str())):(0.);
+
+		if(iColon == string::npos || hSource.dRate <= 0.)
+		{
+			cerr << "Error: no rate for source " << hArgument << "!" << endl;
+			return 1;
+		}
+
+		if(!InspectSource(hSource))
+			return 1;
+
+		g_hSources.push_back(hSource);
+	}
+
+	// slices of the livetime, a window may only reach into the next slice
+	if(iNbSlices <= 0)
+		iNbSlices = 4*iNbThreads;
+	double dSliceLength = dLivetime*1e9/iNbSlices;
+
+	if(dSliceLength < g_dWindow)
+	{
+		cerr << "Error: slices shorter than the window, use fewer slices!" << endl;
+		return 1;
+	}
+
+	for(int i = 0; i < iNbSlices; i++)
+	{
+		OverlaySlice hSlice;
+		hSlice.dBegin = i*dSliceLength;
+		hSlice.dEnd = (i+1 < iNbSlices)?((i+1)*dSliceLength):(dLivetime*1e9);
+		g_hSlices.push_back(hSlice);
+	}
+
+	PlanSlices();
+
+	vector<std::thread> hThreads;
+	for(int i = 0; i < std::min(iNbThreads, iNbSlices); i++)
+		hThreads.push_back(std::thread(Worker));
+	for(size_t i = 0; i < hThreads.size(); i++)
+		hThreads[i].join();
+
+	// one line per chunk, as for the rotated simulation output
+	std::ofstream hIndexFile((g_hStem+"_index.txt").c_str());
+	hIndexFile << "# chunk\tfile\tfirst_eventid\tlast_eventid\tlivetime_s\tevents_written" << endl;
+
+	Long64_t lNbEvents = 0;
+	for(int i = 0; i < iNbSlices; i++)
+	{
+		const OverlaySlice &hSlice = g_hSlices[i];
+
+		hIndexFile << i << "\t" << GetChunkFilename(i) << "\t" << hSlice.lFirstEventId << "\t" << hSlice.lFirstEventId+hSlice.lNbEvents-1
+			<< "\t" << (hSlice.dEnd-hSlice.dBegin)*1e-9 << "\t" << hSlice.lNbEvents << endl;
+		lNbEvents += hSlice.lNbEvents;
+	}
+
+	cout << lNbEvents << " events in " << dLivetime << " s written to " << g_hStem << "_NNNN.root" << endl;
+	if(g_lNbReused)
+		cout << "sources wrapped around, " << g_lNbReused << " events were reused" << endl;
+
+	return 0;
+}